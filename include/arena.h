@@ -0,0 +1,107 @@
+#ifndef _CUTILS_ARENA_H_
+#define _CUTILS_ARENA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "cutils.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define CU_ARENA_DEFAULT_BLOCK_SIZE 1024
+
+/**
+ * @brief Arena (bump) allocator
+ */
+typedef struct cu_arena* cu_arena_t;
+
+/**
+ * @brief Arena configuration
+ */
+typedef struct {
+    size_t block_size;                /*<! Minimal size of one block (CU_ARENA_DEFAULT_BLOCK_SIZE if zero) */
+    const cu_allocator_t* allocator;  /*<! Allocator for the arena and the blocks (NULL for the standard library) */
+} cu_arena_config_t;
+
+/**
+ * @brief Create new arena. No block is allocated until the first allocation
+ * @param config Arena configuration (optional)
+ * @param arena Arena reference
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t cu_arena_create(cu_arena_config_t* config, cu_arena_t* arena);
+
+/**
+ * @brief Allocate memory from the arena. Memory is aligned for any fundamental type
+ *        and it's valid until the arena is reset or destroyed
+ * @param arena Arena
+ * @param size Number of bytes
+ * @return Pointer to allocated memory or NULL on failure
+ */
+void* cu_arena_alloc(cu_arena_t arena, size_t size);
+
+/**
+ * @brief Resize memory allocated from the arena. Last allocation is resized in place if possible
+ * @param arena Arena
+ * @param ptr Memory previously allocated from the same arena (or NULL)
+ * @param size New size in bytes
+ * @return Pointer to resized memory or NULL on failure
+ */
+void* cu_arena_realloc(cu_arena_t arena, void* ptr, size_t size);
+
+/**
+ * @brief Release memory allocated from the arena. Only the last allocation is actually
+ *        given back, everything else is released on reset
+ * @param arena Arena
+ * @param ptr Memory previously allocated from the same arena (or NULL)
+ * @return void
+ */
+void cu_arena_free(cu_arena_t arena, void* ptr);
+
+/**
+ * @brief Release all allocations at once. Blocks are kept for the next allocations
+ * @param arena Arena
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t cu_arena_reset(cu_arena_t arena);
+
+/**
+ * @brief Number of bytes currently allocated from the arena (including alignment padding)
+ * @param arena Arena
+ * @return Number of used bytes (0 if arena is NULL)
+ */
+size_t cu_arena_used(cu_arena_t arena);
+
+/**
+ * @brief Number of bytes reserved by the arena blocks
+ * @param arena Arena
+ * @return Number of reserved bytes (0 if arena is NULL)
+ */
+size_t cu_arena_capacity(cu_arena_t arena);
+
+/**
+ * @brief Make allocator which allocates from the arena
+ * @param arena Arena
+ * @param allocator Allocator reference
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t cu_arena_allocator(cu_arena_t arena, cu_allocator_t* allocator);
+
+/**
+ * @brief Free the memory occupied by the arena and all of its blocks
+ * @param arena Arena
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t cu_arena_destroy(cu_arena_t arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
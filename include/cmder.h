@@ -7,6 +7,8 @@ extern "C" {
 
 #include "cutils.h"
 #include "xlist.h"
+#include "arena.h"
+#include "estr.h"
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -38,6 +40,11 @@ typedef struct {
     bool name_as_cmdline_prefix;
     void* context;
     size_t cmdline_max_len;
+    const cu_allocator_t* allocator;  /*<! Allocator for every cmder allocation (NULL for the standard library) */
+    estr_intern_t intern;             /*<! Keep names and descriptions in the interning table instead of copying them
+                                           (optional, table is not owned and must outlive the cmder) */
+    bool case_insensitive;            /*<! Match command names and the cmdline prefix ignoring ASCII case
+                                           (commands whose names differ only in case can't be added both) */
 } cmder_t;
 
 typedef struct {
@@ -80,21 +87,79 @@ typedef struct {
 } cmder_cmd_t;
 
 cu_err_t cmder_create(cmder_t* config, cmder_handle_t* out_handle);
+
+/**
+ * @brief Create getopt options string of the command. Result is allocated with the cmder allocator
+ *        and should be released with cmder_free
+ * @param cmd Command
+ * @param out_getoops Options string
+ * @return CU_OK on success
+ */
 cu_err_t cmder_getoopts(cmder_cmd_handle_t cmd, char** out_getoops);
 cu_err_t cmder_args(const char* cmdline, int* out_argc, char*** out_argv);
 cu_err_t cmder_add_cmd(cmder_handle_t cmder, cmder_cmd_t* cmd, cmder_cmd_handle_t* out_cmd);
 cu_err_t cmder_add_vcmd(cmder_handle_t cmder, cmder_cmd_t* cmd);
 cu_err_t cmder_add_opt(cmder_cmd_handle_t cmd, cmder_opt_t* opt, cmder_opt_handle_t* out_opt);
 cu_err_t cmder_add_vopt(cmder_cmd_handle_t cmd, cmder_opt_t* opt);
+
+/**
+ * @brief Create signature of the command (ex: touch [OPTION] ... -f fval). Result is allocated with the cmder allocator
+ *        and should be released with cmder_free
+ * @param cmd Command
+ * @param out_signature Signature
+ * @param out_len Length of the signature (optional)
+ * @return CU_OK on success
+ */
 cu_err_t cmder_cmd_signature(cmder_cmd_handle_t cmd, char** out_signature, unsigned int* out_len);
+
+/**
+ * @brief Create manual of the command (signature and options). Result is allocated with the cmder allocator
+ *        and should be released with cmder_free
+ * @param cmd Command
+ * @param out_manual Manual
+ * @param out_len Length of the manual (optional)
+ * @return CU_OK on success
+ */
 cu_err_t cmder_cmd_manual(cmder_cmd_handle_t cmd, char** out_manual, unsigned int* out_len);
+
 cu_err_t cmder_run_args(cmder_handle_t cmder, int argc, char** argv, const void* run_context);
 cu_err_t cmder_vrun_args(cmder_handle_t cmder, int argc, char** argv);
 cu_err_t cmder_run(cmder_handle_t cmder, const char* cmdline, const void* run_context);
 cu_err_t cmder_vrun(cmder_handle_t cmder, const char* cmdline);
+
+/**
+ * @brief Run the command with all per-invocation memory (argv, cmdval, optvals, extra args)
+ *        allocated from the arena. Arena is reset after the callback returns,
+ *        so cmdval and its values must not be referenced afterwards
+ * @param cmder Commander
+ * @param arena Arena
+ * @param cmdline Command line
+ * @param run_context Run context passed to the callback
+ * @return CU_OK on success
+ */
+cu_err_t cmder_run_arena(cmder_handle_t cmder, cu_arena_t arena, const char* cmdline, const void* run_context);
+cu_err_t cmder_vrun_arena(cmder_handle_t cmder, cu_arena_t arena, const char* cmdline);
 cu_err_t cmder_get_cmd_by_name(cmder_handle_t cmder, const char* cmd_name, cmder_cmd_handle_t* out_cmd_handle);
 cu_err_t cmder_get_optval(cmder_cmdval_t* cmdval, char optname, cmder_optval_t** out_optval);
+
+/**
+ * @brief Create error message of the failed command value. Result is allocated with the cmder allocator
+ *        and should be released with cmder_free
+ * @param cmdval Command value
+ * @param out_errstr Error message
+ * @param out_len Length of the error message (optional)
+ * @return CU_OK on success
+ */
 cu_err_t cmder_cmdval_errstr(cmder_cmdval_t* cmdval, char** out_errstr, unsigned int* out_len);
+
+/**
+ * @brief Release memory returned by the cmder (getoopts, signature, manual, errstr) with the cmder allocator
+ * @param cmder Commander
+ * @param ptr Memory returned by the cmder (or NULL)
+ * @return CU_OK on success
+ */
+cu_err_t cmder_free(cmder_handle_t cmder, void* ptr);
+
 cu_err_t cmder_destroy(cmder_handle_t cmder);
 
 #ifdef __cplusplus
@@ -5,6 +5,9 @@
 extern "C" {
 #endif
 
+#include <stdlib.h>
+#include <string.h>
+
 typedef int cu_err_t;
 
 #define CU_OK                 (0)
@@ -17,6 +20,112 @@ typedef int cu_err_t;
 #define CU_ERR_INVALID_CHAR  (-7)
 #define CU_ERR_OUT_OF_BOUNDS (-8)
 
+/**
+ * @brief Memory allocator. If alloc is not provided (NULL), the standard library (malloc, realloc, free)
+ *        is used for everything and the other functions are ignored, so memory never moves between the two.
+ *        If realloc is not provided, memory is resized with alloc, copy and free.
+ *        If free is not provided, memory is never released one by one (ex: arena which is released at once)
+ */
+typedef struct {
+    void* (*alloc)(void* ctx, size_t size);               /*<! Allocate size bytes */
+    void* (*realloc)(void* ctx, void* ptr, size_t size);  /*<! Resize previously allocated memory */
+    void (*free)(void* ctx, void* ptr);                   /*<! Release previously allocated memory */
+    void* ctx;                                            /*<! User context passed to every function */
+} cu_allocator_t;
+
+/**
+ * @brief Allocate memory using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param size Number of bytes
+ * @return Pointer to allocated memory or NULL on failure
+ */
+static inline void* cu_alloc(const cu_allocator_t* allocator, size_t size) {
+    return allocator && allocator->alloc ? allocator->alloc(allocator->ctx, size) : malloc(size);
+}
+
+/**
+ * @brief Allocate zero-initialized memory for an array using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param n Number of elements
+ * @param size Size of one element
+ * @return Pointer to allocated memory or NULL on failure (or overflow)
+ */
+static inline void* cu_calloc(const cu_allocator_t* allocator, size_t n, size_t size) {
+    if(!allocator || !allocator->alloc) {
+        return calloc(n, size);
+    }
+
+    if(size > 0 && n > (size_t) -1 / size) {
+        return NULL;
+    }
+
+    void* ptr = allocator->alloc(allocator->ctx, n * size);
+    if(ptr) { memset(ptr, 0, n * size); }
+    return ptr;
+}
+
+/**
+ * @brief Release memory using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param ptr Memory previously allocated with the same allocator (or NULL)
+ * @return void
+ */
+static inline void cu_free(const cu_allocator_t* allocator, void* ptr) {
+    if(!ptr) { return; }
+    if(!allocator || !allocator->alloc) { free(ptr); }
+    else if(allocator->free) { allocator->free(allocator->ctx, ptr); }
+}
+
+/**
+ * @brief Resize memory using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param ptr Memory previously allocated with the same allocator (or NULL)
+ * @param old_size Current size of the memory in bytes (0 if ptr is NULL), needed if allocator has no realloc
+ * @param size New size in bytes
+ * @return Pointer to resized memory or NULL on failure (original memory is left untouched)
+ */
+static inline void* cu_realloc(const cu_allocator_t* allocator, void* ptr, size_t old_size, size_t size) {
+    if(!allocator || !allocator->alloc) {
+        return realloc(ptr, size);
+    }
+
+    if(allocator->realloc) {
+        return allocator->realloc(allocator->ctx, ptr, size);
+    }
+
+    void* _ptr = allocator->alloc(allocator->ctx, size);
+    if(_ptr && ptr) { memcpy(_ptr, ptr, old_size < size ? old_size : size); cu_free(allocator, ptr); }
+    return _ptr;
+}
+
+/**
+ * @brief Duplicate at most len characters of the string using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param str String
+ * @param len Maximum number of characters
+ * @return Pointer to null-terminated copy or NULL on failure
+ */
+static inline char* cu_strndup(const cu_allocator_t* allocator, const char* str, size_t len) {
+    size_t n = 0;
+    for(; n < len && str[n]; n++);
+    char* dup = (char*) cu_alloc(allocator, n + 1);
+    if(dup) { memcpy(dup, str, n); dup[n] = '\0'; }
+    return dup;
+}
+
+/**
+ * @brief Duplicate the string using allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param str String
+ * @return Pointer to null-terminated copy or NULL on failure
+ */
+static inline char* cu_strdup(const cu_allocator_t* allocator, const char* str) {
+    size_t len = strlen(str);
+    char* dup = (char*) cu_alloc(allocator, len + 1);
+    if(dup) { memcpy(dup, str, len + 1); }
+    return dup;
+}
+
 /**
  * @brief Universal handle constructor. User is responsible for freeing the resulting object
  * @param handle_type Handle type (ex: person_handle_t)
@@ -36,6 +145,29 @@ typedef int cu_err_t;
 #define cu_ctor(type, ...) \
     cu_tctor(type*, type, __VA_ARGS__)
 
+/**
+ * @brief Universal handle constructor which uses custom allocator.
+ *        User is responsible for freeing the resulting object with the same allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param handle_type Handle type (ex: person_handle_t)
+ * @param struct Struct (ex: struct person)
+ * @param ... Struct attributes (ex: .id = 2, .name = strdup("John"))
+ * @return Pointer to dynamically allocated struct
+ */
+#define cu_tctora(allocator, handle_type, struct, ...) \
+    __extension__ ({ handle_type obj = cu_calloc(allocator, 1, sizeof(struct)); if(obj) { *obj = (struct){ __VA_ARGS__ }; } obj; })
+
+/**
+ * @brief Universal struct (type) constructor which uses custom allocator.
+ *        User is responsible for freeing the resulting object with the same allocator
+ * @param allocator Allocator (NULL for the standard library)
+ * @param type Struct type name (ex: person_t)
+ * @param ... Struct attributes (ex: .id = 2, .name = strdup("John"))
+ * @return Pointer to dynamically allocated struct
+ */
+#define cu_ctora(allocator, type, ...) \
+    cu_tctora(allocator, type*, type, __VA_ARGS__)
+
 /**
  * @brief Free the list (array of pointers) with custom type for the length variable,
  *        and custom function for freeing the list item.
@@ -78,6 +210,28 @@ typedef int cu_err_t;
 #define cu_list_freex(list, len, free_fnc) \
     cu_list_tfreex(list, int, len, free_fnc)
 
+/**
+ * @brief Free the list (array of pointers) with custom type for the length variable.
+ *        List and list items are freed with the allocator
+ * @param list Double pointer to list
+ * @param len_type Type of the list length variable
+ * @param len Number of the items in the list
+ * @param allocator Allocator which was used for allocating the list and the items
+ * @return void
+ */
+#define cu_list_tfreea(list, len_type, len, allocator) \
+    __extension__ ({ if(list) { for(len_type i = 0; i < len; i++) { cu_free(allocator, list[i]); list[i] = NULL; } cu_free(allocator, list); list = NULL; len = 0; } })
+
+/**
+ * @brief Free the list (array of pointers). List and list items are freed with the allocator
+ * @param list Double pointer to list
+ * @param len Number of the items in the list
+ * @param allocator Allocator which was used for allocating the list and the items
+ * @return void
+ */
+#define cu_list_freea(list, len, allocator) \
+    cu_list_tfreea(list, int, len, allocator)
+
 #define cu_err_checkl(EXP, label) \
     if((err = (EXP)) != CU_OK) { goto label; }
 
@@ -9,6 +9,7 @@ extern "C" {
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #ifdef _WIN32
 char* strndup(const char* string, size_t len);
@@ -17,14 +18,384 @@ char* strndup(const char* string, size_t len);
 #define CU_ERR_ESTR_BASE                    (-1000)
 #define CU_ERR_ESTR_INVALID_WHITESPACE      (CU_ERR_ESTR_BASE - 1)
 #define CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS   (CU_ERR_ESTR_BASE - 2)
+#define CU_ERR_ESTR_INVALID_CHAR            (CU_ERR_ESTR_BASE - 3)
+#define CU_ERR_ESTR_INVALID_PREFIX          (CU_ERR_ESTR_BASE - 4)
+#define CU_ERR_ESTR_INVALID_SUFFIX          (CU_ERR_ESTR_BASE - 5)
+#define CU_ERR_ESTR_INVALID_UTF8            (CU_ERR_ESTR_BASE - 6)
+
+#define ESTR_INTERN_DEFAULT_CAPACITY 64
+
+#define ESTR_FMT_U64_SIZE 21  /*<! Buffer size enough for any estr_fmt_u64 output (with null character) */
+#define ESTR_FMT_I64_SIZE 21  /*<! Buffer size enough for any estr_fmt_i64 output (with null character) */
+#define ESTR_FMT_HEX_SIZE 17  /*<! Buffer size enough for any estr_fmt_hex output (with null character) */
+#define ESTR_FMT_F64_SIZE 32  /*<! Buffer size enough for any estr_fmt_f64 output (with null character) */
+
+#define ESTR_BATCH_WORDS(n) (((n) + 63) / 64)  /*<! Number of uint64_t words of batch result bitmap for n strings */
+
+/**
+ * @brief Instruction set used by the character scanning functions
+ */
+typedef enum {
+    ESTR_SIMD_AUTO,   /*<! Best one supported by the running CPU */
+    ESTR_SIMD_NONE,   /*<! Portable implementation (SWAR, 8 bytes at a time) */
+    ESTR_SIMD_SSE2,   /*<! x86 SSE2 */
+    ESTR_SIMD_SSSE3,  /*<! x86 SSSE3 (SSE2 with byte shuffle and align) */
+    ESTR_SIMD_AVX2,   /*<! x86 AVX2 */
+    ESTR_SIMD_NEON    /*<! ARM NEON */
+} estr_simd_t;
+
+/**
+ * @brief Base64 alphabet
+ */
+typedef enum {
+    ESTR_BASE64_STD,  /*<! Standard alphabet ('+' and '/') with padding (RFC 4648 section 4) */
+    ESTR_BASE64_URL   /*<! Url and filename safe alphabet ('-' and '_') without padding (RFC 4648 section 5) */
+} estr_base64_t;
+
+/**
+ * @brief Strictness of hex and base64 decoding
+ */
+typedef enum {
+    ESTR_DECODE_STRICT,  /*<! Only canonical encoding (no whitespace, exact padding, unused bits are zero) */
+    ESTR_DECODE_LENIENT  /*<! Whitespace is skipped, base64 padding is optional and both base64 alphabets are accepted */
+} estr_decode_t;
+
+/**
+ * @brief Length-carrying view into string. View does not own the characters
+ *        and they don't need to be null-terminated
+ */
+typedef struct {
+    const char* ptr;  /*<! First character (NULL for null view) */
+    size_t len;       /*<! Number of characters */
+} estr_view_t;
+
+/**
+ * @brief Position of one piece inside of the original string
+ */
+typedef struct {
+    size_t offset;  /*<! Index of first character of the piece */
+    size_t len;     /*<! Number of characters in the piece */
+} estr_span_t;
+
+/**
+ * @brief Cursor for splitting string piece by piece (see estr_split_iter and estr_split_next)
+ */
+typedef struct {
+    const char* str;  /*<! String which is splitted */
+    size_t len;       /*<! Length of the string (SIZE_MAX if str is null-terminated and length is not known) */
+    size_t pos;       /*<! Index from which next piece is searched */
+    char chr;         /*<! Separator */
+} estr_split_iter_t;
+
+/**
+ * @brief Line reader over memory-mapped file or view (see estr_lines_open, estr_v_lines and estr_lines_next)
+ */
+typedef struct {
+    const char* ptr;  /*<! Content (mapped file or view) */
+    size_t len;       /*<! Length of the content */
+    size_t pos;       /*<! Index from which next line is read */
+    void* map;        /*<! Mapped region (internal, NULL if nothing needs to be released) */
+    size_t map_len;   /*<! Size of the mapped region */
+} estr_lines_t;
+
+/**
+ * @brief Substring pattern compiled for repeated searching (see estr_pattern_compile)
+ */
+typedef struct {
+    const char* needle;     /*<! Searched string (not copied, it needs to outlive the pattern) */
+    size_t len;             /*<! Length of the searched string */
+    uint8_t skip[256];      /*<! Horspool shift for every character (capped to 255) */
+} estr_pattern_t;
+
+/**
+ * @brief Replacement pair for estr_rep_multi
+ */
+typedef struct {
+    const char* rep;   /*<! Part of the string which needs to be replaced (not empty) */
+    const char* with;  /*<! Replacement for rep */
+} estr_rep_pair_t;
+
+/**
+ * @brief Compiled set of replacements (see estr_rep_multi_compile)
+ */
+typedef struct estr_rep_multi* estr_rep_multi_t;
+
+/**
+ * @brief Compiled glob pattern (see estr_glob_compile)
+ */
+typedef struct estr_glob* estr_glob_t;
+
+/**
+ * @brief Compiled set of glob patterns (see estr_glob_set_compile)
+ */
+typedef struct estr_glob_set* estr_glob_set_t;
+
+/**
+ * @brief Growable string builder. Initialize it with estr_b_init and
+ *        release it with estr_b_finish (or estr_b_free)
+ */
+typedef struct {
+    char* buf;                 /*<! Built string (always null-terminated) */
+    size_t len;                /*<! Length of the built string */
+    size_t cap;                /*<! Number of characters which fit in buf (without null character) */
+    bool owned;                /*<! buf is allocated by the builder (not initial buffer) */
+    bool failed;               /*<! Some of the appends failed (no memory), result is incomplete */
+    char* initial;             /*<! Initial buffer (optional) */
+    size_t initial_size;       /*<! Size of the initial buffer */
+    cu_allocator_t allocator;  /*<! Allocator for the buffer */
+} estr_builder_t;
+
+/**
+ * @brief Append optional number of strings to builder.
+ *        Make sure that no one of the strings are NULL, otherwise appending will stop on the first NULL.
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+#define estr_b_cat(builder, ...) _estr_b_cat(builder, __VA_ARGS__, NULL)
+
+/**
+ * @brief State of chunked url decoding (see estr_url_decode_chunk). Zero-initialize before first use
+ */
+typedef struct {
+    char pending[3];      /*<! Incomplete escape sequence from the end of the previous chunk */
+    uint8_t pending_len;  /*<! Number of pending characters */
+} estr_url_decoder_t;
+
+/**
+ * @brief State of incremental hashing (see estr_hasher_init)
+ */
+typedef struct {
+    uint64_t acc[4];     /*<! Lane accumulators */
+    uint64_t seed;       /*<! Seed */
+    uint64_t total_len;  /*<! Number of hashed bytes */
+    uint8_t buf[32];     /*<! Bytes which don't fill the whole stripe yet */
+    uint8_t buf_len;     /*<! Number of buffered bytes */
+} estr_hasher_t;
+
+/**
+ * @brief String interning table (one canonical copy per distinct string)
+ */
+typedef struct estr_intern* estr_intern_t;
+
+/**
+ * @brief Interning table configuration
+ */
+typedef struct {
+    size_t capacity;                  /*<! Expected number of strings (ESTR_INTERN_DEFAULT_CAPACITY if zero) */
+    bool arena;                       /*<! Store strings in the table's own arena instead of separate allocations */
+    size_t arena_block_size;          /*<! Arena block size (CU_ARENA_DEFAULT_BLOCK_SIZE if zero) */
+    const cu_allocator_t* allocator;  /*<! Allocator for the table and the strings (NULL for the standard library) */
+} estr_intern_config_t;
+
+/**
+ * @brief Memory accounting of the interning table
+ */
+typedef struct {
+    size_t count;         /*<! Number of interned strings */
+    size_t slots;         /*<! Number of hash table slots */
+    size_t string_bytes;  /*<! Bytes occupied by the strings (with null characters) */
+    size_t total_bytes;   /*<! Bytes reserved by the table (slots, strings or arena blocks, table itself) */
+} estr_intern_stats_t;
+
+#define ESTR_SSO_CAPACITY (3 * sizeof(char*) - 2)  /*<! Maximal length of the string stored inline in estr_t (22 on 64-bit targets) */
+#define ESTR_SSO_HEAP 0xFF                         /*<! Tag of estr_t whose string is on the heap */
+
+/**
+ * @brief Owned string with length. Strings up to ESTR_SSO_CAPACITY characters are stored inline
+ *        (no allocation), longer ones on the heap. Zero-initialized estr_t is an empty string.
+ *        Use accessors (estr_s_str, estr_s_len, estr_s_view) instead of the fields
+ */
+typedef struct {
+    union {
+        struct {
+            char* ptr;   /*<! String on the heap */
+            size_t len;  /*<! Length of the heap string */
+        } heap;
+        char sso[ESTR_SSO_CAPACITY + 2];  /*<! Inline string with null character, last byte is the tag
+                                               (inline length or ESTR_SSO_HEAP) */
+    };
+} estr_t;
+
+#define _estr_s_tag(s) ((uint8_t) (s)->sso[ESTR_SSO_CAPACITY + 1])
+
+/**
+ * @brief Check if string is stored inline
+ * @param s Owned string
+ * @return true if string does not occupy heap memory
+ */
+static inline bool estr_s_is_inline(const estr_t* s) {
+    return _estr_s_tag(s) != ESTR_SSO_HEAP;
+}
+
+/**
+ * @brief Null-terminated string (valid until owned string is freed)
+ * @param s Owned string
+ * @return Pointer to string
+ */
+static inline const char* estr_s_str(const estr_t* s) {
+    return estr_s_is_inline(s) ? s->sso : s->heap.ptr;
+}
+
+/**
+ * @brief Length of the owned string
+ * @param s Owned string
+ * @return Number of characters
+ */
+static inline size_t estr_s_len(const estr_t* s) {
+    return estr_s_is_inline(s) ? _estr_s_tag(s) : s->heap.len;
+}
+
+/**
+ * @brief View of the owned string (valid until owned string is freed)
+ * @param s Owned string
+ * @return View
+ */
+static inline estr_view_t estr_s_view(const estr_t* s) {
+    return (estr_view_t) { .ptr = estr_s_str(s), .len = estr_s_len(s) };
+}
+
+/**
+ * @brief Make view from string literal (length is known at compile time)
+ */
+#define estr_view_lit(literal) ((estr_view_t) { .ptr = "" literal, .len = sizeof(literal) - 1 })
+
+/**
+ * @brief Compare len bytes of ptr with lit. If len is known at compile time and not bigger than 16,
+ *        comparison is made with two overlapping fixed-width loads (lit loads are folded into constants)
+ */
+static inline bool _estr_lit_eq(const char* ptr, const char* lit, size_t len) {
+#ifdef __GNUC__
+    if(__builtin_constant_p(len) && len <= 16) {
+        if(len >= 8) {
+            uint64_t a1, a2, b1, b2;
+            memcpy(&a1, ptr, 8); memcpy(&a2, ptr + len - 8, 8);
+            memcpy(&b1, lit, 8); memcpy(&b2, lit + len - 8, 8);
+            return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+        }
+
+        if(len >= 4) {
+            uint32_t a1, a2, b1, b2;
+            memcpy(&a1, ptr, 4); memcpy(&a2, ptr + len - 4, 4);
+            memcpy(&b1, lit, 4); memcpy(&b2, lit + len - 4, 4);
+            return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+        }
+
+        if(len >= 2) {
+            uint16_t a1, a2, b1, b2;
+            memcpy(&a1, ptr, 2); memcpy(&a2, ptr + len - 2, 2);
+            memcpy(&b1, lit, 2); memcpy(&b2, lit + len - 2, 2);
+            return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+        }
+
+        return len == 0 || ptr[0] == lit[0];
+    }
+#endif
+    return memcmp(ptr, lit, len) == 0;
+}
+
+/**
+ * @brief Bytes of null-terminated str are compared one by one with early exit,
+ *        so nothing is read after the null character (loop is unrolled for the literal length)
+ */
+static inline bool _estr_sw_lit(const char* str, const char* lit, size_t len) {
+    if(!str || len == 0) {
+        return false;
+    }
+
+    for(size_t i = 0; i < len; i++) {
+        if(str[i] != lit[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static inline bool _estr_eq_lit(const char* str, const char* lit, size_t len) {
+    return _estr_sw_lit(str, lit, len) ? str[len] == '\0' : (str && len == 0 && str[0] == '\0');
+}
+
+static inline bool _estr_ew_lit(const char* str, const char* lit, size_t len) {
+    if(!str || len == 0) {
+        return false;
+    }
+
+    size_t str_len = strlen(str);
+    return str_len >= len && _estr_lit_eq(str + str_len - len, lit, len);
+}
+
+static inline bool _estr_v_sw_lit(estr_view_t view, const char* lit, size_t len) {
+    return view.ptr && len > 0 && view.len >= len && _estr_lit_eq(view.ptr, lit, len);
+}
+
+static inline bool _estr_v_ew_lit(estr_view_t view, const char* lit, size_t len) {
+    return view.ptr && len > 0 && view.len >= len && _estr_lit_eq(view.ptr + view.len - len, lit, len);
+}
+
+static inline bool _estr_v_eq_lit(estr_view_t view, const char* lit, size_t len) {
+    return view.ptr && view.len == len && _estr_lit_eq(view.ptr, lit, len);
+}
+
+/**
+ * @brief Check if string starts with string literal (same as estr_sw, without strlen of the literal)
+ */
+#define estr_sw_lit(str, literal) _estr_sw_lit(str, "" literal, sizeof(literal) - 1)
+
+/**
+ * @brief Check if string ends with string literal (same as estr_ew, length of the literal is known at compile time)
+ */
+#define estr_ew_lit(str, literal) _estr_ew_lit(str, "" literal, sizeof(literal) - 1)
+
+/**
+ * @brief Check if string is equal to string literal (same as estr_eq)
+ */
+#define estr_eq_lit(str, literal) _estr_eq_lit(str, "" literal, sizeof(literal) - 1)
+
+/**
+ * @brief Check if view starts with string literal (same as estr_v_sw, short literals are compared with fixed-width loads)
+ */
+#define estr_v_sw_lit(view, literal) _estr_v_sw_lit(view, "" literal, sizeof(literal) - 1)
+
+/**
+ * @brief Check if view ends with string literal (same as estr_v_ew, short literals are compared with fixed-width loads)
+ */
+#define estr_v_ew_lit(view, literal) _estr_v_ew_lit(view, "" literal, sizeof(literal) - 1)
+
+/**
+ * @brief Check if view is equal to string literal (same as estr_v_eq, short literals are compared with fixed-width loads)
+ */
+#define estr_v_eq_lit(view, literal) _estr_v_eq_lit(view, "" literal, sizeof(literal) - 1)
 
 typedef struct {
     bool length;
     unsigned int minlen;
     unsigned int maxlen;
     bool no_whitespace;
+    const char* charset;  /*<! Allowed characters (optional), ranges can be used (ex: "a-z0-9_-") */
+    bool digits_only;     /*<! Only decimal digits are allowed */
+    const char* prefix;   /*<! Mandatory prefix (optional) */
+    const char* suffix;   /*<! Mandatory suffix (optional) */
+    bool utf8;            /*<! String needs to be valid UTF-8 (see estr_utf8_validate) */
 } estr_validation_t;
 
+/**
+ * @brief Validation schema compiled for repeated validation (see estr_schema_compile).
+ *        Checks are made in order: whitespace (if disallowed), length, prefix, suffix, characters, UTF-8
+ */
+typedef struct {
+    size_t minlen;          /*<! Minimal length */
+    size_t maxlen;          /*<! Maximal length */
+    uint64_t allowed[4];    /*<! Bitmap of allowed characters */
+    uint8_t scan;           /*<! Kernel which checks the characters (internal) */
+    bool no_whitespace;     /*<! Disallowed whitespace is reported as CU_ERR_ESTR_INVALID_WHITESPACE */
+    bool utf8;              /*<! Check UTF-8 validity */
+    const char* prefix;     /*<! Mandatory prefix (not copied, it needs to outlive the schema) */
+    size_t prefix_len;      /*<! Length of the prefix */
+    const char* suffix;     /*<! Mandatory suffix (not copied, it needs to outlive the schema) */
+    size_t suffix_len;      /*<! Length of the suffix */
+} estr_schema_t;
+
 /**
  * @brief Concatenate optional number of strings. User need to release the resulting string with a free function.
  *        Make sure that no one of the strings are NULL, otherwise concatenation will stop on the first NULL.
@@ -32,6 +403,15 @@ typedef struct {
  */
 #define estr_cat(...) _estr_cat(__VA_ARGS__, NULL)
 
+/**
+ * @brief Concatenate optional number of strings using allocator.
+ *        User need to release the resulting string with the same allocator.
+ *        Make sure that no one of the strings are NULL, otherwise concatenation will stop on the first NULL.
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result string or NULL on failure (no memory)
+ */
+#define estra_cat(allocator, ...) _estra_cat(allocator, __VA_ARGS__, NULL)
+
 /**
  * @brief Check if two strings are equal
  * @param str1 First string
@@ -85,6 +465,41 @@ bool estr_ew(const char* str1, const char* str2);
  */
 bool estr_ew_chr(const char* str, char chr);
 
+/**
+ * @brief Check if two strings are equal ignoring ASCII case (locale is not used)
+ * @param str1 First string
+ * @param str2 Second string
+ * @return true if first and second strings are equal ignoring case
+ */
+bool estr_ieq(const char* str1, const char* str2);
+
+/**
+ * @brief Check if two strings are equal ignoring ASCII case
+ * @param str1 First string
+ * @param str2 Second string
+ * @param n Number of character that needs to be tested
+ * @return true if first and second strings are equal ignoring case
+ */
+bool estrn_ieq(const char* str1, const char* str2, size_t n);
+
+/**
+ * @brief Check if one string starts with another ignoring ASCII case
+ * @param str1 First string
+ * @param str2 Second string
+ * @return true if first string starts with second one.
+ *         In special cases when second or both strings are empty, function will return false
+ */
+bool estr_isw(const char* str1, const char* str2);
+
+/**
+ * @brief Check if one string ends with another ignoring ASCII case
+ * @param str1 First string
+ * @param str2 Second string
+ * @return true if first string ends with second one.
+ *         In special cases when second or both strings are empty, function will return false
+ */
+bool estr_iew(const char* str1, const char* str2);
+
 /**
  * @brief Check if all characters in string are digits
  * @param str Haystack
@@ -112,89 +527,1514 @@ size_t estrn_chrcnt(const char* str, char chr, size_t n);
 char** estr_split(const char* str, const char chr, size_t* out_len);
 
 /**
- * @brief Don't use this function. Use estr_cat macro instead.
+ * @brief Same as estr_split, but resulting list and pieces are allocated with allocator
+ *        (cu_list_tfreea can be used for freeing)
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @param allocator Allocator (NULL for the standard library)
+ * @return List of strings after splitting
  */
-char* _estr_cat(const char* str, ...);
+char** estra_split(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator);
 
 /**
- * @brief Http url string encoding.
- *        Resulting encoded string of this functions needs to be freed with free function
- * @param str String which needs to be encoded
- * @return Pointer to encoded string
+ * @brief Split string using character without copying the pieces. Resulting list of spans
+ *        (offsets and lengths of the pieces in str) is one allocation which needs to be freed with free function
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @return List of spans or NULL if there are no pieces (or no memory)
  */
-char* estr_url_encode(const char* str);
+estr_span_t* estr_split_spans(const char* str, const char chr, size_t* out_len);
 
 /**
- * @brief Replace string with another string. Result needs to be freed
- * @param orig Original string
- * @param rep Part of the string which needs to be replaced
- * @param with Replacement for rep
- * @return Pointer to result or NULL on failure
+ * @brief Same as estr_split_spans, but resulting list is allocated with allocator
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @param allocator Allocator (NULL for the standard library)
+ * @return List of spans or NULL if there are no pieces (or no memory)
  */
-char* estr_rep(const char* orig, const char* rep, const char* with);
+estr_span_t* estra_split_spans(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator);
 
 /**
- * @brief Checks if character is alphanumeric
- * @param chr Character
- * @return true if character is alphanumeric
+ * @brief Split view using character into caller's list of spans. Nothing is allocated
+ * @param view View that is gonna be used for splitting
+ * @param chr Character around which view is be splitted
+ * @param spans List of spans (can be NULL if cap is zero)
+ * @param cap Capacity of the list. Pieces after the first cap ones are counted but not stored
+ * @return Total number of pieces (can be bigger than cap)
  */
-bool estr_is_alnum(char chr);
+size_t estr_v_split_spans(estr_view_t view, const char chr, estr_span_t* spans, size_t cap);
 
 /**
- * @brief Check if character is whitespace
- * @param chr Character
- * @return true if character is whitespace
+ * @brief Same as estr_split, but list of pointers and the pieces are packed into one allocation,
+ *        so resulting list needs to be freed only once with free function
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @return List of strings after splitting or NULL if there are no pieces (or no memory)
  */
-bool estr_chr_is_ws(char chr);
+char** estr_split_packed(const char* str, const char chr, size_t* out_len);
 
 /**
- * @brief Checks if string does not starts or ends with whitespace
- * @param str String that is gonna be tested if it is trimmed
- * @return true if string is trimmed.
- *         If special case when string is null, false will be returned.
+ * @brief Same as estr_split_packed, but resulting list is allocated with allocator
+ *        (needs to be freed only once with the same allocator)
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @param allocator Allocator (NULL for the standard library)
+ * @return List of strings after splitting or NULL if there are no pieces (or no memory)
  */
-bool estr_is_trimmed(const char* str);
+char** estra_split_packed(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator);
 
 /**
- * @brief Checks if string contains unescaped character
- * @param str String
- * @param chr Character
- * @return true if string contains unescaped character.
- *         In special case when string is null, false will be returned
+ * @brief Same as estr_split, but pieces are owned strings, so short pieces are not separately allocated.
+ *        Resulting list needs to be freed with estr_s_list_free
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @return List of owned strings after splitting or NULL if there are no pieces (or no memory)
  */
-bool estr_contains_unescaped_chr(const char* str, char chr);
+estr_t* estr_split_s(const char* str, const char chr, size_t* out_len);
 
 /**
- * @brief Checks if string is empty (string is empty if it contains only whitespace chars or his length is zero)
- * @param str String
- * @return true if string is empty (or NULL)
+ * @brief Same as estr_split_s, but resulting list and heap pieces are allocated with allocator
+ *        (estra_s_list_free needs to be used for freeing)
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @param out_len Pointer to outer variable in which be stored length of resulting list
+ * @param allocator Allocator (NULL for the standard library)
+ * @return List of owned strings after splitting or NULL if there are no pieces (or no memory)
  */
-bool estr_is_empty_ws(const char* str);
+estr_t* estra_split_s(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator);
 
 /**
- * @brief Make string by repeating character multiple times.
- *        Result needs to be freed
- * @param chr Character
- * @param times How much time chr needs to be repeated
- * @return pointer to allocated null-terminated string, or NULL on failure (no memory) or if times == 0
+ * @brief Make iterator which splits string using character (same rules as estr_split).
+ *        Nothing is allocated and string is not scanned until estr_split_next is called
+ * @param str String that is gonna be used for splitting
+ * @param chr Character around which string is be splitted
+ * @return Iterator
  */
-char* estr_repeat_chr(char chr, unsigned int times);
+estr_split_iter_t estr_split_iter(const char* str, const char chr);
 
 /**
- * @brief Check if string contains whitespace
- * @param str String
- * @return true if string contains whitespace, otherwise false.
- *         If str is NULL, false will be returned.
+ * @brief Same as estr_split_iter, but for view
+ * @param view View that is gonna be used for splitting
+ * @param chr Character around which view is be splitted
+ * @return Iterator
  */
-bool estr_contains_ws(const char* str);
+estr_split_iter_t estr_v_split_iter(estr_view_t view, const char chr);
 
 /**
- * @brief Validate string by schema
- * @param str String
- * @param validation Validation schema
- * @return CU_OK if string is valid
+ * @brief Get next piece from the iterator. Piece is view into the original string, nothing is allocated
+ * @param it Iterator
+ * @param piece Pointer to outer variable in which be stored the piece
+ * @return true if piece is found, false if there are no more pieces
+ */
+bool estr_split_next(estr_split_iter_t* it, estr_view_t* piece);
+
+/**
+ * @brief Open file for reading line by line. File is memory-mapped (with sequential access hint),
+ *        so lines are views into the page cache and nothing is copied. Release it with estr_lines_close
+ * @param path Path of the file
+ * @param lines Pointer to outer variable in which be stored the reader
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NOT_FOUND (file does not exist);
+ *         CU_ERR_OUT_OF_BOUNDS (file does not fit into address space);
+ *         CU_ERR_NO_MEM;
+ *         CU_FAIL (file can't be read or mapped)
+ */
+cu_err_t estr_lines_open(const char* path, estr_lines_t* lines);
+
+/**
+ * @brief Make line reader over view (estr_lines_close is not needed)
+ * @param view View
+ * @return Reader
+ */
+estr_lines_t estr_v_lines(estr_view_t view);
+
+/**
+ * @brief Get next line. Lines end with "\n" or "\r\n" (line ending is not part of the line),
+ *        last line doesn't need to end with newline. Empty lines are not skipped
+ * @param lines Reader
+ * @param line Pointer to outer variable in which be stored the line (view which is valid until the reader is closed)
+ * @return true if line is read, false if there are no more lines
+ */
+bool estr_lines_next(estr_lines_t* lines, estr_view_t* line);
+
+/**
+ * @brief Unmap the file opened with estr_lines_open. Reader is zeroed (safe to close it again)
+ * @param lines Reader
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_lines_close(estr_lines_t* lines);
+
+/**
+ * @brief Don't use this function. Use estr_cat macro instead.
+ */
+char* _estr_cat(const char* str, ...);
+
+/**
+ * @brief Don't use this function. Use estra_cat macro instead.
+ */
+char* _estra_cat(const cu_allocator_t* allocator, const char* str, ...);
+
+/**
+ * @brief Http url string encoding.
+ *        Resulting encoded string of this functions needs to be freed with free function
+ * @param str String which needs to be encoded
+ * @return Pointer to encoded string
+ */
+char* estr_url_encode(const char* str);
+
+/**
+ * @brief Http url string encoding using allocator.
+ *        Resulting encoded string needs to be freed with the same allocator
+ * @param str String which needs to be encoded
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to encoded string
+ */
+char* estra_url_encode(const char* str, const cu_allocator_t* allocator);
+
+/**
+ * @brief Http url encoding into caller's buffer. Nothing is allocated
+ * @param view View which needs to be encoded
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes (including null character)
+ * @param out_len Length of the encoded string, also if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small, nothing is written)
+ */
+cu_err_t estr_v_url_encode_to(estr_view_t view, char* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Http url decoding ('+' is decoded as space).
+ *        Resulting decoded string needs to be freed with free function
+ * @param str String which needs to be decoded
+ * @return Pointer to decoded string or NULL on failure (invalid escape sequence or no memory)
+ */
+char* estr_url_decode(const char* str);
+
+/**
+ * @brief Http url decoding using allocator.
+ *        Resulting decoded string needs to be freed with the same allocator
+ * @param str String which needs to be decoded
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to decoded string or NULL on failure (invalid escape sequence or no memory)
+ */
+char* estra_url_decode(const char* str, const cu_allocator_t* allocator);
+
+/**
+ * @brief Http url decoding into caller's buffer. Nothing is allocated
+ * @param view View which needs to be decoded
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes (including null character)
+ * @param out_len Length of the decoded string, also if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (invalid escape sequence);
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small)
+ */
+cu_err_t estr_v_url_decode_to(estr_view_t view, char* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Decode one chunk of url encoded stream and append it to builder.
+ *        Escape sequence may be split between chunks
+ * @param decoder Decoder state
+ * @param chunk Chunk of encoded stream
+ * @param builder Builder to which decoded characters are appended
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (invalid escape sequence);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_url_decode_chunk(estr_url_decoder_t* decoder, estr_view_t chunk, estr_builder_t* builder);
+
+/**
+ * @brief Finish url decoding of stream. Decoder is ready for the next stream after this call
+ * @param decoder Decoder state
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (stream ends with incomplete escape sequence)
+ */
+cu_err_t estr_url_decode_end(estr_url_decoder_t* decoder);
+
+/**
+ * @brief Length of hex encoded data
+ * @param len Number of bytes
+ * @return Number of hex digits (without null character) or SIZE_MAX on overflow
+ */
+size_t estr_hex_encoded_len(size_t len);
+
+/**
+ * @brief Upper bound of hex decoded data length (exact if view doesn't contain whitespace)
+ * @param view Hex digits
+ * @return Number of bytes
+ */
+size_t estr_hex_decoded_len(estr_view_t view);
+
+/**
+ * @brief Lowercase hex encoding. Encoding is vectorized (AVX2 or SSSE3) where available.
+ *        Resulting string needs to be freed with free function
+ * @param data Data which needs to be encoded
+ * @param len Number of bytes
+ * @return Pointer to encoded string or NULL on failure
+ */
+char* estr_hex_encode(const void* data, size_t len);
+
+/**
+ * @brief Lowercase hex encoding using allocator.
+ *        Resulting string needs to be freed with the same allocator
+ * @param data Data which needs to be encoded
+ * @param len Number of bytes
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to encoded string or NULL on failure
+ */
+char* estra_hex_encode(const void* data, size_t len, const cu_allocator_t* allocator);
+
+/**
+ * @brief Lowercase hex encoding into caller's buffer. Nothing is allocated
+ * @param data Data which needs to be encoded (can be NULL if len is zero)
+ * @param len Number of bytes
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes (including null character)
+ * @param out_len Length of the encoded string, also if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small, nothing is written)
+ */
+cu_err_t estr_hex_encode_to(const void* data, size_t len, char* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Hex decoding (digits are case insensitive).
+ *        Resulting data is null-terminated and needs to be freed with free function
+ * @param view Hex digits
+ * @param mode Strictness
+ * @param out_len Number of decoded bytes (optional)
+ * @return Pointer to decoded data or NULL on failure (invalid encoding or no memory)
+ */
+uint8_t* estr_v_hex_decode(estr_view_t view, estr_decode_t mode, size_t* out_len);
+
+/**
+ * @brief Hex decoding using allocator.
+ *        Resulting data is null-terminated and needs to be freed with the same allocator
+ * @param view Hex digits
+ * @param mode Strictness
+ * @param out_len Number of decoded bytes (optional)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to decoded data or NULL on failure (invalid encoding or no memory)
+ */
+uint8_t* estra_v_hex_decode(estr_view_t view, estr_decode_t mode, size_t* out_len, const cu_allocator_t* allocator);
+
+/**
+ * @brief Hex decoding into caller's buffer. Nothing is allocated and null character is not appended
+ * @param view Hex digits
+ * @param mode Strictness
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes
+ * @param out_len Number of decoded bytes, or estr_hex_decoded_len if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (invalid character or odd number of digits);
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small)
+ */
+cu_err_t estr_v_hex_decode_to(estr_view_t view, estr_decode_t mode, void* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Length of base64 encoded data
+ * @param len Number of bytes
+ * @param alphabet Alphabet (standard one is padded)
+ * @return Number of characters (without null character) or SIZE_MAX on overflow
+ */
+size_t estr_base64_encoded_len(size_t len, estr_base64_t alphabet);
+
+/**
+ * @brief Upper bound of base64 decoded data length (exact if view doesn't contain whitespace)
+ * @param view Base64 characters
+ * @return Number of bytes
+ */
+size_t estr_base64_decoded_len(estr_view_t view);
+
+/**
+ * @brief Base64 encoding. Encoding is vectorized (AVX2 or SSSE3) where available.
+ *        Resulting string needs to be freed with free function
+ * @param data Data which needs to be encoded
+ * @param len Number of bytes
+ * @param alphabet Alphabet
+ * @return Pointer to encoded string or NULL on failure
+ */
+char* estr_base64_encode(const void* data, size_t len, estr_base64_t alphabet);
+
+/**
+ * @brief Base64 encoding using allocator.
+ *        Resulting string needs to be freed with the same allocator
+ * @param data Data which needs to be encoded
+ * @param len Number of bytes
+ * @param alphabet Alphabet
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to encoded string or NULL on failure
+ */
+char* estra_base64_encode(const void* data, size_t len, estr_base64_t alphabet, const cu_allocator_t* allocator);
+
+/**
+ * @brief Base64 encoding into caller's buffer. Nothing is allocated
+ * @param data Data which needs to be encoded (can be NULL if len is zero)
+ * @param len Number of bytes
+ * @param alphabet Alphabet
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes (including null character)
+ * @param out_len Length of the encoded string, also if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small, nothing is written)
+ */
+cu_err_t estr_base64_encode_to(const void* data, size_t len, estr_base64_t alphabet, char* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Base64 decoding.
+ *        Resulting data is null-terminated and needs to be freed with free function
+ * @param view Base64 characters
+ * @param alphabet Alphabet (lenient mode accepts both)
+ * @param mode Strictness
+ * @param out_len Number of decoded bytes (optional)
+ * @return Pointer to decoded data or NULL on failure (invalid encoding or no memory)
+ */
+uint8_t* estr_v_base64_decode(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode, size_t* out_len);
+
+/**
+ * @brief Base64 decoding using allocator.
+ *        Resulting data is null-terminated and needs to be freed with the same allocator
+ * @param view Base64 characters
+ * @param alphabet Alphabet (lenient mode accepts both)
+ * @param mode Strictness
+ * @param out_len Number of decoded bytes (optional)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to decoded data or NULL on failure (invalid encoding or no memory)
+ */
+uint8_t* estra_v_base64_decode(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode, size_t* out_len,
+    const cu_allocator_t* allocator);
+
+/**
+ * @brief Base64 decoding into caller's buffer. Nothing is allocated and null character is not appended
+ * @param view Base64 characters
+ * @param alphabet Alphabet (lenient mode accepts both)
+ * @param mode Strictness
+ * @param buf Buffer (can be NULL if size is zero)
+ * @param size Size of the buffer in bytes
+ * @param out_len Number of decoded bytes, or estr_base64_decoded_len if buffer is too small (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (character out of the alphabet, incomplete group, wrong padding
+ *                             or nonzero unused bits in strict mode);
+ *         CU_ERR_OUT_OF_BOUNDS (buffer is too small)
+ */
+cu_err_t estr_v_base64_decode_to(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode,
+    void* buf, size_t size, size_t* out_len);
+
+/**
+ * @brief Replace string with another string. Result needs to be freed
+ * @param orig Original string
+ * @param rep Part of the string which needs to be replaced
+ * @param with Replacement for rep
+ * @return Pointer to result or NULL on failure
+ */
+char* estr_rep(const char* orig, const char* rep, const char* with);
+
+/**
+ * @brief Replace string with another string using allocator. Result needs to be freed with the same allocator
+ * @param orig Original string
+ * @param rep Part of the string which needs to be replaced
+ * @param with Replacement for rep
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result or NULL on failure
+ */
+char* estra_rep(const char* orig, const char* rep, const char* with, const cu_allocator_t* allocator);
+
+/**
+ * @brief Compile pattern for searching. Compiled pattern can be used any number of times
+ *        (also from multiple threads) and it does not need to be freed
+ * @param pattern Pattern
+ * @param needle Searched string (needs to outlive the pattern)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG (also if needle is empty)
+ */
+cu_err_t estr_pattern_compile(estr_pattern_t* pattern, const char* needle);
+
+/**
+ * @brief Find first occurrence of pattern in string
+ * @param pattern Compiled pattern
+ * @param str Haystack
+ * @return Pointer to first occurrence or NULL if not found
+ */
+const char* estr_find(const estr_pattern_t* pattern, const char* str);
+
+/**
+ * @brief Find first occurrence of pattern in view
+ * @param pattern Compiled pattern
+ * @param view Haystack
+ * @return Pointer to first occurrence or NULL if not found
+ */
+const char* estr_v_find(const estr_pattern_t* pattern, estr_view_t view);
+
+/**
+ * @brief Find first occurrence of needle in string ignoring ASCII case.
+ *        Candidates are found by both cases of the first character, and compared with vectorized kernels
+ * @param str Haystack
+ * @param needle Searched string
+ * @return Pointer to first occurrence or NULL if not found (or needle is empty)
+ */
+const char* estr_ifind(const char* str, const char* needle);
+
+/**
+ * @brief Find first occurrence of needle in view ignoring ASCII case
+ * @param view Haystack
+ * @param needle Searched view
+ * @return Pointer to first occurrence or NULL if not found (or needle is empty)
+ */
+const char* estr_v_ifind(estr_view_t view, estr_view_t needle);
+
+/**
+ * @brief Count number of non-overlapping occurrences of pattern in string
+ * @param pattern Compiled pattern
+ * @param str Haystack
+ * @return Number of occurrences
+ */
+size_t estr_count(const estr_pattern_t* pattern, const char* str);
+
+/**
+ * @brief Replace all occurrences of compiled pattern with another string. Result needs to be freed.
+ *        String is searched only once, positions of matches are remembered for copying
+ * @param orig Original string
+ * @param rep Compiled pattern which needs to be replaced
+ * @param with Replacement for rep
+ * @return Pointer to result or NULL on failure
+ */
+char* estr_rep_p(const char* orig, const estr_pattern_t* rep, const char* with);
+
+/**
+ * @brief Same as estr_rep_p, but result is allocated with allocator
+ * @param orig Original string
+ * @param rep Compiled pattern which needs to be replaced
+ * @param with Replacement for rep
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result or NULL on failure
+ */
+char* estra_rep_p(const char* orig, const estr_pattern_t* rep, const char* with, const cu_allocator_t* allocator);
+
+/**
+ * @brief Compile set of replacements for repeated use with estr_rep_m. Pairs are copied.
+ *        If multiple patterns match at the same position, the longest one is replaced
+ *        (if patterns are the same, first pair wins)
+ * @param pairs List of replacement pairs
+ * @param npairs Number of pairs
+ * @param multi Compiled replacements reference (needs to be destroyed with estr_rep_multi_destroy)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG (also if any rep is empty);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_rep_multi_compile(const estr_rep_pair_t* pairs, size_t npairs, estr_rep_multi_t* multi);
+
+/**
+ * @brief Same as estr_rep_multi_compile, but compiled replacements are allocated with allocator
+ * @param pairs List of replacement pairs
+ * @param npairs Number of pairs
+ * @param multi Compiled replacements reference (needs to be destroyed with estr_rep_multi_destroy)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG (also if any rep is empty);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estra_rep_multi_compile(const estr_rep_pair_t* pairs, size_t npairs, estr_rep_multi_t* multi, const cu_allocator_t* allocator);
+
+/**
+ * @brief Free the memory occupied by the compiled replacements
+ * @param multi Compiled replacements
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_rep_multi_destroy(estr_rep_multi_t multi);
+
+/**
+ * @brief Do all of the compiled replacements in one pass (leftmost-longest match wins). Result needs to be freed
+ * @param orig Original string
+ * @param multi Compiled replacements
+ * @return Pointer to result or NULL on failure
+ */
+char* estr_rep_m(const char* orig, estr_rep_multi_t multi);
+
+/**
+ * @brief Same as estr_rep_m, but result is allocated with allocator
+ * @param orig Original string
+ * @param multi Compiled replacements
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result or NULL on failure
+ */
+char* estra_rep_m(const char* orig, estr_rep_multi_t multi, const cu_allocator_t* allocator);
+
+/**
+ * @brief Same as estra_rep_m, but original is view
+ * @param orig Original view
+ * @param multi Compiled replacements
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result or NULL on failure
+ */
+char* estra_v_rep_m(estr_view_t orig, estr_rep_multi_t multi, const cu_allocator_t* allocator);
+
+/**
+ * @brief Compile glob pattern for repeated matching. Pattern matches the whole string and supports
+ *        '*' (any run of characters), '?' (any character), classes like "[a-z_]" or "[!0-9]"
+ *        and '\\' which escapes the next character. Pattern is split by '*' into fixed-length segments
+ *        which are searched by their longest literal run, so matching never backtracks
+ * @param pattern Pattern
+ * @param glob Compiled pattern reference (needs to be destroyed with estr_glob_destroy)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (unclosed class, reversed range or trailing backslash);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_glob_compile(const char* pattern, estr_glob_t* glob);
+
+/**
+ * @brief Same as estr_glob_compile, but compiled pattern is allocated with allocator
+ * @param pattern Pattern
+ * @param glob Compiled pattern reference (needs to be destroyed with estr_glob_destroy)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (unclosed class, reversed range or trailing backslash);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estra_glob_compile(const char* pattern, estr_glob_t* glob, const cu_allocator_t* allocator);
+
+/**
+ * @brief Free the memory occupied by the compiled pattern
+ * @param glob Compiled pattern
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_glob_destroy(estr_glob_t glob);
+
+/**
+ * @brief Check if whole string matches compiled glob pattern
+ * @param glob Compiled pattern
+ * @param str String
+ * @return true if string matches
+ */
+bool estr_glob_match(estr_glob_t glob, const char* str);
+
+/**
+ * @brief Check if whole view matches compiled glob pattern
+ * @param glob Compiled pattern
+ * @param view View
+ * @return true if view matches
+ */
+bool estr_v_glob_match(estr_glob_t glob, estr_view_t view);
+
+/**
+ * @brief Compile set of glob patterns (see estr_glob_compile) for matching one string against all of them.
+ *        Patterns are bucketed by the first character, so only the patterns which can match are tried
+ * @param patterns List of patterns
+ * @param npatterns Number of patterns
+ * @param set Compiled set reference (needs to be destroyed with estr_glob_set_destroy)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (any of the patterns is invalid);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_glob_set_compile(const char* const* patterns, size_t npatterns, estr_glob_set_t* set);
+
+/**
+ * @brief Same as estr_glob_set_compile, but compiled set is allocated with allocator
+ * @param patterns List of patterns
+ * @param npatterns Number of patterns
+ * @param set Compiled set reference (needs to be destroyed with estr_glob_set_destroy)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_SYNTAX_ERROR (any of the patterns is invalid);
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estra_glob_set_compile(const char* const* patterns, size_t npatterns, estr_glob_set_t* set, const cu_allocator_t* allocator);
+
+/**
+ * @brief Free the memory occupied by the compiled set
+ * @param set Compiled set
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_glob_set_destroy(estr_glob_set_t set);
+
+/**
+ * @brief Check if string matches any pattern of the set
+ * @param set Compiled set
+ * @param str String
+ * @param out_index Pointer to outer variable in which be stored index of the first matching pattern (optional)
+ * @return true if any pattern matches
+ */
+bool estr_glob_set_match(estr_glob_set_t set, const char* str, size_t* out_index);
+
+/**
+ * @brief Check if view matches any pattern of the set
+ * @param set Compiled set
+ * @param view View
+ * @param out_index Pointer to outer variable in which be stored index of the first matching pattern (optional)
+ * @return true if any pattern matches
+ */
+bool estr_v_glob_set_match(estr_glob_set_t set, estr_view_t view, size_t* out_index);
+
+/**
+ * @brief Do multiple replacements in one pass (leftmost-longest match wins). Result needs to be freed.
+ *        Use estr_rep_multi_compile and estr_rep_m if the same replacements are done repeatedly
+ * @param orig Original string
+ * @param pairs List of replacement pairs
+ * @param npairs Number of pairs
+ * @return Pointer to result or NULL on failure
+ */
+char* estr_rep_multi(const char* orig, const estr_rep_pair_t* pairs, size_t npairs);
+
+/**
+ * @brief Same as estr_rep_multi, but result is allocated with allocator
+ * @param orig Original string
+ * @param pairs List of replacement pairs
+ * @param npairs Number of pairs
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to result or NULL on failure
+ */
+char* estra_rep_multi(const char* orig, const estr_rep_pair_t* pairs, size_t npairs, const cu_allocator_t* allocator);
+
+/**
+ * @brief Checks if character is alphanumeric
+ * @param chr Character
+ * @return true if character is alphanumeric
+ */
+bool estr_is_alnum(char chr);
+
+/**
+ * @brief Check if character is whitespace
+ * @param chr Character
+ * @return true if character is whitespace
+ */
+bool estr_chr_is_ws(char chr);
+
+/**
+ * @brief Checks if string does not starts or ends with whitespace
+ * @param str String that is gonna be tested if it is trimmed
+ * @return true if string is trimmed.
+ *         If special case when string is null, false will be returned.
+ */
+bool estr_is_trimmed(const char* str);
+
+/**
+ * @brief Checks if string contains unescaped character. Character is escaped
+ *        if it's preceded by odd number of backslashes (in "\\\\\"" quote is not escaped)
+ * @param str String
+ * @param chr Character
+ * @return true if string contains unescaped character.
+ *         In special case when string is null, false will be returned
+ */
+bool estr_contains_unescaped_chr(const char* str, char chr);
+
+/**
+ * @brief Find all unescaped occurrences of character in one pass (see estr_contains_unescaped_chr)
+ * @param str String
+ * @param chr Character
+ * @param positions List for positions of the occurrences (can be NULL if cap is zero)
+ * @param cap Capacity of the list. Occurrences after the first cap ones are counted but not stored
+ * @return Total number of unescaped occurrences (can be bigger than cap)
+ */
+size_t estr_find_unescaped(const char* str, char chr, size_t* positions, size_t cap);
+
+/**
+ * @brief Checks if string is empty (string is empty if it contains only whitespace chars or his length is zero)
+ * @param str String
+ * @return true if string is empty (or NULL)
+ */
+bool estr_is_empty_ws(const char* str);
+
+/**
+ * @brief Make string by repeating character multiple times.
+ *        Result needs to be freed
+ * @param chr Character
+ * @param times How much time chr needs to be repeated
+ * @return pointer to allocated null-terminated string, or NULL on failure (no memory) or if times == 0
+ */
+char* estr_repeat_chr(char chr, unsigned int times);
+
+/**
+ * @brief Make string by repeating character multiple times using allocator.
+ *        Result needs to be freed with the same allocator
+ * @param chr Character
+ * @param times How much time chr needs to be repeated
+ * @param allocator Allocator (NULL for the standard library)
+ * @return pointer to allocated null-terminated string, or NULL on failure (no memory) or if times == 0
+ */
+char* estra_repeat_chr(char chr, unsigned int times, const cu_allocator_t* allocator);
+
+/**
+ * @brief Check if string contains whitespace
+ * @param str String
+ * @return true if string contains whitespace, otherwise false.
+ *         If str is NULL, false will be returned.
+ */
+bool estr_contains_ws(const char* str);
+
+/**
+ * @brief Make view from null-terminated string
+ * @param str String (NULL makes null view)
+ * @return View
+ */
+estr_view_t estr_view(const char* str);
+
+/**
+ * @brief Make view from at most n characters of string
+ * @param str String (NULL makes null view)
+ * @param n Maximal number of characters
+ * @return View
+ */
+estr_view_t estrn_view(const char* str, size_t n);
+
+/**
+ * @brief Make view of part of another view. Offset and length are clamped to the view bounds
+ * @param view View
+ * @param offset Index of first character
+ * @param len Number of characters
+ * @return View
+ */
+estr_view_t estr_v_sub(estr_view_t view, size_t offset, size_t len);
+
+/**
+ * @brief Copy view into new null-terminated string. Result needs to be freed
+ * @param view View
+ * @return Pointer to allocated string or NULL on failure (no memory or null view)
+ */
+char* estr_v_dup(estr_view_t view);
+
+/**
+ * @brief Same as estr_v_dup, but result is allocated with allocator
+ * @param view View
+ * @param allocator Allocator (NULL for the standard library)
+ * @return Pointer to allocated string or NULL on failure (no memory or null view)
+ */
+char* estra_v_dup(estr_view_t view, const cu_allocator_t* allocator);
+
+/**
+ * @brief Check if two views are equal
+ * @param view1 First view
+ * @param view2 Second view
+ * @return true if views have same characters. If any of them is null view, false will be returned
+ */
+bool estr_v_eq(estr_view_t view1, estr_view_t view2);
+
+/**
+ * @brief Check if view starts with another view
+ * @param view View
+ * @param prefix Prefix
+ * @return true if view starts with prefix.
+ *         In special cases when prefix or both views are empty, function will return false
+ */
+bool estr_v_sw(estr_view_t view, estr_view_t prefix);
+
+/**
+ * @brief Check if view starts with character
+ * @param view View
+ * @param chr Character
+ * @return true if view starts with character (false if view is empty)
+ */
+bool estr_v_sw_chr(estr_view_t view, char chr);
+
+/**
+ * @brief Check if view ends with another view
+ * @param view View
+ * @param suffix Suffix
+ * @return true if view ends with suffix.
+ *         In special cases when suffix or both views are empty, function will return false
+ */
+bool estr_v_ew(estr_view_t view, estr_view_t suffix);
+
+/**
+ * @brief Check if view ends with character
+ * @param view View
+ * @param chr Character
+ * @return true if view ends with character (false if view is empty)
+ */
+bool estr_v_ew_chr(estr_view_t view, char chr);
+
+/**
+ * @brief Check if two views are equal ignoring ASCII case
+ * @param view1 First view
+ * @param view2 Second view
+ * @return true if views are equal ignoring case (false if any of them is null view)
+ */
+bool estr_v_ieq(estr_view_t view1, estr_view_t view2);
+
+/**
+ * @brief Check if view starts with another view ignoring ASCII case
+ * @param view View
+ * @param prefix Prefix
+ * @return true if view starts with prefix.
+ *         In special cases when prefix or both views are empty, function will return false
+ */
+bool estr_v_isw(estr_view_t view, estr_view_t prefix);
+
+/**
+ * @brief Check if view ends with another view ignoring ASCII case
+ * @param view View
+ * @param suffix Suffix
+ * @return true if view ends with suffix.
+ *         In special cases when suffix or both views are empty, function will return false
+ */
+bool estr_v_iew(estr_view_t view, estr_view_t suffix);
+
+/**
+ * @brief Check if all characters in view are digits
+ * @param view View
+ * @return true if all characters are digits (false for null view)
+ */
+bool estr_v_is_digit_only(estr_view_t view);
+
+/**
+ * @brief Count number of occurences of character in view
+ * @param view View
+ * @param chr Character
+ * @return Number of character occurences
+ */
+size_t estr_v_chrcnt(estr_view_t view, char chr);
+
+/**
+ * @brief Checks if view does not starts or ends with whitespace
+ * @param view View
+ * @return true if view is trimmed (empty view is trimmed, null view is not)
+ */
+bool estr_v_is_trimmed(estr_view_t view);
+
+/**
+ * @brief Checks if view contains unescaped character
+ * @param view View
+ * @param chr Character
+ * @return true if view contains unescaped character
+ */
+bool estr_v_contains_unescaped_chr(estr_view_t view, char chr);
+
+/**
+ * @brief Find all unescaped occurrences of character in view in one pass
+ * @param view View
+ * @param chr Character
+ * @param positions List for positions of the occurrences (can be NULL if cap is zero)
+ * @param cap Capacity of the list. Occurrences after the first cap ones are counted but not stored
+ * @return Total number of unescaped occurrences (can be bigger than cap)
+ */
+size_t estr_v_find_unescaped(estr_view_t view, char chr, size_t* positions, size_t cap);
+
+/**
+ * @brief Checks if view is empty (contains only whitespace chars or his length is zero)
+ * @param view View
+ * @return true if view is empty (or null view)
+ */
+bool estr_v_is_empty_ws(estr_view_t view);
+
+/**
+ * @brief Check if view contains whitespace
+ * @param view View
+ * @return true if view contains whitespace, otherwise false
+ */
+bool estr_v_contains_ws(estr_view_t view);
+
+/**
+ * @brief Check if view is valid UTF-8 (no overlong forms, surrogates or code points above U+10FFFF).
+ *        Validation is vectorized with lookup tables (AVX2 or SSSE3) where available
+ * @param view View
+ * @param out_index Pointer to outer variable in which be stored index of the first invalid byte,
+ *                  or length of the view if it's valid (optional)
+ * @return CU_OK if view is valid UTF-8, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_ESTR_INVALID_UTF8
+ */
+cu_err_t estr_utf8_validate(estr_view_t view, size_t* out_index);
+
+/**
+ * @brief Count code points in UTF-8 view (bytes which are not continuation bytes,
+ *        so the result is meaningful only for valid UTF-8, see estr_utf8_validate)
+ * @param view View
+ * @return Number of code points (0 for null view)
+ */
+size_t estr_utf8_count(estr_view_t view);
+
+/**
+ * @brief Initialize builder. Nothing is allocated until the initial buffer is full
+ * @param builder Builder
+ * @param buf Initial buffer, usually on the stack (optional)
+ * @param size Size of the initial buffer in bytes (including null character)
+ * @param allocator Allocator for the buffer (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_b_init(estr_builder_t* builder, char* buf, size_t size, const cu_allocator_t* allocator);
+
+/**
+ * @brief Make sure that n more characters can be appended without reallocation.
+ *        Buffer grows geometrically, so appending is amortized O(1) per character
+ * @param builder Builder
+ * @param n Number of characters
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_reserve(estr_builder_t* builder, size_t n);
+
+/**
+ * @brief Append character
+ * @param builder Builder
+ * @param chr Character
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_chr(estr_builder_t* builder, char chr);
+
+/**
+ * @brief Append string
+ * @param builder Builder
+ * @param str String
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_str(estr_builder_t* builder, const char* str);
+
+/**
+ * @brief Append view
+ * @param builder Builder
+ * @param view View
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_view(estr_builder_t* builder, estr_view_t view);
+
+/**
+ * @brief Append character repeated multiple times
+ * @param builder Builder
+ * @param chr Character
+ * @param times How much time chr needs to be repeated
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_repeat(estr_builder_t* builder, char chr, size_t times);
+
+/**
+ * @brief Append signed integer in decimal format
+ * @param builder Builder
+ * @param num Number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_i64(estr_builder_t* builder, int64_t num);
+
+/**
+ * @brief Append unsigned integer in decimal format
+ * @param builder Builder
+ * @param num Number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_u64(estr_builder_t* builder, uint64_t num);
+
+/**
+ * @brief Append unsigned integer in hex format (see estr_fmt_hex)
+ * @param builder Builder
+ * @param num Number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_hex(estr_builder_t* builder, uint64_t num);
+
+/**
+ * @brief Append double in the shortest round-trip format (see estr_fmt_f64)
+ * @param builder Builder
+ * @param num Number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_f64(estr_builder_t* builder, double num);
+
+/**
+ * @brief Append view with all of the compiled replacements made (see estra_v_rep_m)
+ * @param builder Builder
+ * @param view Original
+ * @param multi Compiled replacements
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_v_rep_m(estr_builder_t* builder, estr_view_t view, estr_rep_multi_t multi);
+
+/**
+ * @brief Append url encoded string (see estr_url_encode)
+ * @param builder Builder
+ * @param str String which needs to be encoded
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_url_encode(estr_builder_t* builder, const char* str);
+
+/**
+ * @brief Append url encoded view. Encoding is stateless, so stream can be encoded chunk by chunk
+ * @param builder Builder
+ * @param view View which needs to be encoded
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_b_v_url_encode(estr_builder_t* builder, estr_view_t view);
+
+/**
+ * @brief Don't use this function. Use estr_b_cat macro instead.
+ */
+cu_err_t _estr_b_cat(estr_builder_t* builder, const char* str, ...);
+
+/**
+ * @brief Take the built string from builder. Builder is empty (and initialized again with
+ *        the same initial buffer) after this call. Result needs to be freed with builder's allocator
+ * @param builder Builder
+ * @return Pointer to built string (all len characters, null characters included) or NULL on failure (if any append failed or no memory)
+ */
+char* estr_b_finish(estr_builder_t* builder);
+
+/**
+ * @brief Release memory allocated by builder and make it empty
+ * @param builder Builder
+ * @return void
+ */
+void estr_b_free(estr_builder_t* builder);
+
+/**
+ * @brief Convert decimal digits to unsigned integer (no sign, no whitespace).
+ *        Digits are validated and converted in the same pass, 8 at a time
+ * @param view View with digits
+ * @param out Pointer to outer variable in which be stored the number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_INVALID_CHAR (not a digit);
+ *         CU_ERR_OUT_OF_BOUNDS (number does not fit)
+ */
+cu_err_t estr_to_u64(estr_view_t view, uint64_t* out);
+
+/**
+ * @brief Convert decimal digits with optional sign (+ or -) to signed integer
+ * @param view View with number
+ * @param out Pointer to outer variable in which be stored the number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_INVALID_CHAR (not a digit);
+ *         CU_ERR_OUT_OF_BOUNDS (number does not fit)
+ */
+cu_err_t estr_to_i64(estr_view_t view, int64_t* out);
+
+/**
+ * @brief Convert hex digits with optional 0x (or 0X) prefix to unsigned integer
+ * @param view View with hex digits
+ * @param out Pointer to outer variable in which be stored the number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_INVALID_CHAR (not a hex digit);
+ *         CU_ERR_OUT_OF_BOUNDS (number does not fit)
+ */
+cu_err_t estr_hex_to_u64(estr_view_t view, uint64_t* out);
+
+/**
+ * @brief Convert binary digits with optional 0b (or 0B) prefix to unsigned integer
+ * @param view View with binary digits
+ * @param out Pointer to outer variable in which be stored the number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_INVALID_CHAR (not a binary digit);
+ *         CU_ERR_OUT_OF_BOUNDS (number does not fit)
+ */
+cu_err_t estr_bin_to_u64(estr_view_t view, uint64_t* out);
+
+/**
+ * @brief Convert decimal number ([+-]digits[.digits][(e|E)[+-]digits]) to double.
+ *        Decimal point is always '.', locale is never used. Result is correctly rounded
+ * @param view View with number
+ * @param out Pointer to outer variable in which be stored the number
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_INVALID_CHAR (invalid format);
+ *         CU_ERR_OUT_OF_BOUNDS (number is too big for double)
+ */
+cu_err_t estr_to_f64(estr_view_t view, double* out);
+
+/**
+ * @brief Format unsigned integer in decimal format (two digits at a time, no locale)
+ * @param num Number
+ * @param buf Output buffer (ESTR_FMT_U64_SIZE is always enough)
+ * @param size Size of the buffer
+ * @return Length of the formatted number (without null character),
+ *         or 0 if buffer is NULL or too small (nothing is written)
+ */
+size_t estr_fmt_u64(uint64_t num, char* buf, size_t size);
+
+/**
+ * @brief Format signed integer in decimal format (see estr_fmt_u64)
+ * @param num Number
+ * @param buf Output buffer (ESTR_FMT_I64_SIZE is always enough)
+ * @param size Size of the buffer
+ * @return Length of the formatted number (without null character),
+ *         or 0 if buffer is NULL or too small (nothing is written)
+ */
+size_t estr_fmt_i64(int64_t num, char* buf, size_t size);
+
+/**
+ * @brief Format unsigned integer in lowercase hex format, without prefix and leading zeros
+ * @param num Number
+ * @param buf Output buffer (ESTR_FMT_HEX_SIZE is always enough)
+ * @param size Size of the buffer
+ * @return Length of the formatted number (without null character),
+ *         or 0 if buffer is NULL or too small (nothing is written)
+ */
+size_t estr_fmt_hex(uint64_t num, char* buf, size_t size);
+
+/**
+ * @brief Format double with the shortest digits which are parsed back to the same double, closest
+ *        to it when more of them are that short (Grisu3 with exact bignum fallback).
+ *        Decimal point is always '.', locale is never used. Format is 123.45 for absolute values
+ *        in range [1e-6, 1e21), otherwise 1.2345e+21. Special values are nan, inf and -inf
+ * @param num Number
+ * @param buf Output buffer (ESTR_FMT_F64_SIZE is always enough)
+ * @param size Size of the buffer
+ * @return Length of the formatted number (without null character),
+ *         or 0 if buffer is NULL or too small (nothing is written)
+ */
+size_t estr_fmt_f64(double num, char* buf, size_t size);
+
+/**
+ * @brief Non-cryptographic 64-bit hash (XXH64). Long inputs are processed 32 bytes at a time
+ *        in four independent lanes, inputs shorter than 32 bytes skip the lanes.
+ *        Result is the same on every platform and equals to the incremental hashing result
+ * @param ptr Bytes (can be NULL if len is zero)
+ * @param len Number of bytes
+ * @param seed Seed
+ * @return Hash
+ */
+uint64_t estr_hash64(const void* ptr, size_t len, uint64_t seed);
+
+/**
+ * @brief Start incremental hashing
+ * @param hasher Hasher
+ * @param seed Seed
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_hasher_init(estr_hasher_t* hasher, uint64_t seed);
+
+/**
+ * @brief Hash next part of the input
+ * @param hasher Hasher
+ * @param ptr Bytes (can be NULL if len is zero)
+ * @param len Number of bytes
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_hasher_update(estr_hasher_t* hasher, const void* ptr, size_t len);
+
+/**
+ * @brief Hash of everything passed to the hasher so far. Hashing can be continued afterwards
+ * @param hasher Hasher
+ * @return Hash (0 if hasher is NULL)
+ */
+uint64_t estr_hasher_digest(const estr_hasher_t* hasher);
+
+/**
+ * @brief Create new interning table
+ * @param config Table configuration (optional)
+ * @param table Table reference
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_intern_create(estr_intern_config_t* config, estr_intern_t* table);
+
+/**
+ * @brief Get canonical copy of the string, copy is made only the first time string is interned.
+ *        Interned strings are immutable and valid until the table is destroyed,
+ *        so two interned strings are equal only if the pointers are equal
+ * @param table Table
+ * @param str String
+ * @param out Pointer to outer variable in which be stored canonical string
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_intern(estr_intern_t table, const char* str, const char** out);
+
+/**
+ * @brief Get canonical copy of the view content (see estr_intern). View can contain null characters
+ * @param table Table
+ * @param view View
+ * @param out Pointer to outer variable in which be stored canonical string (null terminated)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_v_intern(estr_intern_t table, estr_view_t view, const char** out);
+
+/**
+ * @brief Find canonical copy without interning
+ * @param table Table
+ * @param view View
+ * @return Canonical string or NULL if view content was never interned
+ */
+const char* estr_intern_find(estr_intern_t table, estr_view_t view);
+
+/**
+ * @brief Memory accounting of the table
+ * @param table Table
+ * @param stats Pointer to outer variable in which be stored the stats
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_intern_stats(estr_intern_t table, estr_intern_stats_t* stats);
+
+/**
+ * @brief Free the table and all interned strings
+ * @param table Table
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_intern_destroy(estr_intern_t table);
+
+/**
+ * @brief Initialize owned string with copy of the string
+ * @param s Owned string
+ * @param str String
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_s_init(estr_t* s, const char* str);
+
+/**
+ * @brief Initialize owned string with copy of the view content
+ * @param s Owned string
+ * @param view View
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estr_s_init_view(estr_t* s, estr_view_t view);
+
+/**
+ * @brief Same as estr_s_init_view, but string which doesn't fit inline is allocated with allocator
+ *        (estra_s_free needs to be used for freeing)
+ * @param s Owned string
+ * @param view View
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t estra_s_init_view(estr_t* s, estr_view_t view, const cu_allocator_t* allocator);
+
+/**
+ * @brief Check if two owned strings are equal
+ * @param s1 First owned string
+ * @param s2 Second owned string
+ * @return true if strings are equal
+ */
+bool estr_s_eq(const estr_t* s1, const estr_t* s2);
+
+/**
+ * @brief Free the owned string. It becomes an empty string afterwards
+ * @param s Owned string
+ * @return void
+ */
+void estr_s_free(estr_t* s);
+
+/**
+ * @brief Free the owned string which was initialized with allocator
+ * @param s Owned string
+ * @param allocator Allocator which was used for initialization
+ * @return void
+ */
+void estra_s_free(estr_t* s, const cu_allocator_t* allocator);
+
+/**
+ * @brief Free the list of owned strings and the list itself
+ * @param list List
+ * @param len Number of strings in the list
+ * @return void
+ */
+void estr_s_list_free(estr_t* list, size_t len);
+
+/**
+ * @brief Free the list of owned strings and the list itself, which were allocated with allocator
+ * @param list List
+ * @param len Number of strings in the list
+ * @param allocator Allocator which was used for the list and the strings
+ * @return void
+ */
+void estra_s_list_free(estr_t* list, size_t len, const cu_allocator_t* allocator);
+
+/**
+ * @brief Force instruction set used by the character scanning functions
+ *        (estrn_chrcnt, estr_contains_ws, estr_is_empty_ws, estrn_is_digit_only, estr_contains_unescaped_chr,
+ *        url encoding and decoding, UTF-8 validation and counting, case-insensitive comparison and search,
+ *        hex and base64 encoding and decoding, and their view variants).
+ *        Best one is selected automatically on startup, so there is no need to call this function
+ * @param simd Instruction set
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_NOT_FOUND (not supported by the running CPU or platform)
+ */
+cu_err_t estr_simd_set(estr_simd_t simd);
+
+/**
+ * @brief Get instruction set used by the character scanning functions
+ * @return Instruction set (never ESTR_SIMD_AUTO)
+ */
+estr_simd_t estr_simd_get(void);
+
+/**
+ * @brief Validate string by schema (schema is compiled on every call, see estr_schema_compile)
+ * @param str String
+ * @param validation Validation schema (it's not modified)
+ * @return CU_OK if string is valid, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS;
+ *         CU_ERR_ESTR_INVALID_PREFIX;
+ *         CU_ERR_ESTR_INVALID_SUFFIX;
+ *         CU_ERR_ESTR_INVALID_WHITESPACE;
+ *         CU_ERR_ESTR_INVALID_CHAR;
+ *         CU_ERR_ESTR_INVALID_UTF8
+ */
+cu_err_t estr_validate(const char* str, const estr_validation_t* validation);
+
+/**
+ * @brief Compile validation schema. If minlen is set and maxlen is zero, maxlen is same as minlen
+ * @param validation Validation schema
+ * @param schema Pointer to outer variable in which be stored compiled schema
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG (also for malformed charset range)
+ */
+cu_err_t estr_schema_compile(const estr_validation_t* validation, estr_schema_t* schema);
+
+/**
+ * @brief Validate view by compiled schema. Characters are checked with the vectorized
+ *        kernels when schema allows everything except whitespace, or only digits
+ * @param view View
+ * @param schema Compiled schema
+ * @return CU_OK if view is valid, otherwise errors of estr_validate
+ */
+cu_err_t estr_v_validate(estr_view_t view, const estr_schema_t* schema);
+
+/**
+ * @brief Validate list of strings (ex: argv) by compiled schema
+ * @param strs List of strings
+ * @param len Number of strings in the list
+ * @param schema Compiled schema
+ * @param out_index Pointer to outer variable in which be stored index of the first invalid string (optional)
+ * @return CU_OK if all of the strings are valid, otherwise error of the first invalid string
+ *         (CU_ERR_INVALID_ARG for NULL string)
+ */
+cu_err_t estr_validate_many(char* const* strs, size_t len, const estr_schema_t* schema, size_t* out_index);
+
+/**
+ * @brief Check if bit of batch result bitmap is set
+ * @param bits Result bitmap of batch function (ex: estr_batch_eq)
+ * @param index Index of the string
+ * @return true if the string matched
+ */
+static inline bool estr_batch_bit(const uint64_t* bits, size_t index) {
+    return (bits[index / 64] >> (index % 64)) & 1;
+}
+
+/**
+ * @brief Compare every string of the list (ex: argv) with needle in one pass.
+ *        Strings are not measured, only their first characters are touched until the first one matches
+ * @param strs List of strings (NULL strings never match)
+ * @param len Number of strings in the list
+ * @param needle Compared view
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if string i is equal to needle
+ * @param out_count Number of equal strings (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_batch_eq(char* const* strs, size_t len, estr_view_t needle, uint64_t* bits, size_t* out_count);
+
+/**
+ * @brief Same as estr_batch_eq, but for list of views (lengths are compared first)
+ * @param views List of views (null views never match)
+ * @param len Number of views in the list
+ * @param needle Compared view
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if view i is equal to needle
+ * @param out_count Number of equal views (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_v_batch_eq(const estr_view_t* views, size_t len, estr_view_t needle, uint64_t* bits, size_t* out_count);
+
+/**
+ * @brief Validate every string of the list by compiled schema in one pass.
+ *        Unlike estr_validate_many, it doesn't stop on the first invalid string
+ * @param strs List of strings (NULL strings are invalid)
+ * @param len Number of strings in the list
+ * @param schema Compiled schema
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if string i is valid
+ * @param out_count Number of valid strings (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_batch_validate(char* const* strs, size_t len, const estr_schema_t* schema, uint64_t* bits, size_t* out_count);
+
+/**
+ * @brief Same as estr_batch_validate, but for list of views
+ * @param views List of views (null views are invalid)
+ * @param len Number of views in the list
+ * @param schema Compiled schema
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if view i is valid
+ * @param out_count Number of valid views (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_v_batch_validate(const estr_view_t* views, size_t len, const estr_schema_t* schema, uint64_t* bits, size_t* out_count);
+
+/**
+ * @brief Search every string of the list for compiled pattern in one pass
+ * @param strs List of strings (NULL strings never match)
+ * @param len Number of strings in the list
+ * @param pattern Compiled pattern
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if string i contains the pattern
+ * @param out_count Number of strings which contain the pattern (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
+ */
+cu_err_t estr_batch_find(char* const* strs, size_t len, const estr_pattern_t* pattern, uint64_t* bits, size_t* out_count);
+
+/**
+ * @brief Same as estr_batch_find, but for list of views
+ * @param views List of views (null views never match)
+ * @param len Number of views in the list
+ * @param pattern Compiled pattern
+ * @param bits Result bitmap of ESTR_BATCH_WORDS(len) words, bit i is set if view i contains the pattern
+ * @param out_count Number of views which contain the pattern (optional)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG
  */
-cu_err_t estr_validate(const char* str, estr_validation_t* validation);
+cu_err_t estr_v_batch_find(const estr_view_t* views, size_t len, const estr_pattern_t* pattern, uint64_t* bits, size_t* out_count);
 
 #ifdef __cplusplus
 }
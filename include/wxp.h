@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include "cutils.h"
+#include "estr.h"
 
 /**
  * @brief String expander
@@ -20,6 +21,47 @@ extern "C" {
  */
 cu_err_t wxp(const char* words, int* argc, char*** argv);
 
+/**
+ * @brief String expander which uses allocator for the words array and the words
+ * @param words String that contains words
+ * @param argc Length of words array reference
+ * @param argv Words array reference (needs to be freed with the same allocator, cu_list_freea can be used)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_SYNTAX_ERROR;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t wxpa(const char* words, int* argc, char*** argv, const cu_allocator_t* allocator);
+
+/**
+ * @brief String expander which stores words as owned strings, so short words are not separately allocated
+ * @param words String that contains words
+ * @param argc Length of words array reference
+ * @param argv Words array reference (needs to be freed with estr_s_list_free)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_SYNTAX_ERROR;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t wxp_s(const char* words, int* argc, estr_t** argv);
+
+/**
+ * @brief Same as wxp_s, but words array and heap words are allocated with allocator
+ * @param words String that contains words
+ * @param argc Length of words array reference
+ * @param argv Words array reference (needs to be freed with estra_s_list_free)
+ * @param allocator Allocator (NULL for the standard library)
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG;
+ *         CU_ERR_EMPTY_STRING;
+ *         CU_ERR_SYNTAX_ERROR;
+ *         CU_ERR_NO_MEM
+ */
+cu_err_t wxpa_s(const char* words, int* argc, estr_t** argv, const cu_allocator_t* allocator);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,6 +24,22 @@ typedef struct xnode* xnode_t;
  */
 typedef void(*xnode_free_handler_t)(void* data);
 
+#define XLIST_POOL_DEFAULT_SIZE 16
+
+/**
+ * @brief Node pool mode
+ */
+typedef enum {
+    XLIST_POOL_NONE,      /*<! Every node is allocated separately (default) */
+    XLIST_POOL_GROWABLE,  /*<! Nodes are allocated in slabs of pool_size nodes, new slab is allocated when pool is exhausted */
+    XLIST_POOL_FIXED      /*<! Exactly pool_size nodes are allocated on creation, adding fails when pool is exhausted */
+} xlist_pool_t;
+
+/**
+ * @brief Slab of pooled nodes
+ */
+typedef struct xslab* xslab_t;
+
 struct xnode {
     xnode_t prev;  /*<! Previous node */
     xnode_t next;  /*<! Next node */
@@ -33,8 +49,14 @@ struct xnode {
 struct xlist {
     xnode_t head;                            /*<! First node */
     xnode_t tail;                            /*<! Last node */
-    unsigned int len;                                /*<! List size */
+    unsigned int len;                        /*<! List size */
     xnode_free_handler_t data_free_handler;  /*<! Node data free handler */
+    cu_allocator_t allocator;                /*<! Allocator for the list and the nodes */
+    xlist_pool_t pool;                       /*<! Node pool mode */
+    unsigned int pool_size;                  /*<! Number of nodes in one slab */
+    unsigned int pool_free;                  /*<! Number of free pooled nodes */
+    xnode_t free_nodes;                      /*<! Free pooled nodes (linked by next) */
+    xslab_t slabs;                           /*<! Allocated slabs */
 };
 
 /**
@@ -42,6 +64,9 @@ struct xlist {
  */
 typedef struct {
     xnode_free_handler_t data_free_handler;   /*<! Node data free handler */
+    const cu_allocator_t* allocator;          /*<! Allocator for the list and the nodes (NULL for the standard library) */
+    xlist_pool_t pool;                        /*<! Node pool mode */
+    unsigned int pool_size;                   /*<! Nodes per slab (XLIST_POOL_DEFAULT_SIZE if zero), or capacity for fixed pool */
 } xlist_config_t;
 
 #define xlist_xeach(list, start_ptr, direction, DATADEF, CODE) \
@@ -82,6 +107,17 @@ typedef struct {
  */
 cu_err_t xlist_create(xlist_config_t* config, xlist_t* list);
 
+/**
+ * @brief Make sure that at least n nodes can be added to the pooled list
+ *        without any further allocation
+ * @param list List
+ * @param n Number of nodes
+ * @return CU_OK on success, otherwise:
+ *         CU_ERR_INVALID_ARG (list is not pooled);
+ *         CU_ERR_NO_MEM (or fixed pool is too small)
+ */
+cu_err_t xlist_reserve(xlist_t list, unsigned int n);
+
 /**
  * @brief Check current size of the list
  * @param list List
@@ -97,7 +133,7 @@ int xlist_size(xlist_t list);
  * @param node New node reference
  * @return New list size on success, otherwise:
  *         CU_ERR_INVALID_ARG;
- *         CU_ERR_NO_MEM
+ *         CU_ERR_NO_MEM (or fixed pool is exhausted)
  */
 int xlist_add_to_back(xlist_t list, void* data, xnode_t* node);
 
@@ -108,7 +144,7 @@ int xlist_add_to_back(xlist_t list, void* data, xnode_t* node);
  * @param node New node reference
  * @return New list size on success, otherwise:
  *         CU_ERR_INVALID_ARG;
- *         CU_ERR_NO_MEM
+ *         CU_ERR_NO_MEM (or fixed pool is exhausted)
  */
 int xlist_add_to_front(xlist_t list, void* data, xnode_t* node);
 
@@ -0,0 +1,240 @@
+#include "arena.h"
+#include <string.h>
+#include <stdint.h>
+
+#define _ARENA_ALIGNMENT (sizeof(void*) * 2)
+#define _arena_align(size) (((size) + _ARENA_ALIGNMENT - 1) & ~(_ARENA_ALIGNMENT - 1))
+
+struct cu_arena_block {
+    struct cu_arena_block* next;  /*<! Next block */
+    size_t size;                  /*<! Usable size of the block */
+    size_t used;                  /*<! Number of used bytes */
+    size_t last;                  /*<! Offset of the last allocation */
+};
+
+typedef struct cu_arena_block* cu_arena_block_t;
+
+struct cu_arena {
+    cu_arena_block_t head;      /*<! First block */
+    cu_arena_block_t current;   /*<! Block from which allocations are made */
+    size_t block_size;          /*<! Minimal block size */
+    cu_allocator_t allocator;   /*<! Allocator for the arena and the blocks */
+};
+
+#define _block_data(block) ((uint8_t*) (block) + _arena_align(sizeof(struct cu_arena_block)))
+
+cu_err_t cu_arena_create(cu_arena_config_t* config, cu_arena_t* arena) {
+    if(! arena) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    const cu_allocator_t* allocator = config ? config->allocator : NULL;
+    cu_arena_t _arena = NULL;
+    cu_mem_checkr(_arena = cu_tctora(allocator, cu_arena_t, struct cu_arena,
+        .block_size = config && config->block_size > 0 ? config->block_size : CU_ARENA_DEFAULT_BLOCK_SIZE
+    ));
+
+    if(allocator) {
+        _arena->allocator = *allocator;
+    }
+
+    *arena = _arena;
+    return CU_OK;
+}
+
+static cu_arena_block_t _block_create(cu_arena_t arena, size_t size) {
+    size = _arena_align(size > arena->block_size ? size : arena->block_size);
+
+    if(size > SIZE_MAX - _arena_align(sizeof(struct cu_arena_block))) {
+        return NULL;
+    }
+
+    cu_arena_block_t block = cu_alloc(&arena->allocator, _arena_align(sizeof(struct cu_arena_block)) + size);
+
+    if(block) {
+        *block = (struct cu_arena_block) { .size = size };
+    }
+
+    return block;
+}
+
+void* cu_arena_alloc(cu_arena_t arena, size_t size) {
+    if(! arena) {
+        return NULL;
+    }
+
+    size_t _size = _arena_align(size > 0 ? size : 1);
+
+    if(_size < size) { // overflow
+        return NULL;
+    }
+
+    cu_arena_block_t block = arena->current;
+
+    // skip blocks (kept from before the reset) which are too small
+    while(block && block->size - block->used < _size) {
+        block = block->next;
+    }
+
+    if(! block) {
+        if(! (block = _block_create(arena, _size))) {
+            return NULL;
+        }
+
+        if(arena->current) {
+            cu_arena_block_t tail = arena->current;
+            while(tail->next) { tail = tail->next; }
+            tail->next = block;
+        } else {
+            arena->head = block;
+        }
+    }
+
+    arena->current = block;
+    block->last = block->used;
+    block->used += _size;
+
+    return _block_data(block) + block->last;
+}
+
+/**
+ * @brief Find block which contains ptr
+ */
+static cu_arena_block_t _block_of(cu_arena_t arena, void* ptr) {
+    for(cu_arena_block_t block = arena->head; block; block = block->next) {
+        if((uint8_t*) ptr >= _block_data(block) && (uint8_t*) ptr < _block_data(block) + block->size) {
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+void* cu_arena_realloc(cu_arena_t arena, void* ptr, size_t size) {
+    if(! arena) {
+        return NULL;
+    }
+
+    if(! ptr) {
+        return cu_arena_alloc(arena, size);
+    }
+
+    cu_arena_block_t block = arena->current;
+
+    if(block && (uint8_t*) ptr == _block_data(block) + block->last) {
+        size_t _size = _arena_align(size > 0 ? size : 1);
+
+        if(_size >= size && block->size - block->last >= _size) { // grow or shrink in place
+            block->used = block->last + _size;
+            return ptr;
+        }
+    }
+
+    if(! (block = _block_of(arena, ptr))) {
+        return NULL;
+    }
+
+    // old size is unknown, so copy everything up to the end of the used region (or new size)
+    size_t available = block->used - ((uint8_t*) ptr - _block_data(block));
+    void* _ptr = cu_arena_alloc(arena, size);
+
+    if(_ptr) {
+        memcpy(_ptr, ptr, available < size ? available : size);
+    }
+
+    return _ptr;
+}
+
+void cu_arena_free(cu_arena_t arena, void* ptr) {
+    if(! arena || ! ptr || ! arena->current) {
+        return;
+    }
+
+    cu_arena_block_t block = arena->current;
+
+    if((uint8_t*) ptr == _block_data(block) + block->last) {
+        block->used = block->last;
+    }
+}
+
+cu_err_t cu_arena_reset(cu_arena_t arena) {
+    if(! arena) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    for(cu_arena_block_t block = arena->head; block; block = block->next) {
+        block->used = block->last = 0;
+    }
+
+    arena->current = arena->head;
+    return CU_OK;
+}
+
+size_t cu_arena_used(cu_arena_t arena) {
+    size_t used = 0;
+
+    if(arena) {
+        for(cu_arena_block_t block = arena->head; block; block = block->next) {
+            used += block->used;
+        }
+    }
+
+    return used;
+}
+
+size_t cu_arena_capacity(cu_arena_t arena) {
+    size_t capacity = 0;
+
+    if(arena) {
+        for(cu_arena_block_t block = arena->head; block; block = block->next) {
+            capacity += block->size;
+        }
+    }
+
+    return capacity;
+}
+
+static void* _allocator_alloc(void* ctx, size_t size) {
+    return cu_arena_alloc((cu_arena_t) ctx, size);
+}
+
+static void* _allocator_realloc(void* ctx, void* ptr, size_t size) {
+    return cu_arena_realloc((cu_arena_t) ctx, ptr, size);
+}
+
+static void _allocator_free(void* ctx, void* ptr) {
+    cu_arena_free((cu_arena_t) ctx, ptr);
+}
+
+cu_err_t cu_arena_allocator(cu_arena_t arena, cu_allocator_t* allocator) {
+    if(! arena || ! allocator) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    *allocator = (cu_allocator_t) {
+        .alloc = &_allocator_alloc,
+        .realloc = &_allocator_realloc,
+        .free = &_allocator_free,
+        .ctx = arena
+    };
+
+    return CU_OK;
+}
+
+cu_err_t cu_arena_destroy(cu_arena_t arena) {
+    if(! arena) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_allocator_t allocator = arena->allocator;
+    cu_arena_block_t block = arena->head;
+
+    while(block) {
+        cu_arena_block_t next = block->next;
+        cu_free(&allocator, block);
+        block = next;
+    }
+
+    cu_free(&allocator, arena);
+    return CU_OK;
+}
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "wxp.h"
 #include <getopt.h>
 #include <assert.h>
+#include <stdint.h>
+
+#define CMDER_CMDS_POOL_SIZE 8
+#define CMDER_OPTS_POOL_SIZE 4
 
 struct cmder_cmd_handle {
 	char* name;
@@ -19,6 +23,10 @@ struct cmder_handle {
     void* context;
     size_t cmdline_max_len;
     xlist_t cmds;
+    cu_allocator_t allocator;
+    estr_intern_t intern;
+    bool case_insensitive;
+    estr_schema_t cmd_name_schema;  /*<! Compiled once, every added command name is validated with it */
 };
 
 typedef enum {
@@ -36,91 +44,116 @@ typedef struct {
     uint16_t margs_len;         /*<! Mandatory args length */
 } cmder_gopts_t;
 
-static void _opt_free(cmder_opt_handle_t opt) {
+/**
+ * @brief Copy of the string, or canonical string from the interning table (if given)
+ */
+static char* _str_dup(estr_intern_t intern, const cu_allocator_t* allocator, const char* str) {
+    if(intern) {
+        const char* interned = NULL;
+        estr_intern(intern, str, &interned);
+        return (char*) interned;
+    }
+
+    return cu_strdup(allocator, str);
+}
+
+static void _str_free(estr_intern_t intern, const cu_allocator_t* allocator, char* str) {
+    if(!intern) { // interned strings are owned by the table
+        cu_free(allocator, str);
+    }
+}
+
+static void _opt_free(cmder_opt_handle_t opt, cmder_handle_t cmder) {
     if(!opt)
         return;
 
-    free(opt->description);
-    free(opt);
+    _str_free(cmder->intern, &cmder->allocator, opt->description);
+    cu_free(&cmder->allocator, opt);
 }
 
 static void _cmd_free(cmder_cmd_handle_t cmd) {
     if(!cmd)
         return;
 
-    cmd->cmder = NULL;
+    const cu_allocator_t* allocator = &cmd->cmder->allocator;
+
+    xlist_each(cmder_opt_handle_t, cmd->opts, {
+        _opt_free(xdata, cmd->cmder);
+    });
+
     cmd->callback = NULL;
-    free(cmd->name);
+    _str_free(cmd->cmder->intern, allocator, cmd->name);
     cmd->name = NULL;
-    free(cmd->getoopts);
+    cu_free(allocator, cmd->getoopts);
     cmd->getoopts = NULL;
     xlist_destroy(cmd->opts);
     cmd->opts = NULL;
-    free(cmd);
+    cmd->cmder = NULL;
+    cu_free(allocator, cmd);
 }
 
-static void _optval_free(cmder_optval_t* optval) {
+static void _optval_free(cmder_optval_t* optval, const cu_allocator_t* allocator) {
     if(!optval)
         return;
     
     optval->opt = NULL;
     optval->state = false;
     optval->val = NULL; // don't free, it's a reference to argv item
-    free(optval);
+    cu_free(allocator, optval);
+}
+
+static void _optvals_destroy(xlist_t optvals, const cu_allocator_t* allocator) {
+    xlist_each(cmder_optval_t*, optvals, {
+        _optval_free(xdata, allocator);
+    });
+
+    xlist_destroy(optvals);
 }
 
-static void _cmdval_free(cmder_cmdval_t* cmdval) {
+static void _cmdval_free(cmder_cmdval_t* cmdval, const cu_allocator_t* allocator) {
     if(!cmdval)
         return;
     
     cmdval->cmder = NULL;
     cmdval->context = NULL;
-    xlist_destroy(cmdval->optvals);
+    _optvals_destroy(cmdval->optvals, allocator);
     cmdval->optvals = NULL;
     xlist_destroy(cmdval->extra_args);
     cmdval->extra_args = NULL;
-    free(cmdval);
+    cu_free(allocator, cmdval);
 }
 
-static void _free_gopts(cmder_gopts_t* gopts) {
+static void _free_gopts(cmder_gopts_t* gopts, const cu_allocator_t* allocator) {
     if(!gopts) {
         return;
     }
 
     // don't free individual opts
-    free(gopts->flags);
+    cu_free(allocator, gopts->flags);
     gopts->flags = NULL;
     gopts->flags_len = 0;
-    free(gopts->oargs);
+    cu_free(allocator, gopts->oargs);
     gopts->oargs = NULL;
     gopts->oargs_len = 0;
-    free(gopts->margs);
+    cu_free(allocator, gopts->margs);
     gopts->margs = NULL;
     gopts->margs_len = 0;
-    free(gopts);
+    cu_free(allocator, gopts);
 }
 
-static cu_err_t _validate_name(const char* name, unsigned int maxlen) {
-    return estr_validate(name, &(estr_validation_t) {
+static cu_err_t _name_schema(unsigned int maxlen, estr_schema_t* schema) {
+    return estr_schema_compile(&(estr_validation_t) {
         .length = true,
         .minlen = 1,
         .maxlen = maxlen,
         .no_whitespace = true
-    });
+    }, schema);
 }
 
 static void _xlist_cmd_free(void* data) {
     _cmd_free((cmder_cmd_handle_t) data);
 }
 
-static void _xlist_opt_free(void* data) {
-    _opt_free((cmder_opt_handle_t) data);
-}
-
-static void _xlist_optval_free(void* data) {
-    _optval_free((cmder_optval_t*) data);
-}
-
 cu_err_t cmder_create(cmder_t* config, cmder_handle_t* out_handle) {
     if(!config || !out_handle)
         return CU_ERR_INVALID_ARG;
@@ -128,31 +161,45 @@ cu_err_t cmder_create(cmder_t* config, cmder_handle_t* out_handle) {
     cu_err_t err = CU_OK;
     cmder_handle_t cmder = NULL;
     char* _name = NULL;
+    const cu_allocator_t* allocator = config->allocator;
+    estr_schema_t name_schema, cmd_name_schema;
+
+    cu_err_checkr(_name_schema(CMDER_NAME_MAX_LENGTH, &name_schema));
+    cu_err_checkr(_name_schema(CMDER_CMD_NAME_MAX_LENGTH, &cmd_name_schema));
 
     bool validate_name = config->name_as_cmdline_prefix || config->name;
 
-    if(validate_name && (err = _validate_name(config->name, CMDER_NAME_MAX_LENGTH)) != CU_OK) {
+    if(validate_name && (err = estr_v_validate(estr_view(config->name), &name_schema)) != CU_OK) {
         return err;
     }
 
     if(config->name) {
-        cu_mem_check(_name = strdup(config->name));
+        cu_mem_check(_name = _str_dup(config->intern, allocator, config->name));
     }
     
-    cu_mem_check(cmder = cu_tctor(cmder_handle_t, struct cmder_handle,
+    cu_mem_check(cmder = cu_tctora(allocator, cmder_handle_t, struct cmder_handle,
         .name = _name,
         .name_as_cmdline_prefix = config->name_as_cmdline_prefix,
         .context = config->context,
-        .cmdline_max_len = config->cmdline_max_len > 0 ? config->cmdline_max_len : CMDER_DEFAULT_CMDLINE_MAX_LEN
+        .cmdline_max_len = config->cmdline_max_len > 0 ? config->cmdline_max_len : CMDER_DEFAULT_CMDLINE_MAX_LEN,
+        .allocator = allocator ? *allocator : (cu_allocator_t){ 0 },
+        .intern = config->intern,
+        .case_insensitive = config->case_insensitive,
+        .cmd_name_schema = cmd_name_schema
     ));
 
     _name = NULL;
 
-    cu_err_check(xlist_create(&(xlist_config_t){ .data_free_handler = &_xlist_cmd_free }, &cmder->cmds));
+    cu_err_check(xlist_create(&(xlist_config_t){
+        .data_free_handler = &_xlist_cmd_free,
+        .allocator = &cmder->allocator,
+        .pool = XLIST_POOL_GROWABLE,
+        .pool_size = CMDER_CMDS_POOL_SIZE
+    }, &cmder->cmds));
 
     goto _return;
 _error:
-    free(_name);
+    _str_free(config->intern, allocator, _name);
     cmder_destroy(cmder);
     cmder = NULL;
 _return:
@@ -176,7 +223,7 @@ cu_err_t cmder_getoopts(cmder_cmd_handle_t cmd, char** out_getoopts) {
     });
 
     char* getoopts = NULL;
-    cu_mem_checkr(getoopts = malloc(len + 1));
+    cu_mem_checkr(getoopts = cu_alloc(&cmd->cmder->allocator, len + 1));
 
     getoopts[0] = ':';
     char* ptr = getoopts + 1;
@@ -219,7 +266,7 @@ static cu_err_t _getoopts_recalc(cmder_cmd_handle_t cmd) {
     cu_err_t err = CU_OK;
     char* getoopts = NULL;
     cu_err_checkr(cmder_getoopts(cmd, &getoopts));
-    free(cmd->getoopts); // free old
+    cu_free(&cmd->cmder->allocator, cmd->getoopts); // free old
     cmd->getoopts = getoopts;
 
     return err;
@@ -234,8 +281,15 @@ cu_err_t cmder_get_cmd_by_name(cmder_handle_t cmder, const char* cmd_name, cmder
         return CU_ERR_EMPTY_STRING;
     }
 
+    bool by_ptr = cmder->intern && !cmder->case_insensitive; // other cases of the name are not interned
+
+    if(by_ptr && !(cmd_name = estr_intern_find(cmder->intern, estr_view(cmd_name)))) { // never interned
+        return CU_ERR_NOT_FOUND;
+    }
+
     xlist_each(cmder_cmd_handle_t, cmder->cmds, {
-        if(estr_eq(cmd_name, xdata->name)) {
+        if(by_ptr ? cmd_name == xdata->name
+                  : cmder->case_insensitive ? estr_ieq(cmd_name, xdata->name) : estr_eq(cmd_name, xdata->name)) {
             if(out_cmd_handle) {
                 *out_cmd_handle = xdata;
             }
@@ -254,17 +308,18 @@ cu_err_t cmder_add_cmd(cmder_handle_t cmder, cmder_cmd_t* cmd, cmder_cmd_handle_
     cu_err_t err = CU_OK;
     cmder_cmd_handle_t _cmd = NULL;
     char* _name = NULL;
+    const cu_allocator_t* allocator = &cmder->allocator;
 
-    if((err = _validate_name(cmd->name, CMDER_CMD_NAME_MAX_LENGTH)) != CU_OK) {
+    if((err = estr_v_validate(estr_view(cmd->name), &cmder->cmd_name_schema)) != CU_OK) {
         return err;
     }
     
     if(cmder_get_cmd_by_name(cmder, cmd->name, NULL) == CU_OK) // already exist
         return CU_ERR_CMDER_CMD_EXIST;
     
-    cu_mem_check(_name = strdup(cmd->name));
+    cu_mem_check(_name = _str_dup(cmder->intern, allocator, cmd->name));
 
-    cu_mem_check(_cmd = cu_tctor(cmder_cmd_handle_t, struct cmder_cmd_handle,
+    cu_mem_check(_cmd = cu_tctora(allocator, cmder_cmd_handle_t, struct cmder_cmd_handle,
         .cmder = cmder,
         .name = _name,
         .callback = cmd->callback
@@ -272,12 +327,16 @@ cu_err_t cmder_add_cmd(cmder_handle_t cmder, cmder_cmd_t* cmd, cmder_cmd_handle_
 
     _name = NULL;
 
-    cu_err_check(xlist_create(&(xlist_config_t){ .data_free_handler = &_xlist_opt_free }, &_cmd->opts));
+    cu_err_check(xlist_create(&(xlist_config_t){
+        .allocator = allocator,
+        .pool = XLIST_POOL_GROWABLE,
+        .pool_size = CMDER_OPTS_POOL_SIZE
+    }, &_cmd->opts));
     cu_err_negative_check(xlist_vadd(cmder->cmds, _cmd));
 
     goto _return;
 _error:
-    free(_name);
+    _str_free(cmder->intern, allocator, _name);
     _cmd_free(_cmd);
     _cmd = NULL;
 _return:
@@ -311,6 +370,7 @@ cu_err_t cmder_add_opt(cmder_cmd_handle_t cmd, cmder_opt_t* opt, cmder_opt_handl
     cu_err_t err = CU_OK;
     cmder_opt_handle_t _opt = NULL;
     char* _desc = NULL;
+    const cu_allocator_t* allocator = &cmd->cmder->allocator;
 
     if(!estr_is_alnum(opt->name)) {
         return CU_ERR_CMDER_INVALID_OPT_NAME;
@@ -320,10 +380,10 @@ cu_err_t cmder_add_opt(cmder_cmd_handle_t cmd, cmder_opt_t* opt, cmder_opt_handl
         return CU_ERR_CMDER_OPT_EXIST;
     
     if(opt->description) {
-        cu_mem_check(_desc = strdup(opt->description));
+        cu_mem_check(_desc = _str_dup(cmd->cmder->intern, allocator, opt->description));
     }
 
-    cu_mem_check(_opt = cu_tctor(cmder_opt_handle_t, cmder_opt_t,
+    cu_mem_check(_opt = cu_tctora(allocator, cmder_opt_handle_t, cmder_opt_t,
         .name = opt->name,
         .is_arg = opt->is_arg,
         .is_optional = opt->is_optional,
@@ -337,8 +397,9 @@ cu_err_t cmder_add_opt(cmder_cmd_handle_t cmd, cmder_opt_t* opt, cmder_opt_handl
 
     goto _return;
 _error:
-    free(_desc);
-    _opt_free(_opt);
+    if(_opt) { xlist_remove_data(cmd->opts, _opt); }
+    _str_free(cmd->cmder->intern, allocator, _desc);
+    _opt_free(_opt, cmd->cmder);
     _opt = NULL;
 _return:
     if(out_opt) { *out_opt = _opt; }
@@ -391,7 +452,7 @@ static cu_err_t _cmd_options(cmder_cmd_handle_t cmd, cmder_opt_type_t type, cmde
     }
 
     cmder_opt_handle_t* opts = NULL;
-    cu_mem_checkr(opts = malloc(len * sizeof(cmder_opt_handle_t)));
+    cu_mem_checkr(opts = cu_alloc(&cmd->cmder->allocator, len * sizeof(cmder_opt_handle_t)));
 
     uint16_t j = 0;
     xlist_each(cmder_opt_handle_t, cmd->opts, {
@@ -422,7 +483,7 @@ static cu_err_t _cmd_gopts(cmder_cmd_handle_t cmd, cmder_gopts_t** out_gopts, bo
 
     cu_err_t err = CU_OK;
     cmder_gopts_t* gopts = NULL;
-    cu_mem_check(gopts = cu_ctor(cmder_gopts_t));
+    cu_mem_check(gopts = cu_ctora(&cmd->cmder->allocator, cmder_gopts_t));
 
     cu_err_check(_cmd_options(cmd, CMDER_OPT_FLAG, just_lengths ? NULL : &gopts->flags, &gopts->flags_len));
     cu_err_check(_cmd_options(cmd, CMDER_OPT_OPTIONAL_ARG, just_lengths ? NULL : &gopts->oargs, &gopts->oargs_len));
@@ -430,7 +491,7 @@ static cu_err_t _cmd_gopts(cmder_cmd_handle_t cmd, cmder_gopts_t** out_gopts, bo
     
     goto _return;
 _error:
-    _free_gopts(gopts);
+    _free_gopts(gopts, &cmd->cmder->allocator);
     gopts = NULL;
 _return:
     *out_gopts = gopts;
@@ -486,11 +547,11 @@ static cu_err_t _calc_signature_len(cmder_cmd_handle_t cmd, unsigned int* out_le
 
     goto _return;
 _error:
-    _free_gopts(gopts);
+    _free_gopts(gopts, &cmd->cmder->allocator);
     gopts = NULL;
 _return:
     *out_len = len;
-    if(o_gopts)     { *o_gopts = gopts; } else { _free_gopts(gopts); }
+    if(o_gopts)     { *o_gopts = gopts; } else { _free_gopts(gopts, &cmd->cmder->allocator); }
     return err;
 }
 
@@ -514,7 +575,7 @@ static cu_err_t _create_signature(cmder_cmd_handle_t cmd, char** out_signature,
 
     // if outside pointer is not null, that's consider like buffer has been provided
     // and that buffer will be used instead of allocating new memory
-    cu_mem_check(signature = *out_signature ? *out_signature : malloc(len + 1));
+    cu_mem_check(signature = *out_signature ? *out_signature : cu_alloc(&cmd->cmder->allocator, len + 1));
     ptr = signature;
 
     unsigned int name_len = strlen(cmd->name);
@@ -558,7 +619,7 @@ static cu_err_t _create_signature(cmder_cmd_handle_t cmd, char** out_signature,
 
     goto _return;
 _error:
-    free(signature);
+    if(signature != *out_signature) { cu_free(&cmd->cmder->allocator, signature); }
     signature = NULL;
     len = 0;
 _return:
@@ -582,11 +643,11 @@ cu_err_t cmder_cmd_signature(cmder_cmd_handle_t cmd, char** out_signature, unsig
 
     goto _return;
 _error:
-    free(signature);
+    cu_free(&cmd->cmder->allocator, signature);
     signature = NULL;
     len = 0;
 _return:
-    _free_gopts(gopts);
+    _free_gopts(gopts, &cmd->cmder->allocator);
     if(out_len) { *out_len = len; }
     *out_signature = signature;
     return err;
@@ -649,12 +710,12 @@ static cu_err_t _calc_manual_len(cmder_cmd_handle_t cmd, unsigned int* out_len,
 
     goto _return;
 _error:
-    _free_gopts(gopts);
+    _free_gopts(gopts, &cmd->cmder->allocator);
     len = 0;
 _return:
     if(out_len) { *out_len = len; }
     if(out_sig_len) { *out_sig_len = sig_len; }
-    if(o_gopts) { *o_gopts = gopts; } else { _free_gopts(gopts); }
+    if(o_gopts) { *o_gopts = gopts; } else { _free_gopts(gopts, &cmd->cmder->allocator); }
     return err;
 }
 
@@ -667,7 +728,7 @@ static cu_err_t _create_manual(cmder_cmd_handle_t cmd, char** out_manual, size_t
     char* manual = NULL;
     char* ptr = NULL;
 
-    cu_mem_check(manual = malloc(len + 1)); // +1 for "\0"
+    cu_mem_check(manual = cu_alloc(&cmd->cmder->allocator, len + 1)); // +1 for "\0"
 
     ptr = manual;
     memcpy(ptr, "Usage: ", 7);
@@ -738,7 +799,7 @@ static cu_err_t _create_manual(cmder_cmd_handle_t cmd, char** out_manual, size_t
 
     goto _return;
 _error:
-    free(manual);
+    cu_free(&cmd->cmder->allocator, manual);
     manual = NULL;
     len = 0;
 _return:
@@ -761,11 +822,11 @@ cu_err_t cmder_cmd_manual(cmder_cmd_handle_t cmd, char** out_manual, unsigned in
     
     goto _return;
 _error:
-    free(manual);
+    cu_free(&cmd->cmder->allocator, manual);
     manual = NULL;
     len = 0;
 _return:
-    _free_gopts(gopts);
+    _free_gopts(gopts, &cmd->cmder->allocator);
     if(out_len) { *out_len = len; }
     *out_manual = manual;
     return err;
@@ -821,7 +882,7 @@ cu_err_t cmder_cmdval_errstr(cmder_cmdval_t* cmdval, char** out_errstr, unsigned
 
     len += 14; // " option -- 'x'"
 
-    cu_mem_check(errorstr = malloc(len + 1));
+    cu_mem_check(errorstr = cu_alloc(&cmdval->cmder->allocator, len + 1));
 
     char* ptr = errorstr;
     memcpy(ptr, cmdval->cmd->name, cmdname_len);
@@ -857,7 +918,7 @@ cu_err_t cmder_cmdval_errstr(cmder_cmdval_t* cmdval, char** out_errstr, unsigned
 
     goto _return;
 _error:
-    free(errorstr);
+    cu_free(&cmdval->cmder->allocator, errorstr);
     errorstr = NULL;
     len = 0;
 _return:
@@ -889,7 +950,9 @@ static cu_err_t _argv_is_in_good_condition(int argc, char** argv, bool* conditio
     *condition = true;
 
     for(int i = 0; i < argc; i++) {
-        if(!estr_is_trimmed(argv[i]) || estr_contains_unescaped_chr(argv[i], '\"')) {
+        estr_view_t arg = estr_view(argv[i]);
+
+        if(!estr_v_is_trimmed(arg) || estr_v_contains_unescaped_chr(arg, '\"')) {
             *condition = false;
             return CU_ERR_SYNTAX_ERROR;
         }
@@ -898,7 +961,7 @@ static cu_err_t _argv_is_in_good_condition(int argc, char** argv, bool* conditio
     return CU_OK;
 }
 
-static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, const void* run_context, bool safe) {
+static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, const void* run_context, bool safe, const cu_allocator_t* allocator) {
     if(!cmder) {
         return CU_ERR_INVALID_ARG;
     }
@@ -922,7 +985,7 @@ static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, con
     
     cmder_cmdval_t* cmdval = NULL;
 
-    cu_mem_check(cmdval = cu_ctor(cmder_cmdval_t,
+    cu_mem_checkr(cmdval = cu_ctora(allocator, cmder_cmdval_t,
         .cmder = cmder,
         .cmd = cmd,
         .context = cmder->context,
@@ -934,13 +997,24 @@ static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, con
         // making one optval in cmdval for every opt in cmd
 
         cu_err_check(xlist_create(&(xlist_config_t){
-            .data_free_handler = &_xlist_optval_free
+            .allocator = allocator,
+            .pool = XLIST_POOL_FIXED,
+            .pool_size = xlist_size(cmd->opts)
         }, &cmdval->optvals));
 
+        cmder_optval_t* _optval = NULL;
+
         xlist_each(cmder_opt_handle_t, cmd->opts, {
-            cu_err_negative_check(xlist_vadd(cmdval->optvals, cu_ctor(cmder_optval_t,
+            cu_mem_check(_optval = cu_ctora(allocator, cmder_optval_t,
                 .opt = xdata
-            )));
+            ));
+
+            if((err = xlist_vadd(cmdval->optvals, _optval)) < 0) {
+                _optval_free(_optval, allocator);
+                goto _error;
+            }
+
+            err = CU_OK;
         });
     }
 
@@ -985,7 +1059,11 @@ static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, con
     }
     
     if(argc - optind > 0) {
-        cu_err_check(xlist_create(NULL, &cmdval->extra_args));
+        cu_err_check(xlist_create(&(xlist_config_t){
+            .allocator = allocator,
+            .pool = XLIST_POOL_FIXED,
+            .pool_size = argc - optind
+        }, &cmdval->extra_args));
 
         for(int i = optind; i < argc; i++) {
             cu_err_negative_check(xlist_vadd(cmdval->extra_args, argv[i]));
@@ -995,68 +1073,107 @@ static cu_err_t _cmder_run_args(cmder_handle_t cmder, int argc, char** argv, con
     cmd->callback(cmdval);
     goto _return;
 _error:
-    xlist_destroy(cmdval->optvals);
+    _optvals_destroy(cmdval->optvals, allocator);
     cmdval->optvals = NULL;
     xlist_destroy(cmdval->extra_args);
     cmdval->extra_args = NULL;
     cmd->callback(cmdval);
 _return:
-    _cmdval_free(cmdval);
+    _cmdval_free(cmdval, allocator);
     return err;
 }
 
 cu_err_t cmder_run_args(cmder_handle_t cmder, int argc, char** argv, const void* run_context) {
-    return _cmder_run_args(cmder, argc, argv, run_context, true);
+    return _cmder_run_args(cmder, argc, argv, run_context, true, cmder ? &cmder->allocator : NULL);
 }
 
 cu_err_t cmder_vrun_args(cmder_handle_t cmder, int argc, char** argv) {
     return cmder_run_args(cmder, argc, argv, NULL);
 }
 
-cu_err_t cmder_run(cmder_handle_t cmder, const char* cmdline, const void* run_context) {
+/**
+ * @brief Parse cmdline and run the command. Every per-invocation allocation
+ *        (argv, cmdval, optvals, extra args) is made with the allocator
+ */
+static cu_err_t _cmder_run(cmder_handle_t cmder, const char* cmdline, const void* run_context, const cu_allocator_t* allocator) {
     if(!cmder || !cmdline)
         return CU_ERR_INVALID_ARG;
 
-    size_t cmdline_len = strlen(cmdline);
+    // no need to scan further than the limit
+    estr_view_t line = estrn_view(cmdline,
+        cmder->cmdline_max_len < SIZE_MAX ? cmder->cmdline_max_len + 1 : SIZE_MAX);
 
-    if(cmdline_len <= 0) {
+    if(line.len <= 0) {
         return CU_ERR_EMPTY_STRING;
     }
 
     if(xlist_is_empty(cmder->cmds)) // no registered cmds
         return CU_ERR_CMDER_NO_CMDS;
 
-    if(cmdline_len > cmder->cmdline_max_len)
+    if(line.len > cmder->cmdline_max_len)
         return CU_ERR_CMDER_CMDLINE_TOO_BIG;
-    
-    size_t cmder_name_len = strlen(cmder->name);
 
-    if(cmder->name_as_cmdline_prefix && !estrn_eq(cmdline, cmder->name, cmder_name_len)) // not for us
-        return CU_ERR_CMDER_IGNORE;
+    const char* words = cmdline;
+
+    if(cmder->name_as_cmdline_prefix) {
+        estr_view_t name = estr_view(cmder->name);
+
+        if(!(cmder->case_insensitive ? estr_v_isw(line, name) : estr_v_sw(line, name))) // not for us
+            return CU_ERR_CMDER_IGNORE;
+
+        words += line.len > name.len ? name.len + 1 : name.len;
+    }
 
     int argc;
     char** argv = NULL;
 
-    cu_err_t err = cmder_args(
-        cmder->name_as_cmdline_prefix ? cmdline + cmder_name_len + 1 : cmdline,
-        &argc,
-        &argv
-    );
+    cu_err_t err = wxpa(words, &argc, &argv, allocator);
 
     if(err != CU_OK) {
         return err;
     }
 
-    err = _cmder_run_args(cmder, argc, argv, run_context, false); // not-safe call (cmder_args is safe)
-    cu_list_free(argv, argc);
+    err = _cmder_run_args(cmder, argc, argv, run_context, false, allocator); // not-safe call (cmder_args is safe)
+    cu_list_freea(argv, argc, allocator);
 
     return err;
 }
 
+cu_err_t cmder_run(cmder_handle_t cmder, const char* cmdline, const void* run_context) {
+    return _cmder_run(cmder, cmdline, run_context, cmder ? &cmder->allocator : NULL);
+}
+
+cu_err_t cmder_run_arena(cmder_handle_t cmder, cu_arena_t arena, const char* cmdline, const void* run_context) {
+    if(!cmder || !arena || !cmdline)
+        return CU_ERR_INVALID_ARG;
+
+    cu_allocator_t allocator;
+    cu_err_t err;
+    cu_err_checkr(cu_arena_allocator(arena, &allocator));
+
+    err = _cmder_run(cmder, cmdline, run_context, &allocator);
+    cu_arena_reset(arena);
+
+    return err;
+}
+
+cu_err_t cmder_vrun_arena(cmder_handle_t cmder, cu_arena_t arena, const char* cmdline) {
+    return cmder_run_arena(cmder, arena, cmdline, NULL);
+}
+
 cu_err_t cmder_vrun(cmder_handle_t cmder, const char* cmdline) {
     return cmder_run(cmder, cmdline, NULL);
 }
 
+cu_err_t cmder_free(cmder_handle_t cmder, void* ptr) {
+    if(!cmder) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_free(&cmder->allocator, ptr);
+    return CU_OK;
+}
+
 cu_err_t cmder_destroy(cmder_handle_t cmder) {
     if(!cmder) {
         return CU_ERR_INVALID_ARG;
@@ -1064,10 +1181,11 @@ cu_err_t cmder_destroy(cmder_handle_t cmder) {
 
     xlist_destroy(cmder->cmds);
     cmder->cmds = NULL;
-    free(cmder->name);
+    cu_allocator_t allocator = cmder->allocator;
+    _str_free(cmder->intern, &allocator, cmder->name);
     cmder->name = NULL;
     cmder->context = NULL;
-    free(cmder);
+    cu_free(&allocator, cmder);
 
     return CU_OK;
 }
\ No newline at end of file
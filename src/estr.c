@@ -1,8 +1,11 @@
 #include "estr.h"
+#include "estr_scan.h"
 #include "cutils.h"
 #include <string.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <math.h>
 
 #ifdef _WIN32
 char* strndup(const char* string, size_t len) {
@@ -51,139 +54,271 @@ bool estr_sw_chr(const char* str, char chr) {
 }
 
 bool estr_ew(const char* str1, const char* str2) {
-	if(!str1 || !str2)
-		return false;
-	
-	size_t len1 = strlen(str1);
+    return estr_v_ew(estr_view(str1), estr_view(str2));
+}
 
-	if(len1 == 0)
-		return false;
+bool estr_ew_chr(const char* str, char chr) {
+    return estr_v_ew_chr(estr_view(str), chr);
+}
 
-    size_t len2 = strlen(str2);
-    
-	if(len2 > len1 || len2 == 0) // str2 is bigger or empty
-		return false;
-	
-    size_t diff = len1 - len2;
+bool estr_ieq(const char* str1, const char* str2) {
+    return estr_v_ieq(estr_view(str1), estr_view(str2));
+}
+
+bool estrn_ieq(const char* str1, const char* str2, size_t n) {
+    return estr_v_ieq(estrn_view(str1, n), estrn_view(str2, n));
+}
 
-    if(diff == 0) {
-        return estr_eq(str1, str2);
+bool estr_isw(const char* str1, const char* str2) {
+    if(!str1 || !str2) {
+        return false;
     }
-    
-	for(size_t i = len2, j = len1; i > 0; i--, j--) {
-        if(str2[i - 1] != str1[j - 1]) {
-            return false;
+
+    estr_view_t prefix = estr_view(str2);
+    return estr_v_isw(estrn_view(str1, prefix.len), prefix); // str1 is not scanned past the prefix length
+}
+
+bool estr_iew(const char* str1, const char* str2) {
+    return estr_v_iew(estr_view(str1), estr_view(str2));
+}
+
+bool estrn_is_digit_only(const char* str, size_t n) {
+    return estr_v_is_digit_only(estrn_view(str, n));
+}
+
+size_t estrn_chrcnt(const char* str, char chr, size_t n) {
+    return estr_v_chrcnt(estrn_view(str, n), chr);
+}
+
+char** estr_split(const char* str, const char chr, size_t* out_len) {
+    return estra_split(str, chr, out_len, NULL);
+}
+
+/**
+ * @brief Find next piece (maximal run of non-chr characters) starting from *pos
+ */
+static bool _split_next(estr_view_t view, char chr, size_t* pos, estr_span_t* span) {
+    const char* ptr = view.ptr + *pos;
+    const char* end = view.ptr + view.len;
+
+    while(ptr < end && *ptr == chr) { ptr++; } // skip separators
+
+    if(ptr == end) {
+        *pos = view.len;
+        return false;
+    }
+
+    const char* stop = memchr(ptr, chr, end - ptr);
+
+    if(!stop) {
+        stop = end;
+    }
+
+    *span = (estr_span_t) { .offset = ptr - view.ptr, .len = stop - ptr };
+    *pos = stop - view.ptr;
+
+    return true;
+}
+
+size_t estr_v_split_spans(estr_view_t view, const char chr, estr_span_t* spans, size_t cap) {
+    if(!view.ptr) {
+        return 0;
+    }
+
+    size_t cnt = 0;
+    size_t pos = 0;
+    estr_span_t span;
+
+    while(_split_next(view, chr, &pos, &span)) {
+        if(cnt < cap) {
+            spans[cnt] = span;
         }
+        cnt++;
     }
 
-	return true;
+    return cnt;
 }
 
-bool estr_ew_chr(const char* str, char chr) {
-    return !str ? false : str[strlen(str) - 1] == chr;
+estr_split_iter_t estr_split_iter(const char* str, const char chr) {
+    return (estr_split_iter_t) { .str = str, .len = SIZE_MAX, .chr = chr };
 }
 
-bool estrn_is_digit_only(const char* str, size_t n) {
-    if(!str)
+estr_split_iter_t estr_v_split_iter(estr_view_t view, const char chr) {
+    return (estr_split_iter_t) { .str = view.ptr, .len = view.len, .chr = chr };
+}
+
+bool estr_split_next(estr_split_iter_t* it, estr_view_t* piece) {
+    if(!it || !piece || !it->str) {
         return false;
+    }
 
-    size_t len = strlen(str);
-    size_t limit = n <= len ? n : len;
+    if(it->len != SIZE_MAX) { // length is known
+        estr_view_t view = { .ptr = it->str, .len = it->len };
+        estr_span_t span;
 
-    for(size_t i = 0; i < limit; i++) {
-        if (str[i] < '0' || str[i] > '9')
+        if(!_split_next(view, it->chr, &it->pos, &span)) {
             return false;
+        }
+
+        *piece = estr_v_sub(view, span.offset, span.len);
+        return true;
+    }
+
+    const char* ptr = it->str + it->pos;
+
+    while(*ptr && *ptr == it->chr) { ptr++; } // skip separators
+
+    if(!*ptr) {
+        it->len = ptr - it->str; // reached the end, so the length is known now
+        it->pos = it->len;
+        return false;
     }
 
+    size_t len = it->chr ? strcspn(ptr, (const char[]) { it->chr, '\0' }) : strlen(ptr);
+
+    *piece = (estr_view_t) { .ptr = ptr, .len = len };
+    it->pos = ptr + len - it->str;
+
     return true;
 }
 
-size_t estrn_chrcnt(const char* str, char chr, size_t n) {
-    if(!str) {
-        return 0;
+estr_span_t* estr_split_spans(const char* str, const char chr, size_t* out_len) {
+    return estra_split_spans(str, chr, out_len, NULL);
+}
+
+estr_span_t* estra_split_spans(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator) {
+    if(!str || !out_len)
+        return NULL;
+
+    estr_view_t view = estr_view(str);
+    size_t len = estr_v_split_spans(view, chr, NULL, 0);
+    estr_span_t* spans = NULL;
+
+    if(len > 0 && (spans = cu_calloc(allocator, len, sizeof(estr_span_t)))) {
+        estr_v_split_spans(view, chr, spans, len);
     }
-    
-	size_t cnt = 0;
-    size_t len = strlen(str);
-    size_t limit = n <= len ? n : len;
 
-	for(size_t i = 0; i < limit; i++) {
-		if(str[i] == chr)
-			cnt++;
-	}
+    *out_len = spans ? len : 0;
+    return spans;
+}
 
-	return cnt;
+char** estr_split_packed(const char* str, const char chr, size_t* out_len) {
+    return estra_split_packed(str, chr, out_len, NULL);
 }
 
-char** estr_split(const char* str, const char chr, size_t* out_len) {
+char** estra_split_packed(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator) {
     if(!str || !out_len)
         return NULL;
 
-    char* ptr = (char*) str;
-    char prev = '\0';
-    size_t len = 0;
+    *out_len = 0;
+
+    estr_view_t view = estr_view(str);
+    size_t len = estr_v_split_spans(view, chr, NULL, 0);
 
-    while(*ptr) {
-        if(prev && ((*ptr == chr && prev != chr) || (!*(ptr + 1) && *ptr != chr))) len++;
-        prev = *ptr;
-        ptr++;
+    if(len <= 0 || len > (SIZE_MAX - view.len - 1) / sizeof(char*)) {
+        return NULL;
     }
 
-    char** result = NULL;
+    // [ptr0 .. ptrN-1][copy of str with separators replaced by '\0']
+    char** result = cu_alloc(allocator, len * sizeof(char*) + view.len + 1);
 
-    if((*out_len = len) <= 0) {
-        if(!*str || *str == chr)
-            return NULL;
-        
-        result = calloc(*out_len = 1, sizeof(char*));
-        if(!result) { *out_len = 0; return NULL; }
-        result[0] = strdup(str);
-        if(!result[0]) { *out_len = 0; free(result); return NULL; }
-        return result;
+    if(!result) {
+        return NULL;
     }
 
-    result = calloc(len, sizeof(char*));
-    if(!result) { *out_len = 0; return NULL; }
+    char* buf = (char*) (result + len);
+    memcpy(buf, view.ptr, view.len + 1);
 
-    char* start = (char*) str;
-    ptr = start;
-    prev = '\0';
-    size_t i = 0;
-    
-    while(*ptr) {
-        if(*ptr != chr && prev == chr)
-            start = ptr;
-        
-        bool offset_one = !*(ptr + 1) && *ptr != chr;
-
-        if(prev && ((*ptr == chr && prev != chr) || offset_one)) {
-            size_t piece_len = (offset_one ? ptr + 1 : ptr) - start;
-            result[i] = malloc(piece_len + 1);
-            if(!result[i]) {
-                size_t _tmp = i + 1;
-                cu_list_tfree(result, size_t, _tmp);
-                *out_len = 0;
-                return NULL;
-            }
-            memcpy(result[i], start, piece_len);
-            result[i][piece_len] = '\0';
-            i++;
+    size_t pos = 0;
+    estr_span_t span;
+
+    for(size_t i = 0; _split_next(view, chr, &pos, &span); i++) {
+        result[i] = buf + span.offset;
+        buf[span.offset + span.len] = '\0';
+    }
+
+    *out_len = len;
+    return result;
+}
+
+char** estra_split(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator) {
+    if(!str || !out_len)
+        return NULL;
+
+    *out_len = 0;
+
+    estr_view_t view = estr_view(str);
+    size_t len = estr_v_split_spans(view, chr, NULL, 0);
+
+    if(len <= 0) {
+        return NULL;
+    }
+
+    char** result = cu_calloc(allocator, len, sizeof(char*));
+
+    if(!result) {
+        return NULL;
+    }
+
+    size_t pos = 0;
+    estr_span_t span;
+
+    for(size_t i = 0; _split_next(view, chr, &pos, &span); i++) {
+        if(!(result[i] = estra_v_dup(estr_v_sub(view, span.offset, span.len), allocator))) {
+            size_t _len = i; // rest of the list is zeroed
+            cu_list_tfreea(result, size_t, _len, allocator);
+            return NULL;
         }
+    }
+
+    *out_len = len;
+    return result;
+}
+
+estr_t* estr_split_s(const char* str, const char chr, size_t* out_len) {
+    return estra_split_s(str, chr, out_len, NULL);
+}
+
+estr_t* estra_split_s(const char* str, const char chr, size_t* out_len, const cu_allocator_t* allocator) {
+    if(!str || !out_len)
+        return NULL;
+
+    *out_len = 0;
+
+    estr_view_t view = estr_view(str);
+    size_t len = estr_v_split_spans(view, chr, NULL, 0);
+
+    if(len <= 0) {
+        return NULL;
+    }
+
+    estr_t* result = cu_calloc(allocator, len, sizeof(estr_t));
+
+    if(!result) {
+        return NULL;
+    }
+
+    size_t pos = 0;
+    estr_span_t span;
 
-        prev = *ptr;
-        ptr++;
+    for(size_t i = 0; _split_next(view, chr, &pos, &span); i++) {
+        if(estra_s_init_view(&result[i], estr_v_sub(view, span.offset, span.len), allocator) != CU_OK) {
+            estra_s_list_free(result, i, allocator);
+            return NULL;
+        }
     }
 
+    *out_len = len;
     return result;
 }
 
-char* _estr_cat(const char* str, ...) {
+static char* _estr_vcat(const cu_allocator_t* allocator, const char* str, va_list args) {
     const char* first = str;
     size_t length = 0;
     va_list count;
     va_list copy;
 
-    va_start(count, str);
+    va_copy(count, args);
     va_copy(copy, count);
     while(str) {
         length += strlen(str);
@@ -196,7 +331,7 @@ char* _estr_cat(const char* str, ...) {
         return NULL;
     }
     
-    char* res = malloc(length + 1);
+    char* res = cu_alloc(allocator, length + 1);
 
     if(!res) {
         va_end(copy);
@@ -223,186 +358,2505 @@ char* _estr_cat(const char* str, ...) {
     return res;
 }
 
-char* estr_url_encode(const char* str) {
-    if(!str) { return NULL; }
-    static char hex[] = "0123456789abcdef";
-    size_t _len = strlen(str);
-    char* buf = malloc(_len * 3 + 1); // optimize?
-    if(!buf) { return NULL; }
-    char* pbuf = buf;
-
-    for(size_t i = 0; i < _len; i++) {
-        if (estr_is_alnum(str[i]) || strchr(".-_~", str[i])) {
-            *pbuf++ = str[i];
-        } else if (str[i] == ' ') {
-            *pbuf++ = '+';
-        } else {
-            *pbuf++ = '%';
-            *pbuf++ = hex[(str[i] >> 4) & 15];
-            *pbuf++ = hex[str[i] & 15];
+char* _estr_cat(const char* str, ...) {
+    va_list args;
+    va_start(args, str);
+    char* res = _estr_vcat(NULL, str, args);
+    va_end(args);
+    return res;
+}
+
+char* _estra_cat(const cu_allocator_t* allocator, const char* str, ...) {
+    va_list args;
+    va_start(args, str);
+    char* res = _estr_vcat(allocator, str, args);
+    va_end(args);
+    return res;
+}
+
+static const char _url_hex[] = "0123456789abcdef";
+
+static const bool _url_safe[256] = {
+    ['0' ... '9'] = true, ['A' ... 'Z'] = true, ['a' ... 'z'] = true,
+    ['-'] = true, ['.'] = true, ['_'] = true, ['~'] = true
+};
+
+#define _url_is_safe(chr) _url_safe[(uint8_t) (chr)]
+
+/**
+ * @brief Value of hex digit + 1 (0 for characters which are not hex digits)
+ */
+static const uint8_t _url_hex_val[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+/**
+ * @brief Encoded length (or SIZE_MAX on overflow)
+ */
+static size_t _url_encoded_len(const char* str, size_t len) {
+    if(len > SIZE_MAX / 3) {
+        return SIZE_MAX;
+    }
+
+    const estr_scan_t* scan = estr_scan();
+    size_t encoded = len;
+
+    for(size_t i = scan->find_url_unsafe(str, len); i < len; i++) {
+        if(str[i] != ' ') {
+            encoded += 2;
+        }
+
+        if(i + 1 < len && _url_is_safe(str[i + 1])) { // skip run of safe characters
+            i += scan->find_url_unsafe(str + i + 1, len - i - 1);
         }
     }
 
-    *pbuf = '\0';
+    return encoded;
+}
+
+/**
+ * @brief Encode into buffer which is big enough (runs of safe characters are copied in bulk)
+ */
+static char* _url_encode(const char* str, size_t len, char* buf) {
+    const estr_scan_t* scan = estr_scan();
+
+    for(size_t i = 0; i < len; ) {
+        size_t run = scan->find_url_unsafe(str + i, len - i);
+        memcpy(buf, str + i, run);
+        buf += run;
+        i += run;
+
+        for(; i < len && !_url_is_safe(str[i]); i++) {
+            uint8_t chr = str[i];
+
+            if(chr == ' ') {
+                *buf++ = '+';
+            } else {
+                *buf++ = '%';
+                *buf++ = _url_hex[chr >> 4];
+                *buf++ = _url_hex[chr & 15];
+            }
+        }
+    }
 
     return buf;
 }
 
-char* estr_rep(const char *orig, const char *rep, const char *with) {
-    // Taken from: https://stackoverflow.com/a/779960
-    // It's a little bit modified
+/**
+ * @brief Decode into buffer which is big enough. Stops before incomplete escape sequence at the end
+ */
+static cu_err_t _url_decode(const char* str, size_t len, char* buf, size_t* consumed, size_t* written) {
+    const estr_scan_t* scan = estr_scan();
+    cu_err_t err = CU_OK;
+    char* start = buf;
+    size_t i = 0;
 
-    if (!orig || !rep || !with)
-        return NULL;
-    
-    char *result;  // the return string
-    char *ins;     // the next insert point
-    char *tmp;     // varies
-    int len_rep;   // length of rep (the string to remove)
-    int len_with;  // length of with (the string to replace rep with)
-    int len_front; // distance between rep and end of last rep
-    int count;     // number of replacements
-    
-    len_rep = strlen(rep);
-    if (len_rep == 0)
-        return NULL; // empty rep causes infinite loop during count
-    
-    len_with = strlen(with);
+    while(i < len) {
+        size_t run = scan->find_chr2(str + i, len - i, '%', '+');
+        memcpy(buf, str + i, run);
+        buf += run;
+        i += run;
 
-    // count the number of replacements needed
-    ins = (char*) orig;
-    for (count = 0; (tmp = strstr(ins, rep)); ++count) {
-        ins = tmp + len_rep;
-    }
+        if(i == len) {
+            break;
+        }
 
-    tmp = result = malloc(strlen(orig) + (len_with - len_rep) * count + 1);
+        if(str[i] == '+') {
+            *buf++ = ' ';
+            i++;
+            continue;
+        }
 
-    if (!result)
-        return NULL;
+        if(len - i < 3) { // incomplete
+            break;
+        }
 
-    // first time through the loop, all the variable are set correctly
-    // from here on,
-    //    tmp points to the end of the result string
-    //    ins points to the next occurrence of rep in orig
-    //    orig points to the remainder of orig after "end of rep"
-    while (count--) {
-        ins = strstr(orig, rep);
-        len_front = ins - orig;
-        tmp = strncpy(tmp, orig, len_front) + len_front;
-        tmp = strcpy(tmp, with) + len_with;
-        orig += len_front + len_rep; // move to next "end of rep"
-    }
-    strcpy(tmp, orig);
-    return result;
-}
+        uint8_t hi = _url_hex_val[(uint8_t) str[i + 1]];
+        uint8_t lo = _url_hex_val[(uint8_t) str[i + 2]];
 
-bool estr_is_alnum(char chr) {
-    return isalnum(chr);
-}
+        if(!hi || !lo) {
+            err = CU_ERR_SYNTAX_ERROR;
+            break;
+        }
 
-bool estr_chr_is_ws(char chr) {
-    return chr == ' '||
-        chr == '\t' ||
-        chr == '\r' ||
-        chr == '\n' ||
-        chr == '\v' ||
-        chr == '\f';
+        *buf++ = (char) (((hi - 1) << 4) | (lo - 1));
+        i += 3;
+    }
+
+    *consumed = i;
+    *written = buf - start;
+
+    return err;
 }
 
-bool estr_is_trimmed(const char* str) {
-    return !str ? false :
-        (!estr_chr_is_ws(str[0]) && !estr_chr_is_ws(str[strlen(str) - 1]));
+char* estr_url_encode(const char* str) {
+    return estra_url_encode(str, NULL);
 }
 
-bool estr_contains_unescaped_chr(const char* str, char chr) {
+char* estra_url_encode(const char* str, const cu_allocator_t* allocator) {
     if(!str) {
-        return false;
+        return NULL;
     }
 
-    char* curr = (char*) str;
-    char* prev = NULL;
+    size_t len = strlen(str);
+    size_t encoded_len = _url_encoded_len(str, len);
 
-    while(*curr) {
-        if(*curr == chr && (!prev || *prev != '\\')) {
-            return true;
-        }
+    if(encoded_len == SIZE_MAX) {
+        return NULL;
+    }
 
-        prev = curr++;
+    char* buf = cu_alloc(allocator, encoded_len + 1); // exact size
+
+    if(buf) {
+        *_url_encode(str, len, buf) = '\0';
     }
 
-    return false;
+    return buf;
 }
 
-bool estr_is_empty_ws(const char* str) {
-    if(! str) {
-        return true;
+cu_err_t estr_v_url_encode_to(estr_view_t view, char* buf, size_t size, size_t* out_len) {
+    if(!view.ptr || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
     }
 
-    char* ptr = (char*) str;
+    size_t encoded_len = _url_encoded_len(view.ptr, view.len);
 
-    while(*ptr) {
-        if(!estr_chr_is_ws(*ptr++)) {
-            return false;
-        }
+    if(out_len) {
+        *out_len = encoded_len;
     }
 
-    return true;
+    if(encoded_len >= size) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    *_url_encode(view.ptr, view.len, buf) = '\0';
+    return CU_OK;
 }
 
-char* estr_repeat_chr(char chr, unsigned int times) {
-    if(times == 0) {
+char* estr_url_decode(const char* str) {
+    return estra_url_decode(str, NULL);
+}
+
+char* estra_url_decode(const char* str, const cu_allocator_t* allocator) {
+    if(!str) {
         return NULL;
     }
 
-    char* str = malloc(times + 1);
+    cu_err_t err = CU_OK;
+    estr_view_t view = estr_view(str);
+    size_t len = 0;
+    char* buf = NULL;
 
-    if(!str) {
+    if(estr_v_url_decode_to(view, NULL, 0, &len) == CU_ERR_SYNTAX_ERROR) {
         return NULL;
     }
 
-    for(unsigned int i = 0; i < times; i++) {
-        str[i] = chr;
+    cu_mem_check(buf = cu_alloc(allocator, len + 1)); // exact size
+    cu_err_check(estr_v_url_decode_to(view, buf, len + 1, NULL));
+
+    return buf;
+_error:
+    cu_free(allocator, buf);
+    return NULL;
+}
+
+cu_err_t estr_v_url_decode_to(estr_view_t view, char* buf, size_t size, size_t* out_len) {
+    if(!view.ptr || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
     }
 
-    str[times] = '\0';
+    // every escape sequence is 3 characters long and decodes to one
+    size_t escapes = estr_v_chrcnt(view, '%');
 
-    return str;
+    if(escapes > view.len / 3) {
+        return CU_ERR_SYNTAX_ERROR;
+    }
+
+    size_t decoded_len = view.len - escapes * 2;
+
+    if(out_len) {
+        *out_len = decoded_len;
+    }
+
+    if(decoded_len >= size) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    size_t consumed, written;
+    cu_err_t err = _url_decode(view.ptr, view.len, buf, &consumed, &written);
+
+    if(err == CU_OK && consumed < view.len) {
+        err = CU_ERR_SYNTAX_ERROR;
+    }
+
+    buf[err == CU_OK ? written : 0] = '\0';
+    return err;
 }
 
-bool estr_contains_ws(const char* str) {
-    if(!str) {
-        return false;
+/**
+ * @brief Add n characters (already written after the built string) to the builder and terminate it.
+ *        Nothing is written if n is zero, so the shared empty buffer of a new builder is never modified
+ */
+static inline void _b_advance(estr_builder_t* builder, size_t n) {
+    if(n > 0) {
+        builder->buf[builder->len += n] = '\0';
     }
+}
+
+cu_err_t estr_url_decode_chunk(estr_url_decoder_t* decoder, estr_view_t chunk, estr_builder_t* builder) {
+    if(!decoder || !chunk.ptr || !builder || decoder->pending_len > sizeof(decoder->pending)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err = CU_OK;
+    size_t consumed, written;
+
+    if(decoder->pending_len > 0) { // complete escape sequence from the previous chunk
+        while(decoder->pending_len < sizeof(decoder->pending) && chunk.len > 0) {
+            decoder->pending[decoder->pending_len++] = *chunk.ptr++;
+            chunk.len--;
+        }
+
+        if(decoder->pending_len < sizeof(decoder->pending)) {
+            return CU_OK; // still incomplete
+        }
+
+        char chr;
+
+        if((err = _url_decode(decoder->pending, sizeof(decoder->pending), &chr, &consumed, &written)) != CU_OK) {
+            return err;
+        }
 
-    char* ptr = (char*) str;
+        decoder->pending_len = 0;
 
-    while(*ptr) {
-        if(estr_chr_is_ws(*ptr++)) {
-            return true;
+        if((err = estr_b_chr(builder, chr)) != CU_OK) {
+            return err;
         }
     }
 
-    return false;
+    if((err = estr_b_reserve(builder, chunk.len)) != CU_OK) { // decoded is never longer
+        return err;
+    }
+
+    err = _url_decode(chunk.ptr, chunk.len, builder->buf + builder->len, &consumed, &written);
+    _b_advance(builder, written);
+
+    if(err == CU_OK) {
+        decoder->pending_len = chunk.len - consumed;
+        memcpy(decoder->pending, chunk.ptr + consumed, decoder->pending_len);
+    }
+
+    return err;
 }
 
-cu_err_t estr_validate(const char* str, estr_validation_t* validation) {
-    if(!str || !validation) {
+cu_err_t estr_url_decode_end(estr_url_decoder_t* decoder) {
+    if(!decoder) {
         return CU_ERR_INVALID_ARG;
     }
 
-    if(validation->no_whitespace && estr_contains_ws(str)) {
-        return CU_ERR_ESTR_INVALID_WHITESPACE;
+    bool complete = decoder->pending_len == 0;
+    decoder->pending_len = 0;
+
+    return complete ? CU_OK : CU_ERR_SYNTAX_ERROR;
+}
+
+char* estr_rep(const char *orig, const char *rep, const char *with) {
+    return estra_rep(orig, rep, with, NULL);
+}
+
+char* estra_rep(const char *orig, const char *rep, const char *with, const cu_allocator_t* allocator) {
+    estr_pattern_t pattern;
+
+    if(!orig || !with || estr_pattern_compile(&pattern, rep) != CU_OK)
+        return NULL; // empty rep is not allowed
+
+    return estra_rep_p(orig, &pattern, with, allocator);
+}
+
+cu_err_t estr_pattern_compile(estr_pattern_t* pattern, const char* needle) {
+    if(!pattern || !needle || !*needle) {
+        return CU_ERR_INVALID_ARG;
     }
 
-    if(validation->length) {
-        unsigned int len = strlen(str);
+    size_t len = strlen(needle);
+    uint8_t max_skip = len < UINT8_MAX ? len : UINT8_MAX;
 
-        if(validation->minlen > 0 && validation->maxlen == 0) {
-            validation->maxlen = validation->minlen;
-        }
+    pattern->needle = needle;
+    pattern->len = len;
+    memset(pattern->skip, max_skip, sizeof(pattern->skip));
+
+    // shorter shifts are always safe, so capping them only costs some speed on long needles
+    for(size_t i = 0; i < len - 1; i++) {
+        size_t shift = len - 1 - i;
+        pattern->skip[(uint8_t) needle[i]] = shift < UINT8_MAX ? shift : UINT8_MAX;
+    }
+
+    return CU_OK;
+}
+
+/**
+ * @brief Short needles are searched by first character (memchr), longer ones with Horspool
+ */
+static const char* _pattern_find(const estr_pattern_t* pattern, const char* str, size_t len) {
+    size_t n = pattern->len;
+
+    if(n > len) {
+        return NULL;
+    }
+
+    if(n < 4) {
+        const char* end = str + len - n + 1;
+
+        while((str = memchr(str, pattern->needle[0], end - str))) {
+            if(memcmp(str + 1, pattern->needle + 1, n - 1) == 0) {
+                return str;
+            }
+
+            str++;
+        }
+
+        return NULL;
+    }
+
+    const char last = pattern->needle[n - 1];
+
+    for(size_t i = 0; i <= len - n; ) {
+        char chr = str[i + n - 1];
+
+        if(chr == last && memcmp(str + i, pattern->needle, n - 1) == 0) {
+            return str + i;
+        }
+
+        i += pattern->skip[(uint8_t) chr];
+    }
+
+    return NULL;
+}
+
+const char* estr_find(const estr_pattern_t* pattern, const char* str) {
+    return estr_v_find(pattern, estr_view(str));
+}
+
+const char* estr_v_find(const estr_pattern_t* pattern, estr_view_t view) {
+    if(!pattern || !pattern->needle || !view.ptr) {
+        return NULL;
+    }
+
+    return _pattern_find(pattern, view.ptr, view.len);
+}
+
+const char* estr_ifind(const char* str, const char* needle) {
+    return estr_v_ifind(estr_view(str), estr_view(needle));
+}
+
+const char* estr_v_ifind(estr_view_t view, estr_view_t needle) {
+    if(!view.ptr || !needle.ptr || needle.len == 0 || needle.len > view.len) {
+        return NULL;
+    }
+
+    const estr_scan_t* scan = estr_scan();
+    char first = needle.ptr[0];
+    char lower = first >= 'A' && first <= 'Z' ? first | 0x20 : first;
+    char upper = first >= 'a' && first <= 'z' ? first & ~0x20 : first;
+    size_t end = view.len - needle.len + 1; // number of possible starts
+
+    for(size_t i = 0; i < end; i++) {
+        i += scan->find_chr2(view.ptr + i, end - i, lower, upper);
+
+        if(i == end) {
+            break;
+        }
+
+        if(scan->ieq(view.ptr + i + 1, needle.ptr + 1, needle.len - 1)) {
+            return view.ptr + i;
+        }
+    }
+
+    return NULL;
+}
+
+size_t estr_count(const estr_pattern_t* pattern, const char* str) {
+    if(!pattern || !pattern->needle || !str) {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t len = strlen(str);
+    const char* end = str + len;
+
+    while((str = _pattern_find(pattern, str, end - str))) {
+        count++;
+        str += pattern->len;
+    }
+
+    return count;
+}
+
+char* estr_rep_p(const char* orig, const estr_pattern_t* rep, const char* with) {
+    return estra_rep_p(orig, rep, with, NULL);
+}
+
+char* estra_rep_p(const char* orig, const estr_pattern_t* rep, const char* with, const cu_allocator_t* allocator) {
+    if(!orig || !rep || !rep->needle || !with)
+        return NULL;
+
+    size_t _positions[16];           // enough for most of the strings
+    size_t* positions = _positions;
+    size_t capacity = sizeof(_positions) / sizeof(_positions[0]);
+    size_t count = 0;
+    size_t len = strlen(orig);
+    size_t len_with = strlen(with);
+    const char* ptr = orig;
+    char* result = NULL;
+
+    // find (and remember) all of the matches
+    while((ptr = _pattern_find(rep, ptr, orig + len - ptr))) {
+        if(count == capacity) {
+            size_t* _tmp = cu_alloc(allocator, (capacity *= 2) * sizeof(size_t));
+            if(!_tmp) { goto _return; }
+            memcpy(_tmp, positions, count * sizeof(size_t));
+            if(positions != _positions) { cu_free(allocator, positions); }
+            positions = _tmp;
+        }
+
+        positions[count++] = ptr - orig;
+        ptr += rep->len;
+    }
+
+    // result can't be bigger than the original if replacement is not longer than pattern
+    if(len_with > rep->len && count > (SIZE_MAX - len - 1) / (len_with - rep->len)) {
+        goto _return;
+    }
+
+    char* tmp = result = cu_alloc(allocator, len - count * rep->len + count * len_with + 1);
+
+    if(!result) {
+        goto _return;
+    }
+
+    size_t offset = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        memcpy(tmp, orig + offset, positions[i] - offset);
+        tmp += positions[i] - offset;
+        memcpy(tmp, with, len_with);
+        tmp += len_with;
+        offset = positions[i] + rep->len;
+    }
+
+    memcpy(tmp, orig + offset, len - offset + 1);
+_return:
+    if(positions != _positions) {
+        cu_free(allocator, positions);
+    }
+
+    return result;
+}
+
+struct estr_rep_multi_node {
+    uint32_t child;    /*<! First child (0 if none, root is never a child) */
+    uint32_t sibling;  /*<! Next sibling (0 if none) */
+    uint32_t pair;     /*<! Index of the pair + 1 if pattern ends here (0 if none) */
+    char chr;          /*<! Character on the edge from the parent */
+};
+
+struct estr_rep_multi_pair {
+    char* with;        /*<! Copy of the replacement */
+    size_t with_len;   /*<! Length of the replacement */
+    size_t rep_len;    /*<! Length of the replaced pattern */
+};
+
+struct estr_rep_multi {
+    uint32_t first[256];                    /*<! Node for every first character (0 if no pattern starts with it) */
+    struct estr_rep_multi_node* nodes;      /*<! Trie of patterns (nodes[0] is the root) */
+    uint32_t nodes_len;                     /*<! Number of nodes */
+    struct estr_rep_multi_pair* pairs;      /*<! Replacements */
+    size_t npairs;                          /*<! Number of replacements */
+    cu_allocator_t allocator;               /*<! Allocator */
+};
+
+/**
+ * @brief Child of the node on the character (0 if there is no such child)
+ */
+static inline uint32_t _multi_child(const struct estr_rep_multi* multi, uint32_t node, char chr) {
+    if(node == 0) {
+        return multi->first[(uint8_t) chr];
+    }
+
+    for(node = multi->nodes[node].child; node; node = multi->nodes[node].sibling) {
+        if(multi->nodes[node].chr == chr) {
+            return node;
+        }
+    }
+
+    return 0;
+}
+
+static cu_err_t _multi_insert(struct estr_rep_multi* multi, const char* rep, uint32_t pair, uint32_t* capacity) {
+    uint32_t node = 0;
+
+    for(; *rep; rep++) {
+        uint32_t next = _multi_child(multi, node, *rep);
+
+        if(!next) {
+            if(multi->nodes_len == *capacity) {
+                if(*capacity > UINT32_MAX / 2) {
+                    return CU_ERR_NO_MEM;
+                }
+
+                struct estr_rep_multi_node* _nodes = cu_realloc(&multi->allocator, multi->nodes,
+                    *capacity * sizeof(struct estr_rep_multi_node), (*capacity * 2) * sizeof(struct estr_rep_multi_node));
+
+                if(!_nodes) {
+                    return CU_ERR_NO_MEM;
+                }
+
+                multi->nodes = _nodes;
+                *capacity *= 2;
+            }
+
+            next = multi->nodes_len++;
+            multi->nodes[next] = (struct estr_rep_multi_node) { .chr = *rep };
+
+            if(node == 0) {
+                multi->first[(uint8_t) *rep] = next;
+            } else {
+                multi->nodes[next].sibling = multi->nodes[node].child;
+                multi->nodes[node].child = next;
+            }
+        }
+
+        node = next;
+    }
+
+    if(!multi->nodes[node].pair) { // first pair wins
+        multi->nodes[node].pair = pair;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_rep_multi_compile(const estr_rep_pair_t* pairs, size_t npairs, estr_rep_multi_t* multi) {
+    return estra_rep_multi_compile(pairs, npairs, multi, NULL);
+}
+
+cu_err_t estra_rep_multi_compile(const estr_rep_pair_t* pairs, size_t npairs, estr_rep_multi_t* multi, const cu_allocator_t* allocator) {
+    if(!pairs || npairs == 0 || npairs >= UINT32_MAX || !multi) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    for(size_t i = 0; i < npairs; i++) {
+        if(!pairs[i].rep || !*pairs[i].rep || !pairs[i].with) {
+            return CU_ERR_INVALID_ARG;
+        }
+    }
+
+    cu_err_t err = CU_OK;
+    estr_rep_multi_t _multi = NULL;
+    uint32_t capacity = 16;
+
+    cu_mem_check(_multi = cu_tctora(allocator, estr_rep_multi_t, struct estr_rep_multi,
+        .nodes_len = 1 // root
+    ));
+
+    if(allocator) {
+        _multi->allocator = *allocator;
+    }
+
+    cu_mem_check(_multi->nodes = cu_calloc(allocator, capacity, sizeof(struct estr_rep_multi_node)));
+    cu_mem_check(_multi->pairs = cu_calloc(allocator, npairs, sizeof(struct estr_rep_multi_pair)));
+
+    for(size_t i = 0; i < npairs; i++) {
+        struct estr_rep_multi_pair* pair = &_multi->pairs[_multi->npairs++];
+        cu_mem_check(pair->with = cu_strdup(allocator, pairs[i].with));
+        pair->with_len = strlen(pairs[i].with);
+        pair->rep_len = strlen(pairs[i].rep);
+        cu_err_check(_multi_insert(_multi, pairs[i].rep, i + 1, &capacity));
+    }
+
+    *multi = _multi;
+    goto _return;
+_error:
+    estr_rep_multi_destroy(_multi);
+_return:
+    return err;
+}
+
+cu_err_t estr_rep_multi_destroy(estr_rep_multi_t multi) {
+    if(!multi) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_allocator_t allocator = multi->allocator;
+
+    if(multi->pairs) {
+        for(size_t i = 0; i < multi->npairs; i++) {
+            cu_free(&allocator, multi->pairs[i].with);
+        }
+    }
+
+    cu_free(&allocator, multi->pairs);
+    cu_free(&allocator, multi->nodes);
+    cu_free(&allocator, multi);
+
+    return CU_OK;
+}
+
+/**
+ * @brief Longest pattern which starts at the beginning of str (0 if none)
+ */
+static uint32_t _multi_match(const struct estr_rep_multi* multi, const char* str, size_t len) {
+    uint32_t node = multi->first[(uint8_t) *str];
+    uint32_t pair = 0;
+
+    for(size_t i = 1; node; i++) {
+        if(multi->nodes[node].pair) {
+            pair = multi->nodes[node].pair;
+        }
+
+        if(i == len) {
+            break;
+        }
+
+        node = _multi_child(multi, node, str[i]);
+    }
+
+    return pair;
+}
+
+char* estr_rep_m(const char* orig, estr_rep_multi_t multi) {
+    return estra_v_rep_m(estr_view(orig), multi, NULL);
+}
+
+char* estra_rep_m(const char* orig, estr_rep_multi_t multi, const cu_allocator_t* allocator) {
+    return estra_v_rep_m(estr_view(orig), multi, allocator);
+}
+
+typedef struct {
+    size_t pos;     /*<! Position of the match in the original */
+    uint32_t pair;  /*<! Matched pair + 1 */
+} _multi_match_t;
+
+char* estra_v_rep_m(estr_view_t orig, estr_rep_multi_t multi, const cu_allocator_t* allocator) {
+    if(!orig.ptr || !multi) {
+        return NULL;
+    }
+
+    _multi_match_t _matches[16];        // enough for most of the strings
+    _multi_match_t* matches = _matches;
+    size_t capacity = sizeof(_matches) / sizeof(_matches[0]);
+    size_t count = 0;
+    size_t len = orig.len;
+    char* result = NULL;
+
+    // find (and remember) all of the matches, leftmost first
+    for(size_t i = 0; i < orig.len; ) {
+        uint32_t pair = multi->first[(uint8_t) orig.ptr[i]] ? _multi_match(multi, orig.ptr + i, orig.len - i) : 0;
+
+        if(!pair) {
+            i++;
+            continue;
+        }
+
+        if(count == capacity) {
+            _multi_match_t* _tmp = cu_alloc(allocator, (capacity *= 2) * sizeof(_multi_match_t));
+            if(!_tmp) { goto _return; }
+            memcpy(_tmp, matches, count * sizeof(_multi_match_t));
+            if(matches != _matches) { cu_free(allocator, matches); }
+            matches = _tmp;
+        }
+
+        const struct estr_rep_multi_pair* _pair = &multi->pairs[pair - 1];
+
+        if(_pair->with_len > SIZE_MAX - len - 1) {
+            goto _return;
+        }
+
+        len = len - _pair->rep_len + _pair->with_len;
+        matches[count++] = (_multi_match_t) { .pos = i, .pair = pair };
+        i += _pair->rep_len;
+    }
+
+    char* tmp = result = cu_alloc(allocator, len + 1);
+
+    if(!result) {
+        goto _return;
+    }
+
+    size_t offset = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        const struct estr_rep_multi_pair* pair = &multi->pairs[matches[i].pair - 1];
+        memcpy(tmp, orig.ptr + offset, matches[i].pos - offset);
+        tmp += matches[i].pos - offset;
+        memcpy(tmp, pair->with, pair->with_len);
+        tmp += pair->with_len;
+        offset = matches[i].pos + pair->rep_len;
+    }
+
+    memcpy(tmp, orig.ptr + offset, orig.len - offset);
+    tmp[orig.len - offset] = '\0';
+_return:
+    if(matches != _matches) {
+        cu_free(allocator, matches);
+    }
+
+    return result;
+}
+
+cu_err_t estr_b_v_rep_m(estr_builder_t* builder, estr_view_t view, estr_rep_multi_t multi) {
+    if(!builder || !view.ptr || !multi) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err = CU_OK;
+    size_t offset = 0;
+
+    for(size_t i = 0; i < view.len && err == CU_OK; ) {
+        uint32_t pair = multi->first[(uint8_t) view.ptr[i]] ? _multi_match(multi, view.ptr + i, view.len - i) : 0;
+
+        if(!pair) {
+            i++;
+            continue;
+        }
+
+        const struct estr_rep_multi_pair* _pair = &multi->pairs[pair - 1];
+
+        if((err = estr_b_view(builder, estr_v_sub(view, offset, i - offset))) == CU_OK) {
+            err = estr_b_view(builder, (estr_view_t) { .ptr = _pair->with, .len = _pair->with_len });
+        }
+
+        offset = i += _pair->rep_len;
+    }
+
+    return err != CU_OK ? err : estr_b_view(builder, estr_v_sub(view, offset, view.len - offset));
+}
+
+char* estr_rep_multi(const char* orig, const estr_rep_pair_t* pairs, size_t npairs) {
+    return estra_rep_multi(orig, pairs, npairs, NULL);
+}
+
+char* estra_rep_multi(const char* orig, const estr_rep_pair_t* pairs, size_t npairs, const cu_allocator_t* allocator) {
+    estr_rep_multi_t multi = NULL;
+
+    if(!orig || estra_rep_multi_compile(pairs, npairs, &multi, allocator) != CU_OK) {
+        return NULL;
+    }
+
+    char* result = estra_rep_m(orig, multi, allocator);
+    estr_rep_multi_destroy(multi);
+
+    return result;
+}
+
+bool estr_is_alnum(char chr) {
+    return isalnum((unsigned char) chr);
+}
+
+bool estr_chr_is_ws(char chr) {
+    return chr == ' '||
+        chr == '\t' ||
+        chr == '\r' ||
+        chr == '\n' ||
+        chr == '\v' ||
+        chr == '\f';
+}
+
+bool estr_is_trimmed(const char* str) {
+    return estr_v_is_trimmed(estr_view(str));
+}
+
+bool estr_contains_unescaped_chr(const char* str, char chr) {
+    return estr_v_contains_unescaped_chr(estr_view(str), chr);
+}
+
+bool estr_is_empty_ws(const char* str) {
+    return estr_v_is_empty_ws(estr_view(str));
+}
+
+char* estr_repeat_chr(char chr, unsigned int times) {
+    return estra_repeat_chr(chr, times, NULL);
+}
+
+char* estra_repeat_chr(char chr, unsigned int times, const cu_allocator_t* allocator) {
+    if(times == 0) {
+        return NULL;
+    }
+
+    char* str = cu_alloc(allocator, times + 1);
+
+    if(!str) {
+        return NULL;
+    }
+
+    for(unsigned int i = 0; i < times; i++) {
+        str[i] = chr;
+    }
+
+    str[times] = '\0';
+
+    return str;
+}
+
+bool estr_contains_ws(const char* str) {
+    return estr_v_contains_ws(estr_view(str));
+}
+
+estr_view_t estr_view(const char* str) {
+    return (estr_view_t) { .ptr = str, .len = str ? strlen(str) : 0 };
+}
+
+estr_view_t estrn_view(const char* str, size_t n) {
+    return (estr_view_t) { .ptr = str, .len = str ? strnlen(str, n) : 0 };
+}
+
+estr_view_t estr_v_sub(estr_view_t view, size_t offset, size_t len) {
+    if(offset > view.len) {
+        offset = view.len;
+    }
+
+    if(len > view.len - offset) {
+        len = view.len - offset;
+    }
+
+    return (estr_view_t) { .ptr = view.ptr ? view.ptr + offset : NULL, .len = len };
+}
+
+char* estr_v_dup(estr_view_t view) {
+    return estra_v_dup(view, NULL);
+}
+
+char* estra_v_dup(estr_view_t view, const cu_allocator_t* allocator) {
+    if(!view.ptr) {
+        return NULL;
+    }
+
+    char* str = cu_alloc(allocator, view.len + 1);
+
+    if(str) {
+        memcpy(str, view.ptr, view.len);
+        str[view.len] = '\0';
+    }
+
+    return str;
+}
+
+bool estr_v_eq(estr_view_t view1, estr_view_t view2) {
+    if(!view1.ptr || !view2.ptr) {
+        return false;
+    }
+
+    return view1.len == view2.len && memcmp(view1.ptr, view2.ptr, view1.len) == 0;
+}
+
+bool estr_v_sw(estr_view_t view, estr_view_t prefix) {
+    if(!view.ptr || !prefix.ptr || prefix.len == 0 || prefix.len > view.len) {
+        return false;
+    }
+
+    return memcmp(view.ptr, prefix.ptr, prefix.len) == 0;
+}
+
+bool estr_v_sw_chr(estr_view_t view, char chr) {
+    return view.ptr && view.len > 0 && view.ptr[0] == chr;
+}
+
+bool estr_v_ew(estr_view_t view, estr_view_t suffix) {
+    if(!view.ptr || !suffix.ptr || suffix.len == 0 || suffix.len > view.len) {
+        return false;
+    }
+
+    return memcmp(view.ptr + view.len - suffix.len, suffix.ptr, suffix.len) == 0;
+}
+
+bool estr_v_ew_chr(estr_view_t view, char chr) {
+    return view.ptr && view.len > 0 && view.ptr[view.len - 1] == chr;
+}
+
+bool estr_v_ieq(estr_view_t view1, estr_view_t view2) {
+    if(!view1.ptr || !view2.ptr) {
+        return false;
+    }
+
+    return view1.len == view2.len && estr_scan()->ieq(view1.ptr, view2.ptr, view1.len);
+}
+
+bool estr_v_isw(estr_view_t view, estr_view_t prefix) {
+    if(!view.ptr || !prefix.ptr || prefix.len == 0 || prefix.len > view.len) {
+        return false;
+    }
+
+    return estr_scan()->ieq(view.ptr, prefix.ptr, prefix.len);
+}
+
+bool estr_v_iew(estr_view_t view, estr_view_t suffix) {
+    if(!view.ptr || !suffix.ptr || suffix.len == 0 || suffix.len > view.len) {
+        return false;
+    }
+
+    return estr_scan()->ieq(view.ptr + view.len - suffix.len, suffix.ptr, suffix.len);
+}
+
+bool estr_v_is_digit_only(estr_view_t view) {
+    if(!view.ptr) {
+        return false;
+    }
+
+    return estr_scan()->find_non_digit(view.ptr, view.len) == view.len;
+}
+
+size_t estr_v_chrcnt(estr_view_t view, char chr) {
+    if(!view.ptr) {
+        return 0;
+    }
+
+    return estr_scan()->chrcnt(view.ptr, view.len, chr);
+}
+
+bool estr_v_is_trimmed(estr_view_t view) {
+    if(!view.ptr) {
+        return false;
+    }
+
+    return view.len == 0 ||
+        (!estr_chr_is_ws(view.ptr[0]) && !estr_chr_is_ws(view.ptr[view.len - 1]));
+}
+
+bool estr_v_contains_unescaped_chr(estr_view_t view, char chr) {
+    if(!view.ptr) {
+        return false;
+    }
+
+    return estr_scan()->find_unescaped(view.ptr, view.len, chr) < view.len;
+}
+
+size_t estr_find_unescaped(const char* str, char chr, size_t* positions, size_t cap) {
+    return estr_v_find_unescaped(estr_view(str), chr, positions, cap);
+}
+
+size_t estr_v_find_unescaped(estr_view_t view, char chr, size_t* positions, size_t cap) {
+    if(!view.ptr || (!positions && cap > 0)) {
+        return 0;
+    }
+
+    return estr_scan()->unescaped_all(view.ptr, view.len, chr, positions, cap);
+}
+
+bool estr_v_is_empty_ws(estr_view_t view) {
+    if(!view.ptr) {
+        return true;
+    }
+
+    return estr_scan()->find_non_ws(view.ptr, view.len) == view.len;
+}
+
+bool estr_v_contains_ws(estr_view_t view) {
+    if(!view.ptr) {
+        return false;
+    }
+
+    return estr_scan()->find_ws(view.ptr, view.len) < view.len;
+}
+
+cu_err_t estr_utf8_validate(estr_view_t view, size_t* out_index) {
+    if(!view.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t index = estr_scan()->find_utf8_invalid(view.ptr, view.len);
+
+    if(out_index) {
+        *out_index = index;
+    }
+
+    return index < view.len ? CU_ERR_ESTR_INVALID_UTF8 : CU_OK;
+}
+
+size_t estr_utf8_count(estr_view_t view) {
+    if(!view.ptr) {
+        return 0;
+    }
+
+    return estr_scan()->utf8_count(view.ptr, view.len);
+}
+
+#define _ESTR_B_MIN_CAP 32
+
+cu_err_t estr_b_init(estr_builder_t* builder, char* buf, size_t size, const cu_allocator_t* allocator) {
+    if(!builder || (buf && size == 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    static const char empty[1] = ""; // shared by every builder without buffer, never written
+
+    *builder = (estr_builder_t) {
+        .buf = buf ? buf : (char*) empty,
+        .cap = buf ? size - 1 : 0,
+        .initial = buf,
+        .initial_size = buf ? size : 0
+    };
+
+    if(allocator) {
+        builder->allocator = *allocator;
+    }
+
+    if(buf) {
+        buf[0] = '\0';
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_b_reserve(estr_builder_t* builder, size_t n) {
+    if(!builder) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(builder->failed) {
+        return CU_ERR_NO_MEM;
+    }
+
+    if(n <= builder->cap - builder->len) {
+        return CU_OK;
+    }
+
+    if(n > SIZE_MAX - 1 - builder->len) {
+        builder->failed = true;
+        return CU_ERR_NO_MEM;
+    }
+
+    size_t need = builder->len + n;
+    size_t cap = builder->cap < _ESTR_B_MIN_CAP ? _ESTR_B_MIN_CAP : builder->cap;
+
+    while(cap < need) {
+        cap = cap > (SIZE_MAX - 1) / 2 ? SIZE_MAX - 1 : cap * 2;
+    }
+
+    char* buf = cu_realloc(&builder->allocator, builder->owned ? builder->buf : NULL,
+        builder->owned ? builder->cap + 1 : 0, cap + 1);
+
+    if(!buf) {
+        builder->failed = true;
+        return CU_ERR_NO_MEM;
+    }
+
+    if(!builder->owned) { // move out of the initial buffer
+        memcpy(buf, builder->buf, builder->len + 1);
+        builder->owned = true;
+    }
+
+    builder->buf = buf;
+    builder->cap = cap;
+
+    return CU_OK;
+}
+
+cu_err_t estr_b_view(estr_builder_t* builder, estr_view_t view) {
+    if(!builder || !view.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err = estr_b_reserve(builder, view.len);
+
+    if(err == CU_OK) {
+        memcpy(builder->buf + builder->len, view.ptr, view.len);
+        _b_advance(builder, view.len);
+    }
+
+    return err;
+}
+
+cu_err_t estr_b_chr(estr_builder_t* builder, char chr) {
+    return estr_b_view(builder, (estr_view_t) { .ptr = &chr, .len = 1 });
+}
+
+cu_err_t estr_b_str(estr_builder_t* builder, const char* str) {
+    if(!str) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    return estr_b_view(builder, estr_view(str));
+}
+
+cu_err_t estr_b_repeat(estr_builder_t* builder, char chr, size_t times) {
+    cu_err_t err = estr_b_reserve(builder, times);
+
+    if(err == CU_OK) {
+        memset(builder->buf + builder->len, chr, times);
+        _b_advance(builder, times);
+    }
+
+    return err;
+}
+
+cu_err_t estr_b_u64(estr_builder_t* builder, uint64_t num) {
+    char buf[ESTR_FMT_U64_SIZE];
+    return estr_b_view(builder, (estr_view_t) { .ptr = buf, .len = estr_fmt_u64(num, buf, sizeof(buf)) });
+}
+
+cu_err_t estr_b_i64(estr_builder_t* builder, int64_t num) {
+    char buf[ESTR_FMT_I64_SIZE];
+    return estr_b_view(builder, (estr_view_t) { .ptr = buf, .len = estr_fmt_i64(num, buf, sizeof(buf)) });
+}
+
+cu_err_t estr_b_hex(estr_builder_t* builder, uint64_t num) {
+    char buf[ESTR_FMT_HEX_SIZE];
+    return estr_b_view(builder, (estr_view_t) { .ptr = buf, .len = estr_fmt_hex(num, buf, sizeof(buf)) });
+}
+
+cu_err_t estr_b_f64(estr_builder_t* builder, double num) {
+    char buf[ESTR_FMT_F64_SIZE];
+    return estr_b_view(builder, (estr_view_t) { .ptr = buf, .len = estr_fmt_f64(num, buf, sizeof(buf)) });
+}
+
+cu_err_t estr_b_url_encode(estr_builder_t* builder, const char* str) {
+    if(!str) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    return estr_b_v_url_encode(builder, estr_view(str));
+}
+
+cu_err_t estr_b_v_url_encode(estr_builder_t* builder, estr_view_t view) {
+    if(!view.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t encoded_len = _url_encoded_len(view.ptr, view.len);
+    cu_err_t err = encoded_len == SIZE_MAX ? CU_ERR_NO_MEM : estr_b_reserve(builder, encoded_len);
+
+    if(err == CU_OK) {
+        _url_encode(view.ptr, view.len, builder->buf + builder->len);
+        _b_advance(builder, encoded_len);
+    }
+
+    return err;
+}
+
+cu_err_t _estr_b_cat(estr_builder_t* builder, const char* str, ...) {
+    cu_err_t err = CU_OK;
+    va_list args;
+    va_start(args, str);
+
+    for(; str && err == CU_OK; str = va_arg(args, const char*)) {
+        err = estr_b_str(builder, str);
+    }
+
+    va_end(args);
+    return err;
+}
+
+char* estr_b_finish(estr_builder_t* builder) {
+    if(!builder) {
+        return NULL;
+    }
+
+    char* result = NULL;
+
+    if(!builder->failed) {
+        if(builder->owned) {
+            result = builder->buf;
+            builder->owned = false;
+        } else {
+            result = cu_alloc(&builder->allocator, builder->len + 1); // whole string, also after null characters
+
+            if(result) {
+                memcpy(result, builder->buf, builder->len + 1);
+            }
+        }
+    }
+
+    estr_b_free(builder);
+    return result;
+}
+
+void estr_b_free(estr_builder_t* builder) {
+    if(!builder) {
+        return;
+    }
+
+    cu_allocator_t allocator = builder->allocator;
+
+    if(builder->owned) {
+        cu_free(&allocator, builder->buf);
+    }
+
+    estr_b_init(builder, builder->initial, builder->initial_size, &allocator);
+}
+
+static inline uint64_t _load64_le(const char* ptr) {
+    uint64_t v;
+    memcpy(&v, ptr, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline bool _is_dec(char chr) {
+    return (uint8_t) (chr - '0') < 10;
+}
+
+/**
+ * @brief Check if all 8 characters (loaded as little-endian) are digits
+ */
+static inline bool _is_8_digits(uint64_t v) {
+    return (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+        == 0x3333333333333333ULL);
+}
+
+/**
+ * @brief Convert 8 digits (loaded as little-endian) to number
+ */
+static inline uint32_t _parse_8_digits(uint64_t v) {
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+        (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return (uint32_t) v;
+}
+
+/**
+ * @brief Convert decimal digits to number with overflow check
+ */
+static cu_err_t _parse_u64(const char* str, size_t len, uint64_t* out) {
+    uint64_t val = 0;
+    size_t i = 0;
+    bool overflow = false;
+
+    for(; i + 8 <= len; i += 8) {
+        uint64_t v = _load64_le(str + i);
+
+        if(!_is_8_digits(v)) {
+            break;
+        }
+
+        overflow |= __builtin_mul_overflow(val, 100000000ULL, &val);
+        overflow |= __builtin_add_overflow(val, _parse_8_digits(v), &val);
+    }
+
+    for(; i < len; i++) {
+        uint8_t digit = (uint8_t) str[i] - '0';
+
+        if(digit > 9) {
+            return CU_ERR_INVALID_CHAR;
+        }
+
+        overflow |= __builtin_mul_overflow(val, 10, &val);
+        overflow |= __builtin_add_overflow(val, digit, &val);
+    }
+
+    if(overflow) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    *out = val;
+    return CU_OK;
+}
+
+cu_err_t estr_to_u64(estr_view_t view, uint64_t* out) {
+    if(!view.ptr || !out) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len == 0) {
+        return CU_ERR_EMPTY_STRING;
+    }
+
+    return _parse_u64(view.ptr, view.len, out);
+}
+
+cu_err_t estr_to_i64(estr_view_t view, int64_t* out) {
+    if(!view.ptr || !out) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len == 0) {
+        return CU_ERR_EMPTY_STRING;
+    }
+
+    bool neg = view.ptr[0] == '-';
+    size_t sign = neg || view.ptr[0] == '+';
+
+    if(sign == view.len) {
+        return CU_ERR_INVALID_CHAR; // only sign
+    }
+
+    uint64_t val;
+    cu_err_t err = _parse_u64(view.ptr + sign, view.len - sign, &val);
+
+    if(err != CU_OK) {
+        return err;
+    }
+
+    if(val > (uint64_t) INT64_MAX + neg) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    *out = neg ? (int64_t) (0 - val) : (int64_t) val;
+    return CU_OK;
+}
+
+/**
+ * @brief Convert digits in base 2^bits with optional prefix (0 followed by prefix character)
+ */
+static cu_err_t _parse_pow2(estr_view_t view, char prefix, unsigned bits, uint64_t* out) {
+    if(!view.ptr || !out) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len >= 2 && view.ptr[0] == '0' && (view.ptr[1] | 0x20) == prefix) {
+        view = estr_v_sub(view, 2, view.len - 2);
+
+        if(view.len == 0) {
+            return CU_ERR_INVALID_CHAR; // only prefix
+        }
+    }
+
+    if(view.len == 0) {
+        return CU_ERR_EMPTY_STRING;
+    }
+
+    uint64_t val = 0;
+    bool overflow = false;
+
+    for(size_t i = 0; i < view.len; i++) {
+        uint8_t digit = _url_hex_val[(uint8_t) view.ptr[i]]; // hex digit value + 1
+
+        if(!digit || digit > (1u << bits)) {
+            return CU_ERR_INVALID_CHAR;
+        }
+
+        overflow |= val >> (64 - bits) != 0;
+        val = (val << bits) | (digit - 1);
+    }
+
+    if(overflow) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    *out = val;
+    return CU_OK;
+}
+
+cu_err_t estr_hex_to_u64(estr_view_t view, uint64_t* out) {
+    return _parse_pow2(view, 'x', 4, out);
+}
+
+cu_err_t estr_bin_to_u64(estr_view_t view, uint64_t* out) {
+    return _parse_pow2(view, 'b', 1, out);
+}
+
+#define _F64_MAX_DIGITS 780 /*<! More significant digits can't change the rounding (sticky digit is added) */
+
+cu_err_t estr_to_f64(estr_view_t view, double* out) {
+    if(!view.ptr || !out) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len == 0) {
+        return CU_ERR_EMPTY_STRING;
+    }
+
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char* str = view.ptr;
+    size_t len = view.len;
+    size_t i = 0;
+    bool neg = str[0] == '-';
+    i += neg || str[0] == '+';
+
+    size_t int_start = i;
+    while(i < len && _is_dec(str[i])) { i++; }
+    size_t int_len = i - int_start;
+    size_t frac_start = i, frac_len = 0;
+
+    if(i < len && str[i] == '.') {
+        frac_start = ++i;
+        while(i < len && _is_dec(str[i])) { i++; }
+        frac_len = i - frac_start;
+    }
+
+    if(int_len + frac_len == 0) {
+        return CU_ERR_INVALID_CHAR;
+    }
+
+    int64_t exp = 0;
+
+    if(i < len && (str[i] | 0x20) == 'e') {
+        bool exp_neg = ++i < len && str[i] == '-';
+        i += i < len && (str[i] == '-' || str[i] == '+');
+
+        if(i == len || !_is_dec(str[i])) {
+            return CU_ERR_INVALID_CHAR;
+        }
+
+        for(; i < len && _is_dec(str[i]); i++) {
+            if(exp < 100000) { exp = exp * 10 + (str[i] - '0'); } // way out of double's range anyway
+        }
+
+        exp = exp_neg ? -exp : exp;
+    }
+
+    if(i != len) {
+        return CU_ERR_INVALID_CHAR;
+    }
+
+    // collect significant digits (without leading zeros)
+    char digits[_F64_MAX_DIGITS + 1];
+    size_t ndigits = 0;
+    bool truncated = false;
+    uint64_t mantissa = 0;
+    int64_t dexp = exp - (int64_t) frac_len;
+
+    for(size_t j = int_start; j < frac_start + frac_len; j++) {
+        if(str[j] == '.' || (ndigits == 0 && str[j] == '0')) {
+            continue;
+        }
+
+        if(ndigits < _F64_MAX_DIGITS) {
+            if(ndigits < 19) { mantissa = mantissa * 10 + (str[j] - '0'); }
+            digits[ndigits++] = str[j];
+        } else {
+            truncated |= str[j] != '0';
+            dexp++; // value of dropped digit moves into the exponent
+        }
+    }
+
+    double val;
+
+    if(ndigits == 0) {
+        val = 0;
+    } else if(ndigits <= 19 && mantissa <= (1ULL << 53) && dexp >= -22 && dexp <= 22) { // exact (Clinger's fast path)
+        val = (double) mantissa;
+        val = dexp < 0 ? val / pow10[-dexp] : val * pow10[dexp];
+    } else { // normalized form without decimal point, so strtod does not depend on locale
+        char buf[_F64_MAX_DIGITS + 32];
+        memcpy(buf, digits, ndigits);
+
+        if(truncated) { // sticky digit, so that rounding sees the rest is not zero
+            buf[ndigits++] = '1';
+            dexp--;
+        }
+
+        // digits after the point of the normalized form are counted into the exponent
+        buf[ndigits++] = 'e';
+        estr_fmt_i64(dexp, buf + ndigits, sizeof(buf) - ndigits);
+        val = strtod(buf, NULL);
+    }
+
+    if(isinf(val)) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    *out = neg ? -val : val;
+    return CU_OK;
+}
+
+static const char _digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const char _hex_digits[16] = "0123456789abcdef";
+
+/**
+ * @brief Number of decimal digits
+ */
+static inline size_t _u64_digits(uint64_t num) {
+    size_t digits = 1;
+
+    for(;;) {
+        if(num < 10) { return digits; }
+        if(num < 100) { return digits + 1; }
+        if(num < 1000) { return digits + 2; }
+        if(num < 10000) { return digits + 3; }
+        num /= 10000;
+        digits += 4;
+    }
+}
+
+/**
+ * @brief Write exactly len decimal digits of num which end at the end pointer
+ */
+static inline void _write_digits(uint64_t num, char* end, size_t len) {
+    while(len >= 2) {
+        memcpy(end -= 2, &_digit_pairs[(num % 100) * 2], 2);
+        num /= 100;
+        len -= 2;
+    }
+
+    if(len) {
+        *--end = '0' + num;
+    }
+}
+
+size_t estr_fmt_u64(uint64_t num, char* buf, size_t size) {
+    size_t len = _u64_digits(num);
+
+    if(!buf || size <= len) {
+        return 0;
+    }
+
+    _write_digits(num, buf + len, len);
+    buf[len] = '\0';
+
+    return len;
+}
+
+size_t estr_fmt_i64(int64_t num, char* buf, size_t size) {
+    if(num >= 0) {
+        return estr_fmt_u64(num, buf, size);
+    }
+
+    uint64_t abs = -(uint64_t) num;
+    size_t len = _u64_digits(abs) + 1;
+
+    if(!buf || size <= len) {
+        return 0;
+    }
+
+    buf[0] = '-';
+    _write_digits(abs, buf + len, len - 1);
+    buf[len] = '\0';
+
+    return len;
+}
+
+size_t estr_fmt_hex(uint64_t num, char* buf, size_t size) {
+    size_t len = num ? (size_t) (64 - __builtin_clzll(num) + 3) / 4 : 1;
+
+    if(!buf || size <= len) {
+        return 0;
+    }
+
+    buf[len] = '\0';
+
+    for(size_t i = len; i > 0; num >>= 4) {
+        buf[--i] = _hex_digits[num & 0xF];
+    }
+
+    return len;
+}
+
+/**
+ * @brief Floating point number f * 2^e with 64-bit significand (Grisu)
+ */
+typedef struct {
+    uint64_t f;
+    int e;
+} _diyfp_t;
+
+#define _DBL_HIDDEN_BIT 0x0010000000000000ULL
+#define _DBL_SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFULL
+#define _DBL_SIGNIFICAND_SIZE 52
+#define _DBL_EXPONENT_BIAS (0x3FF + _DBL_SIGNIFICAND_SIZE)
+
+/**
+ * @brief Normalized 10^(-348 + 8 * i) for i in range [0, 87)
+ */
+static const uint64_t _cached_powers_f[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+};
+
+static const int16_t _cached_powers_e[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066,
+};
+
+static const uint64_t _pow10_u64[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+static inline _diyfp_t _diyfp_mul(_diyfp_t x, _diyfp_t y) {
+    const uint64_t m32 = 0xFFFFFFFFULL;
+    uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & m32) + (bc & m32) + (1ULL << 31); // rounded
+
+    return (_diyfp_t) { .f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), .e = x.e + y.e + 64 };
+}
+
+static inline _diyfp_t _diyfp_normalize(_diyfp_t x) {
+    int shift = __builtin_clzll(x.f);
+    return (_diyfp_t) { .f = x.f << shift, .e = x.e - shift };
+}
+
+/**
+ * @brief Move last digit towards w while it stays in the safe interval. Fails if the result can't be proven
+ *        to be in the rounding interval and closest to w, because scaled values are imprecise by unit
+ */
+static inline bool _grisu_weed(char* buf, size_t len, uint64_t too_high_w, uint64_t unsafe, uint64_t rest,
+    uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small = too_high_w - unit, big = too_high_w + unit;
+
+    while(rest < small && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < small || small - rest >= rest + ten_kappa - small)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+
+    if(rest < big && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < big || big - rest > rest + ten_kappa - big)) {
+        return false; // one digit lower might be closer
+    }
+
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+/**
+ * @brief Generate shortest digits of w in the unsafe interval (low - unit, high + unit), value is digits * 10^k.
+ *        First length with any digits in the unsafe interval is never longer than the shortest one
+ */
+static bool _grisu_digits(_diyfp_t low, _diyfp_t w, _diyfp_t high, char* buf, size_t* len, int* k) {
+    const _diyfp_t one = { .f = 1ULL << -w.e, .e = w.e };
+    uint64_t unit = 1;
+    uint64_t too_high = high.f + unit;
+    uint64_t unsafe = too_high - (low.f - unit);
+    uint32_t p1 = (uint32_t) (too_high >> -one.e);
+    uint64_t p2 = too_high & (one.f - 1);
+    int kappa = (int) _u64_digits(p1);
+    *len = 0;
+
+    while(kappa > 0) {
+        uint64_t div = _pow10_u64[kappa - 1];
+        buf[(*len)++] = '0' + p1 / div;
+        p1 %= div;
+        kappa--;
+        uint64_t rest = ((uint64_t) p1 << -one.e) + p2;
+
+        if(rest < unsafe) {
+            *k += kappa;
+            return _grisu_weed(buf, *len, too_high - w.f, unsafe, rest, div << -one.e, unit);
+        }
+    }
+
+    for(;;) {
+        p2 *= 10;
+        unit *= 10;
+        unsafe *= 10;
+        buf[(*len)++] = '0' + (char) (p2 >> -one.e);
+        p2 &= one.f - 1;
+        kappa--;
+
+        if(p2 < unsafe) {
+            *k += kappa;
+            return _grisu_weed(buf, *len, (too_high - w.f) * unit, unsafe, p2, one.f, unit);
+        }
+    }
+}
+
+/**
+ * @brief Shortest digits of positive finite num closest to it, value is digits * 10^k (Grisu3).
+ *        Fails for about 0.5% of doubles, for which the digits can't be proven with 64-bit arithmetic
+ */
+static bool _grisu3(double num, char* buf, size_t* len, int* k) {
+    uint64_t bits;
+    memcpy(&bits, &num, sizeof(bits));
+
+    int biased_e = (int) ((bits >> _DBL_SIGNIFICAND_SIZE) & 0x7FF);
+    _diyfp_t v = biased_e
+        ? (_diyfp_t) { .f = (bits & _DBL_SIGNIFICAND_MASK) + _DBL_HIDDEN_BIT, .e = biased_e - _DBL_EXPONENT_BIAS }
+        : (_diyfp_t) { .f = bits & _DBL_SIGNIFICAND_MASK, .e = 1 - _DBL_EXPONENT_BIAS };
+
+    // boundaries m- and m+ of the rounding interval, with the same exponent
+    _diyfp_t mp = { .f = (v.f << 1) + 1, .e = v.e - 1 };
+    while(!(mp.f & (_DBL_HIDDEN_BIT << 1))) { mp.f <<= 1; mp.e--; }
+    mp.f <<= 64 - _DBL_SIGNIFICAND_SIZE - 2;
+    mp.e -= 64 - _DBL_SIGNIFICAND_SIZE - 2;
+
+    _diyfp_t mm = v.f == _DBL_HIDDEN_BIT && biased_e > 1 // lower neighbour is closer
+        ? (_diyfp_t) { .f = (v.f << 2) - 1, .e = v.e - 2 }
+        : (_diyfp_t) { .f = (v.f << 1) - 1, .e = v.e - 1 };
+    mm.f <<= mm.e - mp.e;
+    mm.e = mp.e;
+
+    // cached power which brings exponent of the product into [-60, -32]
+    double dk = (-61 - mp.e) * 0.30102999566398114 + 347;
+    int ik = (int) dk;
+    ik += dk - ik > 0.0;
+    unsigned index = (unsigned) ((ik >> 3) + 1);
+    _diyfp_t c_mk = { .f = _cached_powers_f[index], .e = _cached_powers_e[index] };
+    *k = -(-348 + (int) index * 8);
+
+    _diyfp_t w = _diyfp_mul(_diyfp_normalize(v), c_mk);
+    _diyfp_t wp = _diyfp_mul(mp, c_mk);
+    _diyfp_t wm = _diyfp_mul(mm, c_mk);
+
+    return _grisu_digits(wm, w, wp, buf, len, k);
+}
+
+/**
+ * @brief Unsigned big integer, large enough for any double scaled by the power of ten (up to about 2^1100)
+ */
+typedef struct {
+    uint32_t limbs[40];
+    size_t len;
+} _bignum_t;
+
+static void _bignum_set(_bignum_t* num, uint64_t val) {
+    num->limbs[0] = (uint32_t) val;
+    num->limbs[1] = (uint32_t) (val >> 32);
+    num->len = val >> 32 ? 2 : (val ? 1 : 0);
+}
+
+static void _bignum_mul(_bignum_t* num, uint32_t factor) {
+    uint64_t carry = 0;
+
+    for(size_t i = 0; i < num->len; i++) {
+        carry += (uint64_t) num->limbs[i] * factor;
+        num->limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+
+    if(carry) {
+        num->limbs[num->len++] = (uint32_t) carry;
+    }
+}
+
+static void _bignum_mul_pow2(_bignum_t* num, int exp) {
+    for(; exp >= 31; exp -= 31) {
+        _bignum_mul(num, 1U << 31);
+    }
+
+    _bignum_mul(num, 1U << exp);
+}
+
+static void _bignum_mul_pow10(_bignum_t* num, int exp) {
+    for(; exp >= 9; exp -= 9) {
+        _bignum_mul(num, 1000000000U);
+    }
+
+    _bignum_mul(num, (uint32_t) _pow10_u64[exp]);
+}
+
+static void _bignum_add(const _bignum_t* a, const _bignum_t* b, _bignum_t* sum) {
+    size_t len = a->len > b->len ? a->len : b->len;
+    uint64_t carry = 0;
+
+    for(size_t i = 0; i < len; i++) {
+        carry += (uint64_t) (i < a->len ? a->limbs[i] : 0) + (i < b->len ? b->limbs[i] : 0);
+        sum->limbs[i] = (uint32_t) carry;
+        carry >>= 32;
+    }
+
+    sum->len = len;
+
+    if(carry) {
+        sum->limbs[sum->len++] = (uint32_t) carry;
+    }
+}
+
+/**
+ * @brief a -= b, where a >= b
+ */
+static void _bignum_sub(_bignum_t* a, const _bignum_t* b) {
+    uint64_t borrow = 0;
+
+    for(size_t i = 0; i < a->len; i++) {
+        uint64_t diff = (uint64_t) a->limbs[i] - (i < b->len ? b->limbs[i] : 0) - borrow;
+        a->limbs[i] = (uint32_t) diff;
+        borrow = diff >> 63;
+    }
+
+    while(a->len > 0 && !a->limbs[a->len - 1]) {
+        a->len--;
+    }
+}
+
+static int _bignum_cmp(const _bignum_t* a, const _bignum_t* b) {
+    if(a->len != b->len) {
+        return a->len < b->len ? -1 : 1;
+    }
+
+    for(size_t i = a->len; i-- > 0;) {
+        if(a->limbs[i] != b->limbs[i]) {
+            return a->limbs[i] < b->limbs[i] ? -1 : 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Shortest digits of positive finite num closest to it, value is digits * 10^k. Exact (Dragon4
+ *        with free-format termination by Burger and Dybvig), so it's used only for the values Grisu3 fails on.
+ *        Value is r / s, boundaries of the rounding interval are at distances m- and m+ (all scaled by 2 or 4).
+ *        Boundaries are included when significand is even, because such value is chosen by round-half-even parsing
+ */
+static size_t _dragon4(double num, char* buf, int* k) {
+    uint64_t bits;
+    memcpy(&bits, &num, sizeof(bits));
+
+    int biased_e = (int) ((bits >> _DBL_SIGNIFICAND_SIZE) & 0x7FF);
+    uint64_t f = biased_e ? (bits & _DBL_SIGNIFICAND_MASK) + _DBL_HIDDEN_BIT : bits & _DBL_SIGNIFICAND_MASK;
+    int e = biased_e ? biased_e - _DBL_EXPONENT_BIAS : 1 - _DBL_EXPONENT_BIAS;
+    bool closer = f == _DBL_HIDDEN_BIT && biased_e > 1; // lower neighbour is closer
+    bool even = !(f & 1);
+
+    _bignum_t r, s, mp, mm, tmp;
+    _bignum_set(&r, f << (closer ? 2 : 1));
+    _bignum_set(&s, closer ? 4 : 2);
+    _bignum_set(&mp, closer ? 2 : 1);
+    _bignum_set(&mm, 1);
+
+    if(e >= 0) {
+        _bignum_mul_pow2(&r, e);
+        _bignum_mul_pow2(&mp, e);
+        _bignum_mul_pow2(&mm, e);
+    } else {
+        _bignum_mul_pow2(&s, -e);
+    }
+
+    // estimate of k (10^(k-1) <= num < 10^k) is never too big and at most one too small
+    int exp10 = (int) ((e + 63 - __builtin_clzll(f)) * 0.30102999566398114 - 1e-10);
+    exp10 += (e + 63 - __builtin_clzll(f)) * 0.30102999566398114 - 1e-10 > exp10;
+
+    if(exp10 >= 0) {
+        _bignum_mul_pow10(&s, exp10);
+    } else {
+        _bignum_mul_pow10(&r, -exp10);
+        _bignum_mul_pow10(&mp, -exp10);
+        _bignum_mul_pow10(&mm, -exp10);
+    }
+
+    for(;;) { // upper boundary must be below 1 (0.d1d2... * 10^k)
+        _bignum_add(&r, &mp, &tmp);
+        int cmp = _bignum_cmp(&tmp, &s);
+
+        if(even ? cmp < 0 : cmp <= 0) {
+            break;
+        }
+
+        _bignum_mul(&s, 10);
+        exp10++;
+    }
+
+    size_t len = 0;
+
+    for(;;) {
+        _bignum_mul(&r, 10);
+        _bignum_mul(&mp, 10);
+        _bignum_mul(&mm, 10);
+
+        char digit = 0;
+
+        while(_bignum_cmp(&r, &s) >= 0) {
+            _bignum_sub(&r, &s);
+            digit++;
+        }
+
+        _bignum_add(&r, &mp, &tmp);
+        int cmp_low = _bignum_cmp(&r, &mm);
+        int cmp_high = _bignum_cmp(&tmp, &s);
+        bool low = even ? cmp_low <= 0 : cmp_low < 0;   // rest of the digits can be dropped
+        bool high = even ? cmp_high >= 0 : cmp_high > 0; // digit can be rounded up
+
+        if(!low && !high) {
+            buf[len++] = '0' + digit;
+            continue;
+        }
+
+        if(low && high) { // closer one, tie goes to the even digit
+            _bignum_add(&r, &r, &tmp);
+            int cmp = _bignum_cmp(&tmp, &s);
+            high = cmp > 0 || (cmp == 0 && (digit & 1));
+        }
+
+        buf[len++] = '0' + digit + high;
+        break;
+    }
+
+    *k = exp10 - (int) len;
+    return len;
+}
+
+size_t estr_fmt_f64(double num, char* buf, size_t size) {
+    char out[ESTR_FMT_F64_SIZE];
+    char* ptr = out;
+    uint64_t bits;
+    memcpy(&bits, &num, sizeof(bits));
+
+    if(bits >> 63) {
+        *ptr++ = '-';
+        num = -num;
+    }
+
+    if(num != num) {
+        memcpy(out, "nan", 3); // sign of nan is not shown
+        ptr = out + 3;
+    } else if(num == __builtin_inf()) {
+        memcpy(ptr, "inf", 3);
+        ptr += 3;
+    } else if(num == 0) {
+        *ptr++ = '0';
+    } else {
+        int k;
+        size_t len;
+
+        if(!_grisu3(num, ptr, &len, &k)) {
+            len = _dragon4(num, ptr, &k);
+        }
+
+        int kk = (int) len + k; // position of the decimal point
+
+        if(k >= 0 && kk <= 21) { // 1234e7 -> 12340000000
+            memset(ptr + len, '0', k);
+            ptr += kk;
+        } else if(kk > 0 && kk <= 21) { // 1234e-2 -> 12.34
+            memmove(ptr + kk + 1, ptr + kk, len - kk);
+            ptr[kk] = '.';
+            ptr += len + 1;
+        } else if(kk > -6 && kk <= 0) { // 1234e-6 -> 0.001234
+            size_t offset = 2 - kk;
+            memmove(ptr + offset, ptr, len);
+            ptr[0] = '0';
+            ptr[1] = '.';
+            memset(ptr + 2, '0', offset - 2);
+            ptr += offset + len;
+        } else { // 1234e30 -> 1.234e+33
+            if(len > 1) {
+                memmove(ptr + 2, ptr + 1, len - 1);
+                ptr[1] = '.';
+                len++;
+            }
+
+            ptr += len;
+            *ptr++ = 'e';
+            *ptr++ = kk - 1 < 0 ? '-' : '+';
+            ptr += estr_fmt_u64(kk - 1 < 0 ? 1 - kk : kk - 1, ptr, out + sizeof(out) - ptr);
+        }
+    }
+
+    size_t len = ptr - out;
+
+    if(!buf || size <= len) {
+        return 0;
+    }
+
+    memcpy(buf, out, len);
+    buf[len] = '\0';
+
+    return len;
+}
+
+#define _XXH_P1 0x9E3779B185EBCA87ULL
+#define _XXH_P2 0xC2B2AE3D27D4EB4FULL
+#define _XXH_P3 0x165667B19E3779F9ULL
+#define _XXH_P4 0x85EBCA77C2B2AE63ULL
+#define _XXH_P5 0x27D4EB2F165667C5ULL
+
+#define _rotl64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+static inline uint32_t _load32_le(const uint8_t* ptr) {
+    uint32_t v;
+    memcpy(&v, ptr, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint64_t _xxh_round(uint64_t acc, uint64_t input) {
+    acc += input * _XXH_P2;
+    acc = _rotl64(acc, 31);
+    return acc * _XXH_P1;
+}
+
+static inline uint64_t _xxh_merge(uint64_t acc, uint64_t val) {
+    acc ^= _xxh_round(0, val);
+    return acc * _XXH_P1 + _XXH_P4;
+}
+
+/**
+ * @brief Consume whole 32-byte stripes, return number of consumed bytes
+ */
+static inline size_t _xxh_stripes(uint64_t acc[4], const uint8_t* ptr, size_t len) {
+    const uint8_t* end = ptr + (len & ~(size_t) 31);
+    const uint8_t* start = ptr;
+    uint64_t a0 = acc[0], a1 = acc[1], a2 = acc[2], a3 = acc[3];
+
+    // lanes don't depend on each other, so the multiplications overlap
+    for(; ptr < end; ptr += 32) {
+        a0 = _xxh_round(a0, _load64_le((const char*) ptr));
+        a1 = _xxh_round(a1, _load64_le((const char*) ptr + 8));
+        a2 = _xxh_round(a2, _load64_le((const char*) ptr + 16));
+        a3 = _xxh_round(a3, _load64_le((const char*) ptr + 24));
+    }
+
+    acc[0] = a0; acc[1] = a1; acc[2] = a2; acc[3] = a3;
+    return ptr - start;
+}
+
+static inline void _xxh_init(uint64_t acc[4], uint64_t seed) {
+    acc[0] = seed + _XXH_P1 + _XXH_P2;
+    acc[1] = seed + _XXH_P2;
+    acc[2] = seed;
+    acc[3] = seed - _XXH_P1;
+}
+
+/**
+ * @brief Mix lanes (or seed for short input) with the remaining tail (less than 32 bytes)
+ */
+static uint64_t _xxh_finalize(const uint64_t* acc, uint64_t seed, uint64_t total_len, const uint8_t* ptr, size_t len) {
+    uint64_t h;
+
+    if(total_len >= 32) {
+        h = _rotl64(acc[0], 1) + _rotl64(acc[1], 7) + _rotl64(acc[2], 12) + _rotl64(acc[3], 18);
+        h = _xxh_merge(h, acc[0]);
+        h = _xxh_merge(h, acc[1]);
+        h = _xxh_merge(h, acc[2]);
+        h = _xxh_merge(h, acc[3]);
+    } else {
+        h = seed + _XXH_P5;
+    }
+
+    h += total_len;
+
+    for(; len >= 8; ptr += 8, len -= 8) {
+        h ^= _xxh_round(0, _load64_le((const char*) ptr));
+        h = _rotl64(h, 27) * _XXH_P1 + _XXH_P4;
+    }
+
+    if(len >= 4) {
+        h ^= (uint64_t) _load32_le(ptr) * _XXH_P1;
+        h = _rotl64(h, 23) * _XXH_P2 + _XXH_P3;
+        ptr += 4;
+        len -= 4;
+    }
+
+    for(; len > 0; ptr++, len--) {
+        h ^= *ptr * _XXH_P5;
+        h = _rotl64(h, 11) * _XXH_P1;
+    }
+
+    h ^= h >> 33;
+    h *= _XXH_P2;
+    h ^= h >> 29;
+    h *= _XXH_P3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+uint64_t estr_hash64(const void* ptr, size_t len, uint64_t seed) {
+    const uint8_t* bytes = ptr;
+    uint64_t acc[4] = { 0 };
+    size_t consumed = 0;
+
+    if(len >= 32) {
+        _xxh_init(acc, seed);
+        consumed = _xxh_stripes(acc, bytes, len);
+    }
+
+    return _xxh_finalize(acc, seed, len, bytes + consumed, len - consumed);
+}
+
+cu_err_t estr_hasher_init(estr_hasher_t* hasher, uint64_t seed) {
+    if(!hasher) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    *hasher = (estr_hasher_t) { .seed = seed };
+    _xxh_init(hasher->acc, seed);
+
+    return CU_OK;
+}
+
+cu_err_t estr_hasher_update(estr_hasher_t* hasher, const void* ptr, size_t len) {
+    if(!hasher || (!ptr && len > 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    const uint8_t* bytes = ptr;
+    hasher->total_len += len;
+
+    if(hasher->buf_len + len < sizeof(hasher->buf)) {
+        if(len > 0) {
+            memcpy(hasher->buf + hasher->buf_len, bytes, len);
+            hasher->buf_len += len;
+        }
+
+        return CU_OK;
+    }
+
+    if(hasher->buf_len > 0) { // complete buffered stripe
+        size_t fill = sizeof(hasher->buf) - hasher->buf_len;
+        memcpy(hasher->buf + hasher->buf_len, bytes, fill);
+        _xxh_stripes(hasher->acc, hasher->buf, sizeof(hasher->buf));
+        bytes += fill;
+        len -= fill;
+        hasher->buf_len = 0;
+    }
+
+    size_t consumed = _xxh_stripes(hasher->acc, bytes, len);
+
+    if(consumed < len) {
+        memcpy(hasher->buf, bytes + consumed, len - consumed);
+        hasher->buf_len = len - consumed;
+    }
+
+    return CU_OK;
+}
+
+uint64_t estr_hasher_digest(const estr_hasher_t* hasher) {
+    if(!hasher) {
+        return 0;
+    }
+
+    return _xxh_finalize(hasher->acc, hasher->seed, hasher->total_len, hasher->buf, hasher->buf_len);
+}
+
+cu_err_t estr_s_init(estr_t* s, const char* str) {
+    if(!str) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    return estra_s_init_view(s, estr_view(str), NULL);
+}
+
+cu_err_t estr_s_init_view(estr_t* s, estr_view_t view) {
+    return estra_s_init_view(s, view, NULL);
+}
+
+cu_err_t estra_s_init_view(estr_t* s, estr_view_t view, const cu_allocator_t* allocator) {
+    if(!s || !view.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len <= ESTR_SSO_CAPACITY) {
+        memcpy(s->sso, view.ptr, view.len);
+        s->sso[view.len] = '\0';
+        s->sso[ESTR_SSO_CAPACITY + 1] = (char) view.len;
+        return CU_OK;
+    }
+
+    char* ptr = NULL;
+    cu_mem_checkr(ptr = cu_alloc(allocator, view.len + 1));
+    memcpy(ptr, view.ptr, view.len);
+    ptr[view.len] = '\0';
+
+    s->heap.ptr = ptr;
+    s->heap.len = view.len;
+    s->sso[ESTR_SSO_CAPACITY + 1] = (char) ESTR_SSO_HEAP;
+
+    return CU_OK;
+}
+
+bool estr_s_eq(const estr_t* s1, const estr_t* s2) {
+    if(!s1 || !s2) {
+        return false;
+    }
+
+    return estr_v_eq(estr_s_view(s1), estr_s_view(s2));
+}
+
+void estr_s_free(estr_t* s) {
+    estra_s_free(s, NULL);
+}
+
+void estra_s_free(estr_t* s, const cu_allocator_t* allocator) {
+    if(!s) {
+        return;
+    }
+
+    if(!estr_s_is_inline(s)) {
+        cu_free(allocator, s->heap.ptr);
+    }
+
+    *s = (estr_t) { 0 };
+}
+
+void estr_s_list_free(estr_t* list, size_t len) {
+    estra_s_list_free(list, len, NULL);
+}
+
+void estra_s_list_free(estr_t* list, size_t len, const cu_allocator_t* allocator) {
+    if(!list) {
+        return;
+    }
+
+    for(size_t i = 0; i < len; i++) {
+        estra_s_free(&list[i], allocator);
+    }
+
+    cu_free(allocator, list);
+}
+
+enum {
+    _SCHEMA_SCAN_NONE,    /*<! Every character is allowed */
+    _SCHEMA_SCAN_NON_WS,  /*<! Every character except whitespace */
+    _SCHEMA_SCAN_DIGITS,  /*<! Only digits */
+    _SCHEMA_SCAN_BITMAP   /*<! Any other set, checked with bitmap */
+};
+
+#define _bitmap_has(bitmap, chr) (((bitmap)[(uint8_t) (chr) >> 6] >> ((uint8_t) (chr) & 63)) & 1)
+#define _bitmap_set(bitmap, chr) ((bitmap)[(uint8_t) (chr) >> 6] |= 1ULL << ((uint8_t) (chr) & 63))
+#define _bitmap_clear(bitmap, chr) ((bitmap)[(uint8_t) (chr) >> 6] &= ~(1ULL << ((uint8_t) (chr) & 63)))
+
+static inline bool _is_ws_chr(char chr) {
+    return chr == ' ' || (chr >= '\t' && chr <= '\r');
+}
+
+cu_err_t estr_schema_compile(const estr_validation_t* validation, estr_schema_t* schema) {
+    if(!validation || !schema) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    estr_schema_t _schema = {
+        .maxlen = SIZE_MAX,
+        .allowed = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX },
+        .no_whitespace = validation->no_whitespace,
+        .utf8 = validation->utf8,
+        .prefix = validation->prefix,
+        .prefix_len = validation->prefix ? strlen(validation->prefix) : 0,
+        .suffix = validation->suffix,
+        .suffix_len = validation->suffix ? strlen(validation->suffix) : 0
+    };
+
+    if(validation->length) {
+        _schema.minlen = validation->minlen;
+        _schema.maxlen = validation->minlen > 0 && validation->maxlen == 0 ? validation->minlen : validation->maxlen;
+    }
+
+    if(validation->charset) {
+        uint64_t charset[4] = { 0 };
+        const char* ptr = validation->charset;
+
+        for(; *ptr; ptr++) {
+            if(ptr[1] == '-' && ptr[2]) { // range
+                if((uint8_t) ptr[0] > (uint8_t) ptr[2]) {
+                    return CU_ERR_INVALID_ARG;
+                }
+
+                for(unsigned chr = (uint8_t) ptr[0]; chr <= (uint8_t) ptr[2]; chr++) {
+                    _bitmap_set(charset, chr);
+                }
+
+                ptr += 2;
+            } else {
+                _bitmap_set(charset, *ptr);
+            }
+        }
+
+        memcpy(_schema.allowed, charset, sizeof(charset));
+    }
+
+    if(validation->digits_only) {
+        for(int i = 0; i < 4; i++) {
+            _schema.allowed[i] &= i == 0 ? 0x03FF000000000000ULL : 0; // '0' - '9'
+        }
+    }
+
+    if(validation->no_whitespace) {
+        _bitmap_clear(_schema.allowed, ' ');
+        for(char chr = '\t'; chr <= '\r'; chr++) { _bitmap_clear(_schema.allowed, chr); }
+    }
+
+    // pick the vectorized kernel if allowed set is the one it checks
+    uint64_t non_ws0 = ~(1ULL << ' ' | 0x3E00ULL);
+
+    if((_schema.allowed[0] & _schema.allowed[1] & _schema.allowed[2] & _schema.allowed[3]) == UINT64_MAX) {
+        _schema.scan = _SCHEMA_SCAN_NONE;
+    } else if(_schema.allowed[0] == non_ws0 && (_schema.allowed[1] & _schema.allowed[2] & _schema.allowed[3]) == UINT64_MAX) {
+        _schema.scan = _SCHEMA_SCAN_NON_WS;
+    } else if(_schema.allowed[0] == 0x03FF000000000000ULL && !(_schema.allowed[1] | _schema.allowed[2] | _schema.allowed[3])) {
+        _schema.scan = _SCHEMA_SCAN_DIGITS;
+    } else {
+        _schema.scan = _SCHEMA_SCAN_BITMAP;
+    }
+
+    *schema = _schema;
+    return CU_OK;
+}
+
+/**
+ * @brief Disallowed whitespace is reported before any other failed check (as estr_validate always did).
+ *        Whitespace is searched here only on failure, so valid views are still scanned once
+ */
+static cu_err_t _schema_error(estr_view_t view, const estr_schema_t* schema, cu_err_t err) {
+    if(schema->no_whitespace && estr_scan()->find_ws(view.ptr, view.len) < view.len) {
+        return CU_ERR_ESTR_INVALID_WHITESPACE;
+    }
+
+    return err;
+}
+
+#define _SCHEMA_BLOCK 4096  /*<! Size of the block which is scanned for whitespace and UTF-8 while it's in L1 cache */
+
+/**
+ * @brief Whitespace and UTF-8 checks fused into one pass over memory: both kernels scan the same block in turn.
+ *        Block ends before a lead byte, so valid sequence is never split between two blocks
+ * @return Index of the first whitespace or len. utf8_valid is cleared if any sequence is invalid
+ */
+static size_t _find_ws_utf8(const char* str, size_t len, bool* utf8_valid) {
+    const estr_scan_t* scan = estr_scan();
+    *utf8_valid = true;
+
+    for(size_t i = 0; i < len;) {
+        size_t end = len - i > _SCHEMA_BLOCK ? i + _SCHEMA_BLOCK : len;
+
+        for(int back = 0; back < 3 && end < len && ((uint8_t) str[end] & 0xC0) == 0x80; back++) {
+            end--; // continuation byte, longer runs are invalid anyway
+        }
+
+        size_t ws = scan->find_ws(str + i, end - i);
+
+        if(ws < end - i) {
+            return i + ws;
+        }
+
+        if(*utf8_valid && scan->find_utf8_invalid(str + i, end - i) < end - i) {
+            *utf8_valid = false; // rest is still searched for whitespace which is reported first
+        }
+
+        i = end;
+    }
+
+    return len;
+}
+
+cu_err_t estr_v_validate(estr_view_t view, const estr_schema_t* schema) {
+    if(!view.ptr || !schema) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(view.len < schema->minlen || view.len > schema->maxlen) {
+        return _schema_error(view, schema, CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS);
+    }
+
+    if(schema->prefix_len && !estr_v_sw(view, (estr_view_t) { .ptr = schema->prefix, .len = schema->prefix_len })) {
+        return _schema_error(view, schema, CU_ERR_ESTR_INVALID_PREFIX);
+    }
+
+    if(schema->suffix_len && !estr_v_ew(view, (estr_view_t) { .ptr = schema->suffix, .len = schema->suffix_len })) {
+        return _schema_error(view, schema, CU_ERR_ESTR_INVALID_SUFFIX);
+    }
+
+    size_t invalid = view.len;
+    bool utf8 = schema->utf8;
+
+    switch(schema->scan) {
+        case _SCHEMA_SCAN_NON_WS:
+            if(utf8) {
+                bool utf8_valid;
+                invalid = _find_ws_utf8(view.ptr, view.len, &utf8_valid);
+
+                if(invalid == view.len && !utf8_valid) {
+                    return CU_ERR_ESTR_INVALID_UTF8;
+                }
+
+                utf8 = false;
+            } else {
+                invalid = estr_scan()->find_ws(view.ptr, view.len);
+            }
+            break;
+        case _SCHEMA_SCAN_DIGITS: invalid = estr_scan()->find_non_digit(view.ptr, view.len); utf8 = false; break;
+        case _SCHEMA_SCAN_BITMAP:
+            // characters and UTF-8 sequences are checked in the same pass
+            for(size_t i = 0; i < view.len; i++) {
+                if(!_bitmap_has(schema->allowed, view.ptr[i])) {
+                    invalid = i;
+                    break;
+                }
+
+                if(utf8 && (uint8_t) view.ptr[i] >= 0x80) {
+                    size_t n = estr_utf8_seq((const uint8_t*) view.ptr + i, view.len - i);
+
+                    if(!n) {
+                        return _schema_error(view, schema, CU_ERR_ESTR_INVALID_UTF8);
+                    }
+
+                    for(size_t j = 1; j < n; j++) {
+                        if(!_bitmap_has(schema->allowed, view.ptr[i + j])) {
+                            invalid = i + j;
+                            break;
+                        }
+                    }
+
+                    if(invalid < view.len) {
+                        break;
+                    }
+
+                    i += n - 1;
+                }
+            }
+
+            utf8 = false;
+            break;
+    }
+
+    if(invalid < view.len) {
+        return schema->no_whitespace && _is_ws_chr(view.ptr[invalid])
+            ? CU_ERR_ESTR_INVALID_WHITESPACE
+            : _schema_error(view, schema, CU_ERR_ESTR_INVALID_CHAR);
+    }
+
+    if(utf8 && estr_scan()->find_utf8_invalid(view.ptr, view.len) < view.len) {
+        return CU_ERR_ESTR_INVALID_UTF8;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_validate(const char* str, const estr_validation_t* validation) {
+    if(!str || !validation) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err;
+    estr_schema_t schema;
+    cu_err_checkr(estr_schema_compile(validation, &schema));
+
+    return estr_v_validate(estr_view(str), &schema);
+}
+
+cu_err_t estr_validate_many(char* const* strs, size_t len, const estr_schema_t* schema, size_t* out_index) {
+    if((!strs && len > 0) || !schema) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    for(size_t i = 0; i < len; i++) {
+        cu_err_t err = strs[i] ? estr_v_validate(estr_view(strs[i]), schema) : CU_ERR_INVALID_ARG;
 
-        if(len < validation->minlen || len > validation->maxlen) {
-            return CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS;
+        if(err != CU_OK) {
+            if(out_index) { *out_index = i; }
+            return err;
         }
     }
 
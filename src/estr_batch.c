@@ -0,0 +1,175 @@
+#include "estr.h"
+#include <stdint.h>
+
+#define _BATCH_PREFETCH 8  /*<! Distance (in strings) of prefetching the characters of the next strings */
+
+/**
+ * @brief Match every string and pack results into 64 bit words which are stored once they are full.
+ *        Pointer list is read sequentially while the scattered characters are prefetched ahead
+ */
+static inline size_t _batch_strs(char* const* strs, size_t len, bool (*match)(const char* str, const void* arg),
+    const void* arg, uint64_t* bits) {
+    size_t count = 0;
+
+    for(size_t w = 0; w < ESTR_BATCH_WORDS(len); w++) {
+        size_t end = len - w * 64 < 64 ? len : w * 64 + 64;
+        uint64_t word = 0;
+
+        for(size_t i = w * 64; i < end; i++) {
+            if(i + _BATCH_PREFETCH < len) {
+                __builtin_prefetch(strs[i + _BATCH_PREFETCH]); // never faults, also for NULL
+            }
+
+            word |= (uint64_t) (strs[i] && match(strs[i], arg)) << (i % 64);
+        }
+
+        bits[w] = word;
+        count += __builtin_popcountll(word);
+    }
+
+    return count;
+}
+
+static inline size_t _batch_views(const estr_view_t* views, size_t len, bool (*match)(estr_view_t view, const void* arg),
+    const void* arg, uint64_t* bits) {
+    size_t count = 0;
+
+    for(size_t w = 0; w < ESTR_BATCH_WORDS(len); w++) {
+        size_t end = len - w * 64 < 64 ? len : w * 64 + 64;
+        uint64_t word = 0;
+
+        for(size_t i = w * 64; i < end; i++) {
+            if(i + _BATCH_PREFETCH < len) {
+                __builtin_prefetch(views[i + _BATCH_PREFETCH].ptr);
+            }
+
+            word |= (uint64_t) (views[i].ptr && match(views[i], arg)) << (i % 64);
+        }
+
+        bits[w] = word;
+        count += __builtin_popcountll(word);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Needle doesn't contain null character, so strncmp stops within the string
+ *        and the character after the compared ones is its terminator or the first different one
+ */
+static bool _eq_str(const char* str, const void* arg) {
+    const estr_view_t* needle = arg;
+    return (needle->len == 0 || str[0] == needle->ptr[0])
+        && strncmp(str, needle->ptr, needle->len) == 0 && str[needle->len] == '\0';
+}
+
+static bool _eq_view(estr_view_t view, const void* arg) {
+    const estr_view_t* needle = arg;
+    return view.len == needle->len && memcmp(view.ptr, needle->ptr, view.len) == 0;
+}
+
+static bool _validate_str(const char* str, const void* arg) {
+    return estr_v_validate(estr_view(str), arg) == CU_OK;
+}
+
+static bool _validate_view(estr_view_t view, const void* arg) {
+    return estr_v_validate(view, arg) == CU_OK;
+}
+
+static bool _find_str(const char* str, const void* arg) {
+    return estr_find(arg, str) != NULL;
+}
+
+static bool _find_view(estr_view_t view, const void* arg) {
+    return estr_v_find(arg, view) != NULL;
+}
+
+cu_err_t estr_batch_eq(char* const* strs, size_t len, estr_view_t needle, uint64_t* bits, size_t* out_count) {
+    if(((!strs || !bits) && len > 0) || !needle.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = 0;
+
+    if(!memchr(needle.ptr, '\0', needle.len)) {
+        count = _batch_strs(strs, len, &_eq_str, &needle, bits);
+    } else if(len > 0) { // no string contains null character
+        memset(bits, 0, ESTR_BATCH_WORDS(len) * sizeof(uint64_t));
+    }
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_v_batch_eq(const estr_view_t* views, size_t len, estr_view_t needle, uint64_t* bits, size_t* out_count) {
+    if(((!views || !bits) && len > 0) || !needle.ptr) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = _batch_views(views, len, &_eq_view, &needle, bits);
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_batch_validate(char* const* strs, size_t len, const estr_schema_t* schema, uint64_t* bits, size_t* out_count) {
+    if(((!strs || !bits) && len > 0) || !schema) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = _batch_strs(strs, len, &_validate_str, schema, bits);
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_v_batch_validate(const estr_view_t* views, size_t len, const estr_schema_t* schema, uint64_t* bits, size_t* out_count) {
+    if(((!views || !bits) && len > 0) || !schema) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = _batch_views(views, len, &_validate_view, schema, bits);
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_batch_find(char* const* strs, size_t len, const estr_pattern_t* pattern, uint64_t* bits, size_t* out_count) {
+    if(((!strs || !bits) && len > 0) || !pattern || !pattern->needle) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = _batch_strs(strs, len, &_find_str, pattern, bits);
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
+
+cu_err_t estr_v_batch_find(const estr_view_t* views, size_t len, const estr_pattern_t* pattern, uint64_t* bits, size_t* out_count) {
+    if(((!views || !bits) && len > 0) || !pattern || !pattern->needle) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t count = _batch_views(views, len, &_find_view, pattern, bits);
+
+    if(out_count) {
+        *out_count = count;
+    }
+
+    return CU_OK;
+}
\ No newline at end of file
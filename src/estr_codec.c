@@ -0,0 +1,395 @@
+#include "estr.h"
+#include "estr_scan.h"
+#include <stdint.h>
+
+size_t estr_hex_encoded_len(size_t len) {
+    return len > (SIZE_MAX - 1) / 2 ? SIZE_MAX : len * 2;
+}
+
+size_t estr_hex_decoded_len(estr_view_t view) {
+    return view.ptr ? view.len / 2 : 0;
+}
+
+static size_t _hex_encode(const uint8_t* data, size_t len, char* buf) {
+    estr_scan()->hex_encode(data, len, buf);
+    buf[len * 2] = '\0';
+    return len * 2;
+}
+
+char* estr_hex_encode(const void* data, size_t len) {
+    return estra_hex_encode(data, len, NULL);
+}
+
+char* estra_hex_encode(const void* data, size_t len, const cu_allocator_t* allocator) {
+    if(!data && len > 0) {
+        return NULL;
+    }
+
+    size_t encoded_len = estr_hex_encoded_len(len);
+
+    if(encoded_len == SIZE_MAX) {
+        return NULL;
+    }
+
+    char* buf = cu_alloc(allocator, encoded_len + 1); // exact size
+
+    if(buf) {
+        _hex_encode(data, len, buf);
+    }
+
+    return buf;
+}
+
+cu_err_t estr_hex_encode_to(const void* data, size_t len, char* buf, size_t size, size_t* out_len) {
+    if((!data && len > 0) || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t encoded_len = estr_hex_encoded_len(len);
+
+    if(out_len) {
+        *out_len = encoded_len;
+    }
+
+    if(encoded_len >= size) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    _hex_encode(data, len, buf);
+    return CU_OK;
+}
+
+/**
+ * @brief Decode hex digits into buf. Whole pairs go through the kernel,
+ *        pairs split by whitespace and the end of the buffer are handled one by one
+ */
+static cu_err_t _hex_decode(estr_view_t view, bool lenient, uint8_t* buf, size_t size, size_t* written) {
+    const estr_scan_t* scan = estr_scan();
+    const char* src = view.ptr;
+    size_t i = 0, n = 0;
+
+    for(;;) {
+        size_t chars = view.len - i;
+
+        if(chars / 2 > size - n) {
+            chars = (size - n) * 2;
+        }
+
+        if(chars > 0) {
+            size_t used = scan->hex_decode(src + i, chars, buf + n);
+            i += used;
+            n += used / 2;
+        }
+
+        char pair[2];
+        size_t got = 0;
+
+        for(; got < 2 && i < view.len; i++) {
+            if(lenient && estr_chr_is_ws(src[i])) {
+                continue;
+            }
+
+            pair[got++] = src[i];
+        }
+
+        if(got == 0) {
+            break;
+        }
+
+        uint8_t byte;
+
+        if(got == 1 || scan->hex_decode(pair, 2, &byte) != 2) {
+            return CU_ERR_SYNTAX_ERROR;
+        }
+
+        if(n == size) {
+            return CU_ERR_OUT_OF_BOUNDS;
+        }
+
+        buf[n++] = byte;
+    }
+
+    *written = n;
+    return CU_OK;
+}
+
+uint8_t* estr_v_hex_decode(estr_view_t view, estr_decode_t mode, size_t* out_len) {
+    return estra_v_hex_decode(view, mode, out_len, NULL);
+}
+
+uint8_t* estra_v_hex_decode(estr_view_t view, estr_decode_t mode, size_t* out_len, const cu_allocator_t* allocator) {
+    if(!view.ptr) {
+        return NULL;
+    }
+
+    cu_err_t err = CU_OK;
+    size_t len = 0, size = estr_hex_decoded_len(view);
+    uint8_t* buf = NULL;
+
+    cu_mem_check(buf = cu_alloc(allocator, size + 1)); // exact size for input without whitespace
+    cu_err_check(_hex_decode(view, mode == ESTR_DECODE_LENIENT, buf, size, &len));
+    buf[len] = '\0';
+
+    if(out_len) {
+        *out_len = len;
+    }
+
+    return buf;
+_error:
+    cu_free(allocator, buf);
+    return NULL;
+}
+
+cu_err_t estr_v_hex_decode_to(estr_view_t view, estr_decode_t mode, void* buf, size_t size, size_t* out_len) {
+    if(!view.ptr || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t len = 0;
+    cu_err_t err = _hex_decode(view, mode == ESTR_DECODE_LENIENT, buf, size, &len);
+
+    if(out_len) {
+        *out_len = err == CU_ERR_OUT_OF_BOUNDS ? estr_hex_decoded_len(view) : len;
+    }
+
+    return err;
+}
+
+size_t estr_base64_encoded_len(size_t len, estr_base64_t alphabet) {
+    size_t groups = len / 3, rem = len % 3;
+
+    if(groups > (SIZE_MAX - 5) / 4) {
+        return SIZE_MAX;
+    }
+
+    if(alphabet == ESTR_BASE64_URL) {
+        return groups * 4 + (rem ? rem + 1 : 0); // no padding
+    }
+
+    return (groups + (rem ? 1 : 0)) * 4;
+}
+
+size_t estr_base64_decoded_len(estr_view_t view) {
+    if(!view.ptr) {
+        return 0;
+    }
+
+    size_t len = view.len;
+
+    for(int pad = 0; pad < 2 && len > 0 && view.ptr[len - 1] == '='; pad++) {
+        len--;
+    }
+
+    return len / 4 * 3 + len % 4 * 3 / 4;
+}
+
+static size_t _base64_encode(const uint8_t* data, size_t len, estr_base64_t alphabet, char* buf) {
+    const estr_scan_t* scan = estr_scan();
+    bool url = alphabet == ESTR_BASE64_URL;
+    size_t done = scan->base64_encode(data, len, buf, url);
+    size_t rem = len - done;
+    char* out = buf + done / 3 * 4;
+
+    if(rem > 0) { // last group is encoded zero-padded, so its unused bits are zero
+        uint8_t tail[3] = { 0 };
+        char chars[4];
+        memcpy(tail, data + done, rem);
+        scan->base64_encode(tail, 3, chars, url);
+        memcpy(out, chars, rem + 1);
+        out += rem + 1;
+
+        if(!url) {
+            for(; rem < 3; rem++) {
+                *out++ = '=';
+            }
+        }
+    }
+
+    *out = '\0';
+    return out - buf;
+}
+
+char* estr_base64_encode(const void* data, size_t len, estr_base64_t alphabet) {
+    return estra_base64_encode(data, len, alphabet, NULL);
+}
+
+char* estra_base64_encode(const void* data, size_t len, estr_base64_t alphabet, const cu_allocator_t* allocator) {
+    if(!data && len > 0) {
+        return NULL;
+    }
+
+    size_t encoded_len = estr_base64_encoded_len(len, alphabet);
+
+    if(encoded_len == SIZE_MAX) {
+        return NULL;
+    }
+
+    char* buf = cu_alloc(allocator, encoded_len + 1); // exact size
+
+    if(buf) {
+        _base64_encode(data, len, alphabet, buf);
+    }
+
+    return buf;
+}
+
+cu_err_t estr_base64_encode_to(const void* data, size_t len, estr_base64_t alphabet, char* buf, size_t size, size_t* out_len) {
+    if((!data && len > 0) || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t encoded_len = estr_base64_encoded_len(len, alphabet);
+
+    if(out_len) {
+        *out_len = encoded_len;
+    }
+
+    if(encoded_len >= size) {
+        return CU_ERR_OUT_OF_BOUNDS;
+    }
+
+    _base64_encode(data, len, alphabet, buf);
+    return CU_OK;
+}
+
+/**
+ * @brief Character 62 or 63 of the other alphabet is replaced with the one of the selected alphabet
+ */
+static inline char _base64_chr(char chr, bool url) {
+    switch(chr) {
+        case '+': case '-': return url ? '-' : '+';
+        case '/': case '_': return url ? '_' : '/';
+        default: return chr;
+    }
+}
+
+/**
+ * @brief Decode base64 characters into buf. Whole groups go through the kernel, groups split by whitespace,
+ *        groups with characters of the other alphabet, the last group and the end of the buffer are handled one by one
+ */
+static cu_err_t _base64_decode(estr_view_t view, estr_base64_t alphabet, bool lenient, uint8_t* buf, size_t size, size_t* written) {
+    const estr_scan_t* scan = estr_scan();
+    const char* src = view.ptr;
+    bool url = alphabet == ESTR_BASE64_URL;
+    size_t i = 0, n = 0;
+    size_t got = 0;
+
+    for(;;) {
+        size_t chars = view.len - i;
+
+        if(chars / 4 > (size - n) / 3) {
+            chars = (size - n) / 3 * 4;
+        }
+
+        if(chars > 0) {
+            size_t used = scan->base64_decode(src + i, chars, buf + n, url);
+            i += used;
+            n += used / 4 * 3;
+        }
+
+        char group[4];
+        uint8_t bytes[3];
+        got = 0;
+
+        for(; got < 4 && i < view.len && src[i] != '='; i++) {
+            if(lenient && estr_chr_is_ws(src[i])) {
+                continue;
+            }
+
+            group[got++] = lenient ? _base64_chr(src[i], url) : src[i];
+        }
+
+        if(got < 4) { // end of data
+            if(got == 1) {
+                return CU_ERR_SYNTAX_ERROR;
+            }
+
+            if(got == 0) {
+                break;
+            }
+
+            memset(group + got, 'A', 4 - got);
+        }
+
+        if(scan->base64_decode(group, 4, bytes, url) != 4) {
+            return CU_ERR_SYNTAX_ERROR;
+        }
+
+        if(!lenient && got < 4 && bytes[got - 1] != 0) { // unused bits of the last character
+            return CU_ERR_SYNTAX_ERROR;
+        }
+
+        if(size - n < got - 1) {
+            return CU_ERR_OUT_OF_BOUNDS;
+        }
+
+        memcpy(buf + n, bytes, got - 1);
+        n += got - 1;
+
+        if(got < 4) {
+            break;
+        }
+    }
+
+    // only padding (and whitespace in lenient mode) can follow the data
+    size_t pad = 0, need = got > 0 ? 4 - got : 0;
+
+    for(; i < view.len; i++) {
+        if(src[i] == '=') {
+            pad++;
+        } else if(!lenient || !estr_chr_is_ws(src[i])) {
+            return CU_ERR_SYNTAX_ERROR;
+        }
+    }
+
+    if(lenient ? pad > need : pad != (url ? 0 : need)) {
+        return CU_ERR_SYNTAX_ERROR;
+    }
+
+    *written = n;
+    return CU_OK;
+}
+
+uint8_t* estr_v_base64_decode(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode, size_t* out_len) {
+    return estra_v_base64_decode(view, alphabet, mode, out_len, NULL);
+}
+
+uint8_t* estra_v_base64_decode(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode, size_t* out_len,
+    const cu_allocator_t* allocator) {
+    if(!view.ptr) {
+        return NULL;
+    }
+
+    cu_err_t err = CU_OK;
+    size_t len = 0, size = estr_base64_decoded_len(view);
+    uint8_t* buf = NULL;
+
+    cu_mem_check(buf = cu_alloc(allocator, size + 1)); // exact size for input without whitespace
+    cu_err_check(_base64_decode(view, alphabet, mode == ESTR_DECODE_LENIENT, buf, size, &len));
+    buf[len] = '\0';
+
+    if(out_len) {
+        *out_len = len;
+    }
+
+    return buf;
+_error:
+    cu_free(allocator, buf);
+    return NULL;
+}
+
+cu_err_t estr_v_base64_decode_to(estr_view_t view, estr_base64_t alphabet, estr_decode_t mode,
+    void* buf, size_t size, size_t* out_len) {
+    if(!view.ptr || (!buf && size > 0)) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    size_t len = 0;
+    cu_err_t err = _base64_decode(view, alphabet, mode == ESTR_DECODE_LENIENT, buf, size, &len);
+
+    if(out_len) {
+        *out_len = err == CU_ERR_OUT_OF_BOUNDS ? estr_base64_decoded_len(view) : len;
+    }
+
+    return err;
+}
\ No newline at end of file
@@ -0,0 +1,451 @@
+#include "estr.h"
+#include <stdint.h>
+
+#define _GLOB_ANY UINT32_MAX  /*<! Class of '?' */
+
+/**
+ * @brief One character of the pattern
+ */
+struct estr_glob_atom {
+    char chr;      /*<! Literal character */
+    uint32_t cls;  /*<! 0 for literal, _GLOB_ANY for '?', otherwise index of the class + 1 */
+};
+
+/**
+ * @brief Part of the pattern between two '*'. It matches fixed number of characters
+ */
+struct estr_glob_seg {
+    size_t off;             /*<! First atom */
+    size_t len;             /*<! Number of atoms */
+    size_t anchor;          /*<! Offset of the longest literal run in the segment */
+    estr_pattern_t finder;  /*<! Finder of the longest literal run (needle is NULL if segment has no literals) */
+};
+
+struct estr_glob {
+    struct estr_glob_atom* atoms;  /*<! Atoms of all segments */
+    uint64_t (*classes)[4];        /*<! Character classes (256 bit sets) */
+    char* anchors;                 /*<! Null-terminated literal runs of the finders */
+    struct estr_glob_seg* segs;    /*<! Segments */
+    size_t nsegs;                  /*<! Number of segments (more than one if pattern has '*') */
+    size_t min_len;                /*<! Number of atoms (exact length of the match if pattern has no '*') */
+    cu_allocator_t allocator;      /*<! Allocator */
+};
+
+struct estr_glob_set {
+    struct estr_glob* globs;  /*<! Compiled patterns */
+    size_t nglobs;            /*<! Number of patterns */
+    uint32_t start[257];      /*<! Range in by_first for every first character */
+    uint32_t* by_first;       /*<! Indices of patterns which begin with literal, bucketed by it */
+    uint32_t* wild;           /*<! Indices of the other patterns */
+    size_t nwild;             /*<! Number of the other patterns */
+    cu_allocator_t allocator; /*<! Allocator */
+};
+
+static inline bool _atom_match(const struct estr_glob* glob, const struct estr_glob_atom* atom, char chr) {
+    if(atom->cls == 0) {
+        return atom->chr == chr;
+    }
+
+    if(atom->cls == _GLOB_ANY) {
+        return true;
+    }
+
+    uint8_t c = (uint8_t) chr;
+    return (glob->classes[atom->cls - 1][c >> 6] >> (c & 63)) & 1;
+}
+
+static const char* _glob_class(struct estr_glob* glob, const char* p, struct estr_glob_atom* atom) {
+    uint64_t* set = glob->classes[atom->cls - 1];
+    bool negate = *p == '!' || *p == '^';
+
+    if(negate) {
+        p++;
+    }
+
+    for(bool first = true; *p && (*p != ']' || first); first = false) { // ']' right after '[' is literal
+        char lo = *p++;
+
+        if(lo == '\\' && !(lo = *p++)) {
+            return NULL;
+        }
+
+        char hi = lo;
+
+        if(p[0] == '-' && p[1] && p[1] != ']') {
+            hi = p[1];
+            p += 2;
+
+            if(hi == '\\' && !(hi = *p++)) {
+                return NULL;
+            }
+        }
+
+        if((uint8_t) lo > (uint8_t) hi) {
+            return NULL;
+        }
+
+        for(unsigned c = (uint8_t) lo; c <= (uint8_t) hi; c++) {
+            set[c >> 6] |= 1ULL << (c & 63);
+        }
+    }
+
+    if(*p != ']') {
+        return NULL;
+    }
+
+    if(negate) {
+        for(int i = 0; i < 4; i++) {
+            set[i] = ~set[i];
+        }
+    }
+
+    return p + 1;
+}
+
+static cu_err_t _glob_parse(struct estr_glob* glob, const char* pattern) {
+    struct estr_glob_seg* seg = &glob->segs[glob->nsegs++];
+    uint32_t nclasses = 0;
+
+    for(const char* p = pattern; *p; ) {
+        if(*p == '*') {
+            while(*p == '*') {
+                p++;
+            }
+
+            seg = &glob->segs[glob->nsegs++];
+            seg->off = glob->min_len;
+            continue;
+        }
+
+        struct estr_glob_atom* atom = &glob->atoms[glob->min_len++];
+        seg->len++;
+
+        if(*p == '?') {
+            atom->cls = _GLOB_ANY;
+            p++;
+        } else if(*p == '[') {
+            atom->cls = ++nclasses;
+
+            if(!(p = _glob_class(glob, p + 1, atom))) {
+                return CU_ERR_SYNTAX_ERROR;
+            }
+        } else {
+            if(*p == '\\' && !*++p) {
+                return CU_ERR_SYNTAX_ERROR;
+            }
+
+            atom->chr = *p++;
+        }
+    }
+
+    char* anchors = glob->anchors;
+
+    for(size_t i = 0; i < glob->nsegs; i++) {
+        seg = &glob->segs[i];
+        size_t best = 0, run = 0;
+
+        for(size_t j = 0; j < seg->len; j++) {
+            run = glob->atoms[seg->off + j].cls == 0 ? run + 1 : 0;
+
+            if(run > best) {
+                best = run;
+                seg->anchor = j + 1 - run;
+            }
+        }
+
+        if(best > 0) {
+            for(size_t j = 0; j < best; j++) {
+                anchors[j] = glob->atoms[seg->off + seg->anchor + j].chr;
+            }
+
+            anchors[best] = '\0';
+            estr_pattern_compile(&seg->finder, anchors);
+            anchors += best + 1;
+        }
+    }
+
+    return CU_OK;
+}
+
+static void _glob_free(struct estr_glob* glob, const cu_allocator_t* allocator) {
+    cu_free(allocator, glob->atoms);
+    cu_free(allocator, glob->classes);
+    cu_free(allocator, glob->anchors);
+    cu_free(allocator, glob->segs);
+}
+
+static cu_err_t _glob_init(struct estr_glob* glob, const char* pattern, const cu_allocator_t* allocator) {
+    cu_err_t err = CU_OK;
+    size_t len = strlen(pattern), nclasses = 0, nstars = 0;
+
+    for(size_t i = 0; i < len; i++) {
+        nclasses += pattern[i] == '[';
+        nstars += pattern[i] == '*';
+    }
+
+    // sizes are upper bounds, one atom is never longer than one character of the pattern
+    cu_mem_check(glob->atoms = cu_calloc(allocator, len + 1, sizeof(struct estr_glob_atom)));
+    cu_mem_check(glob->classes = cu_calloc(allocator, nclasses + 1, sizeof(glob->classes[0])));
+    cu_mem_check(glob->anchors = cu_alloc(allocator, len + nstars + 1));
+    cu_mem_check(glob->segs = cu_calloc(allocator, nstars + 1, sizeof(struct estr_glob_seg)));
+    cu_err_check(_glob_parse(glob, pattern));
+    goto _return;
+_error:
+    _glob_free(glob, allocator);
+_return:
+    return err;
+}
+
+static inline bool _seg_at(const struct estr_glob* glob, const struct estr_glob_seg* seg, const char* str) {
+    for(size_t i = 0; i < seg->len; i++) {
+        if(!_atom_match(glob, &glob->atoms[seg->off + i], str[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Leftmost match of the segment which fits between from and to
+ */
+static const char* _seg_find(const struct estr_glob* glob, const struct estr_glob_seg* seg, const char* from, const char* to) {
+    if((size_t) (to - from) < seg->len) {
+        return NULL;
+    }
+
+    const char* last = to - seg->len; // last possible start
+
+    if(!seg->finder.needle) {
+        for(; from <= last; from++) {
+            if(_seg_at(glob, seg, from)) {
+                return from;
+            }
+        }
+
+        return NULL;
+    }
+
+    while(from <= last) {
+        const char* hit = estr_v_find(&seg->finder, (estr_view_t) {
+            .ptr = from + seg->anchor,
+            .len = (size_t) (last - from) + seg->finder.len
+        });
+
+        if(!hit) {
+            return NULL;
+        }
+
+        from = hit - seg->anchor;
+
+        if(seg->finder.len == seg->len || _seg_at(glob, seg, from)) {
+            return from;
+        }
+
+        from++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief First and last segments are anchored to the ends, the middle ones are matched leftmost.
+ *        Segments have fixed length, so the leftmost match never needs to be revisited
+ */
+static bool _glob_match(const struct estr_glob* glob, const char* str, size_t len) {
+    const struct estr_glob_seg* first = &glob->segs[0];
+    const struct estr_glob_seg* last = &glob->segs[glob->nsegs - 1];
+
+    if(glob->nsegs == 1) {
+        return len == first->len && _seg_at(glob, first, str);
+    }
+
+    if(len < glob->min_len || !_seg_at(glob, first, str) || !_seg_at(glob, last, str + len - last->len)) {
+        return false;
+    }
+
+    const char* pos = str + first->len;
+    const char* end = str + len - last->len;
+
+    for(size_t i = 1; i < glob->nsegs - 1; i++) {
+        if(!(pos = _seg_find(glob, &glob->segs[i], pos, end))) {
+            return false;
+        }
+
+        pos += glob->segs[i].len;
+    }
+
+    return true;
+}
+
+cu_err_t estr_glob_compile(const char* pattern, estr_glob_t* glob) {
+    return estra_glob_compile(pattern, glob, NULL);
+}
+
+cu_err_t estra_glob_compile(const char* pattern, estr_glob_t* glob, const cu_allocator_t* allocator) {
+    if(!pattern || !glob) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err = CU_OK;
+    estr_glob_t _glob = NULL;
+
+    cu_mem_check(_glob = cu_tctora(allocator, estr_glob_t, struct estr_glob));
+
+    if(allocator) {
+        _glob->allocator = *allocator;
+    }
+
+    cu_err_check(_glob_init(_glob, pattern, allocator));
+    *glob = _glob;
+    goto _return;
+_error:
+    cu_free(allocator, _glob);
+_return:
+    return err;
+}
+
+cu_err_t estr_glob_destroy(estr_glob_t glob) {
+    if(!glob) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_allocator_t allocator = glob->allocator;
+    _glob_free(glob, &allocator);
+    cu_free(&allocator, glob);
+
+    return CU_OK;
+}
+
+bool estr_glob_match(estr_glob_t glob, const char* str) {
+    return estr_v_glob_match(glob, estr_view(str));
+}
+
+bool estr_v_glob_match(estr_glob_t glob, estr_view_t view) {
+    if(!glob || !view.ptr) {
+        return false;
+    }
+
+    return _glob_match(glob, view.ptr, view.len);
+}
+
+cu_err_t estr_glob_set_compile(const char* const* patterns, size_t npatterns, estr_glob_set_t* set) {
+    return estra_glob_set_compile(patterns, npatterns, set, NULL);
+}
+
+cu_err_t estra_glob_set_compile(const char* const* patterns, size_t npatterns, estr_glob_set_t* set, const cu_allocator_t* allocator) {
+    if(!patterns || npatterns == 0 || npatterns >= UINT32_MAX || !set) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    for(size_t i = 0; i < npatterns; i++) {
+        if(!patterns[i]) {
+            return CU_ERR_INVALID_ARG;
+        }
+    }
+
+    cu_err_t err = CU_OK;
+    estr_glob_set_t _set = NULL;
+
+    cu_mem_check(_set = cu_tctora(allocator, estr_glob_set_t, struct estr_glob_set));
+
+    if(allocator) {
+        _set->allocator = *allocator;
+    }
+
+    cu_mem_check(_set->globs = cu_calloc(allocator, npatterns, sizeof(struct estr_glob)));
+    cu_mem_check(_set->by_first = cu_calloc(allocator, npatterns, sizeof(uint32_t)));
+    cu_mem_check(_set->wild = cu_calloc(allocator, npatterns, sizeof(uint32_t)));
+
+    for(size_t i = 0; i < npatterns; i++) {
+        cu_err_check(_glob_init(&_set->globs[i], patterns[i], allocator));
+        _set->nglobs++;
+    }
+
+    // counting sort by the first literal keeps indices ascending in every bucket
+    for(size_t i = 0; i < npatterns; i++) {
+        const struct estr_glob* glob = &_set->globs[i];
+
+        if(glob->segs[0].len > 0 && glob->atoms[0].cls == 0) {
+            _set->start[(uint8_t) glob->atoms[0].chr + 1]++;
+        } else {
+            _set->wild[_set->nwild++] = i;
+        }
+    }
+
+    for(int c = 0; c < 256; c++) {
+        _set->start[c + 1] += _set->start[c];
+    }
+
+    uint32_t fill[256];
+    memcpy(fill, _set->start, sizeof(fill));
+
+    for(size_t i = 0; i < npatterns; i++) {
+        const struct estr_glob* glob = &_set->globs[i];
+
+        if(glob->segs[0].len > 0 && glob->atoms[0].cls == 0) {
+            _set->by_first[fill[(uint8_t) glob->atoms[0].chr]++] = i;
+        }
+    }
+
+    *set = _set;
+    goto _return;
+_error:
+    estr_glob_set_destroy(_set);
+_return:
+    return err;
+}
+
+cu_err_t estr_glob_set_destroy(estr_glob_set_t set) {
+    if(!set) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_allocator_t allocator = set->allocator;
+
+    if(set->globs) {
+        for(size_t i = 0; i < set->nglobs; i++) {
+            _glob_free(&set->globs[i], &allocator);
+        }
+    }
+
+    cu_free(&allocator, set->globs);
+    cu_free(&allocator, set->by_first);
+    cu_free(&allocator, set->wild);
+    cu_free(&allocator, set);
+
+    return CU_OK;
+}
+
+bool estr_glob_set_match(estr_glob_set_t set, const char* str, size_t* out_index) {
+    return estr_v_glob_set_match(set, estr_view(str), out_index);
+}
+
+bool estr_v_glob_set_match(estr_glob_set_t set, estr_view_t view, size_t* out_index) {
+    if(!set || !view.ptr) {
+        return false;
+    }
+
+    // candidates of the first character bucket and the wild ones are merged by index
+    const uint32_t* bucket = set->by_first;
+    size_t b = 0, nbucket = 0, w = 0;
+
+    if(view.len > 0) {
+        b = set->start[(uint8_t) view.ptr[0]];
+        nbucket = set->start[(uint8_t) view.ptr[0] + 1];
+    }
+
+    while(b < nbucket || w < set->nwild) {
+        uint32_t i = w == set->nwild || (b < nbucket && bucket[b] < set->wild[w]) ? bucket[b++] : set->wild[w++];
+
+        if(_glob_match(&set->globs[i], view.ptr, view.len)) {
+            if(out_index) {
+                *out_index = i;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
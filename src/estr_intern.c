@@ -0,0 +1,186 @@
+#include "estr.h"
+#include "arena.h"
+
+#define _INTERN_MAX_LOAD(slots) ((slots) / 2) /*<! Table grows when more than half of the slots are taken */
+
+typedef struct {
+    uint64_t hash;    /*<! Hash of the string */
+    const char* str;  /*<! Canonical string (NULL for empty slot) */
+    size_t len;       /*<! Length of the string */
+} _intern_slot_t;
+
+struct estr_intern {
+    _intern_slot_t* slots;      /*<! Open addressing table (linear probing), size is power of two */
+    size_t slots_len;           /*<! Number of slots */
+    size_t count;               /*<! Number of interned strings */
+    size_t string_bytes;        /*<! Bytes occupied by the strings */
+    cu_arena_t arena;           /*<! Arena for the strings (NULL if strings are allocated separately) */
+    cu_allocator_t allocator;   /*<! Allocator for the table and the strings */
+};
+
+static inline size_t _pow2_ceil(size_t num) {
+    size_t pow2 = 8;
+    while(pow2 < num) { pow2 <<= 1; }
+    return pow2;
+}
+
+cu_err_t estr_intern_create(estr_intern_config_t* config, estr_intern_t* table) {
+    if(!table) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_err_t err = CU_OK;
+    const cu_allocator_t* allocator = config ? config->allocator : NULL;
+    size_t capacity = config && config->capacity > 0 ? config->capacity : ESTR_INTERN_DEFAULT_CAPACITY;
+    estr_intern_t _table = NULL;
+
+    cu_mem_check(_table = cu_tctora(allocator, estr_intern_t, struct estr_intern,
+        .slots_len = _pow2_ceil(capacity * 2)
+    ));
+
+    if(allocator) {
+        _table->allocator = *allocator;
+    }
+
+    cu_mem_check(_table->slots = cu_calloc(allocator, _table->slots_len, sizeof(_intern_slot_t)));
+
+    if(config && config->arena) {
+        cu_err_check(cu_arena_create(&(cu_arena_config_t) {
+            .block_size = config->arena_block_size,
+            .allocator = allocator
+        }, &_table->arena));
+    }
+
+    goto _return;
+_error:
+    estr_intern_destroy(_table);
+    _table = NULL;
+_return:
+    *table = _table;
+    return err;
+}
+
+/**
+ * @brief Slot with the view content, or empty slot where it belongs
+ */
+static inline _intern_slot_t* _intern_slot(estr_intern_t table, estr_view_t view, uint64_t hash) {
+    size_t mask = table->slots_len - 1;
+
+    for(size_t i = hash & mask;; i = (i + 1) & mask) {
+        _intern_slot_t* slot = &table->slots[i];
+
+        if(!slot->str || (slot->hash == hash && slot->len == view.len && memcmp(slot->str, view.ptr, view.len) == 0)) {
+            return slot;
+        }
+    }
+}
+
+static cu_err_t _intern_grow(estr_intern_t table) {
+    size_t slots_len = table->slots_len * 2;
+    _intern_slot_t* slots = NULL;
+    cu_mem_checkr(slots = cu_calloc(&table->allocator, slots_len, sizeof(_intern_slot_t)));
+
+    for(size_t i = 0; i < table->slots_len; i++) {
+        _intern_slot_t* slot = &table->slots[i];
+
+        if(slot->str) {
+            size_t j = slot->hash & (slots_len - 1);
+            while(slots[j].str) { j = (j + 1) & (slots_len - 1); }
+            slots[j] = *slot;
+        }
+    }
+
+    cu_free(&table->allocator, table->slots);
+    table->slots = slots;
+    table->slots_len = slots_len;
+
+    return CU_OK;
+}
+
+cu_err_t estr_v_intern(estr_intern_t table, estr_view_t view, const char** out) {
+    if(!table || !view.ptr || !out) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    uint64_t hash = estr_hash64(view.ptr, view.len, 0);
+    _intern_slot_t* slot = _intern_slot(table, view, hash);
+
+    if(slot->str) {
+        *out = slot->str;
+        return CU_OK;
+    }
+
+    if(table->count + 1 > _INTERN_MAX_LOAD(table->slots_len)) {
+        cu_err_t err;
+        cu_err_checkr(_intern_grow(table));
+        slot = _intern_slot(table, view, hash);
+    }
+
+    char* str = table->arena
+        ? cu_arena_alloc(table->arena, view.len + 1)
+        : cu_alloc(&table->allocator, view.len + 1);
+
+    cu_mem_checkr(str);
+    memcpy(str, view.ptr, view.len);
+    str[view.len] = '\0';
+
+    *slot = (_intern_slot_t) { .hash = hash, .str = str, .len = view.len };
+    table->count++;
+    table->string_bytes += view.len + 1;
+
+    *out = str;
+    return CU_OK;
+}
+
+cu_err_t estr_intern(estr_intern_t table, const char* str, const char** out) {
+    if(!str) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    return estr_v_intern(table, estr_view(str), out);
+}
+
+const char* estr_intern_find(estr_intern_t table, estr_view_t view) {
+    if(!table || !view.ptr) {
+        return NULL;
+    }
+
+    return _intern_slot(table, view, estr_hash64(view.ptr, view.len, 0))->str;
+}
+
+cu_err_t estr_intern_stats(estr_intern_t table, estr_intern_stats_t* stats) {
+    if(!table || !stats) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    *stats = (estr_intern_stats_t) {
+        .count = table->count,
+        .slots = table->slots_len,
+        .string_bytes = table->string_bytes,
+        .total_bytes = sizeof(struct estr_intern) + table->slots_len * sizeof(_intern_slot_t)
+            + (table->arena ? cu_arena_capacity(table->arena) : table->string_bytes)
+    };
+
+    return CU_OK;
+}
+
+cu_err_t estr_intern_destroy(estr_intern_t table) {
+    if(!table) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    cu_allocator_t allocator = table->allocator;
+
+    if(table->arena) {
+        cu_arena_destroy(table->arena);
+    } else if(table->slots) {
+        for(size_t i = 0; i < table->slots_len; i++) {
+            cu_free(&allocator, (char*) table->slots[i].str);
+        }
+    }
+
+    cu_free(&allocator, table->slots);
+    cu_free(&allocator, table);
+
+    return CU_OK;
+}
\ No newline at end of file
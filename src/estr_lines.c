@@ -0,0 +1,171 @@
+#include "estr.h"
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <stdio.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+/**
+ * @brief No mmap, so the whole file is read into heap buffer
+ */
+static cu_err_t _lines_map(const char* path, estr_lines_t* lines) {
+    FILE* file = fopen(path, "rb");
+
+    if(!file) {
+        return CU_ERR_NOT_FOUND;
+    }
+
+    cu_err_t err = CU_OK;
+    char* buf = NULL;
+    size_t len = 0, cap = 0;
+
+    for(;;) {
+        if(len == cap) {
+            char* _buf = NULL;
+            cap = cap ? cap * 2 : 64 * 1024;
+            cu_mem_check(_buf = realloc(buf, cap));
+            buf = _buf;
+        }
+
+        size_t n = fread(buf + len, 1, cap - len, file);
+
+        if(n == 0) {
+            break;
+        }
+
+        len += n;
+    }
+
+    if(ferror(file)) {
+        err = CU_FAIL;
+        goto _error;
+    }
+
+    lines->ptr = buf ? buf : "";
+    lines->len = len;
+    lines->map = buf;
+    lines->map_len = cap;
+    goto _return;
+_error:
+    free(buf);
+_return:
+    fclose(file);
+    return err;
+}
+
+static void _lines_unmap(estr_lines_t* lines) {
+    free(lines->map);
+}
+
+#else
+
+static cu_err_t _lines_map(const char* path, estr_lines_t* lines) {
+    int fd = open(path, O_RDONLY);
+
+    if(fd < 0) {
+        return errno == ENOENT ? CU_ERR_NOT_FOUND : CU_FAIL;
+    }
+
+    cu_err_t err = CU_OK;
+    struct stat st;
+
+    if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        err = CU_FAIL;
+        goto _return;
+    }
+
+    if((uint64_t) st.st_size > SIZE_MAX) { // 32-bit address space
+        err = CU_ERR_OUT_OF_BOUNDS;
+        goto _return;
+    }
+
+    lines->ptr = "";
+    lines->len = (size_t) st.st_size;
+
+    if(lines->len == 0) { // empty file can't be mapped
+        goto _return;
+    }
+
+    void* map = mmap(NULL, lines->len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(map == MAP_FAILED) {
+        err = CU_FAIL;
+        goto _return;
+    }
+
+    // pages are read ahead aggressively and dropped soon after they are passed
+    madvise(map, lines->len, MADV_SEQUENTIAL);
+
+    lines->ptr = map;
+    lines->map = map;
+    lines->map_len = lines->len;
+_return:
+    close(fd);
+    return err;
+}
+
+static void _lines_unmap(estr_lines_t* lines) {
+    munmap(lines->map, lines->map_len);
+}
+
+#endif
+
+cu_err_t estr_lines_open(const char* path, estr_lines_t* lines) {
+    if(!path || !lines) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    estr_lines_t _lines = { 0 };
+    cu_err_t err = _lines_map(path, &_lines);
+
+    if(err == CU_OK) {
+        *lines = _lines;
+    }
+
+    return err;
+}
+
+estr_lines_t estr_v_lines(estr_view_t view) {
+    return (estr_lines_t) { .ptr = view.ptr, .len = view.ptr ? view.len : 0 };
+}
+
+bool estr_lines_next(estr_lines_t* lines, estr_view_t* line) {
+    if(!lines || !line || !lines->ptr || lines->pos >= lines->len) {
+        return false;
+    }
+
+    const char* ptr = lines->ptr + lines->pos;
+    size_t rest = lines->len - lines->pos;
+    const char* nl = memchr(ptr, '\n', rest);
+    size_t len = nl ? (size_t) (nl - ptr) : rest; // last line doesn't need to end with newline
+
+    lines->pos += nl ? len + 1 : len;
+
+    if(len > 0 && ptr[len - 1] == '\r') {
+        len--;
+    }
+
+    *line = (estr_view_t) { .ptr = ptr, .len = len };
+    return true;
+}
+
+cu_err_t estr_lines_close(estr_lines_t* lines) {
+    if(!lines) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(lines->map) {
+        _lines_unmap(lines);
+    }
+
+    *lines = (estr_lines_t) { 0 };
+    return CU_OK;
+}
\ No newline at end of file
@@ -0,0 +1,1484 @@
+#include "estr_scan.h"
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _SCAN_X86
+#include <immintrin.h>
+#endif
+
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define _SCAN_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define _SWAR_BIG_ENDIAN
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* SWAR (portable)                                                           */
+/* ------------------------------------------------------------------------- */
+
+#define _L 0x0101010101010101ULL
+#define _H 0x8080808080808080ULL
+
+static inline uint64_t _swar_load(const char* ptr) {
+    uint64_t v;
+    memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief High bit set in every byte of v which is equal to chr (exact, no false positives)
+ */
+static inline uint64_t _swar_eq(uint64_t v, char chr) {
+    uint64_t x = v ^ (_L * (uint8_t) chr);
+    return ~(((x & ~_H) + ~_H) | x) & _H;
+}
+
+/**
+ * @brief High bit set in every byte of v which is in range [lo, hi] (lo and hi must be ASCII)
+ */
+static inline uint64_t _swar_range(uint64_t v, uint8_t lo, uint8_t hi) {
+    uint64_t x = (v & ~_H) | _H;
+    return (x - _L * lo) & ~(x - _L * (hi + 1)) & ~v & _H;
+}
+
+static inline uint64_t _swar_ws(uint64_t v) {
+    return _swar_eq(v, ' ') | _swar_range(v, '\t', '\r');
+}
+
+/**
+ * @brief Index of the first byte (in memory order) marked in mask
+ */
+static inline size_t _swar_first(uint64_t mask) {
+#ifdef _SWAR_BIG_ENDIAN
+    return __builtin_clzll(mask) >> 3;
+#else
+    return __builtin_ctzll(mask) >> 3;
+#endif
+}
+
+/**
+ * @brief Move byte marks one byte forward (in memory order) and put carry into the first byte
+ */
+static inline uint64_t _swar_shift(uint64_t mask, uint64_t carry) {
+#ifdef _SWAR_BIG_ENDIAN
+    return (mask >> 8) | (carry << 56);
+#else
+    return (mask << 8) | carry;
+#endif
+}
+
+/**
+ * @brief Mark of the last byte (in memory order), moved into the first byte position
+ */
+static inline uint64_t _swar_last(uint64_t mask) {
+#ifdef _SWAR_BIG_ENDIAN
+    return mask & 0x80;
+#else
+    return mask >> 56;
+#endif
+}
+
+static inline uint64_t _swar_url_safe(uint64_t v) {
+    return _swar_range(v, '0', '9') | _swar_range(v, 'A', 'Z') | _swar_range(v, 'a', 'z') |
+        _swar_range(v, '-', '.') | _swar_eq(v, '_') | _swar_eq(v, '~');
+}
+
+/**
+ * @brief Lowercase ASCII letters in v (high bit of the range mask shifted to the case bit 0x20)
+ */
+static inline uint64_t _swar_lower(uint64_t v) {
+    return v | (_swar_range(v, 'A', 'Z') >> 2);
+}
+
+static inline int _is_ws(char chr) {
+    return chr == ' ' || (chr >= '\t' && chr <= '\r');
+}
+
+static inline int _is_digit(char chr) {
+    return chr >= '0' && chr <= '9';
+}
+
+static inline int _is_url_safe(char chr) {
+    return (chr >= '0' && chr <= '9') || (chr >= 'A' && chr <= 'Z') || (chr >= 'a' && chr <= 'z') ||
+        chr == '-' || chr == '.' || chr == '_' || chr == '~';
+}
+
+static inline char _lower(char chr) {
+    return chr >= 'A' && chr <= 'Z' ? chr | 0x20 : chr;
+}
+
+/**
+ * @brief Unescaped characters from index from (escaped tells if str[from] is escaped).
+ *        Character is escaped if it's preceded by odd number of backslashes.
+ *        Positions are stored while there is a space, all of them are counted
+ */
+static size_t _scalar_unescaped(const char* str, size_t len, char chr, size_t from, bool escaped,
+    size_t* positions, size_t cap, size_t count, bool first_only) {
+    for(size_t i = from; i < len; i++) {
+        if(escaped) {
+            escaped = false;
+            continue;
+        }
+
+        if(str[i] == chr) {
+            if(first_only) { return i; }
+            if(count < cap) { positions[count] = i; }
+            count++;
+        }
+
+        if(str[i] == '\\') {
+            escaped = true;
+        }
+    }
+
+    return first_only ? len : count;
+}
+
+/**
+ * @brief Mark characters which are escaped in 64 byte block (simdjson's algorithm).
+ *        Every backslash run of odd length escapes the character after it.
+ *        prev_escaped carries the state to the next block
+ */
+static inline uint64_t _escaped(uint64_t bs, uint64_t* prev_escaped) {
+    const uint64_t even_bits = 0x5555555555555555ULL;
+
+    bs &= ~*prev_escaped; // escaped backslash does not start a run
+    uint64_t follows_escape = (bs << 1) | *prev_escaped;
+    uint64_t odd_starts = bs & ~even_bits & ~follows_escape;
+    uint64_t even_starts;
+    *prev_escaped = __builtin_add_overflow(odd_starts, bs, &even_starts);
+
+    return (even_bits ^ (even_starts << 1)) & follows_escape;
+}
+
+/**
+ * @brief Find unescaped characters using 64 byte block masks built by BLOCK(str, chr, &bs, &chrs)
+ *        (bit i is set if str[i] is backslash or chr)
+ */
+#define _unescaped_(BLOCK)                                                          \
+    uint64_t prev_escaped = 0;                                                      \
+    size_t i = 0;                                                                   \
+    for(; i + 64 <= len; i += 64) {                                                 \
+        uint64_t bs, chrs;                                                          \
+        BLOCK(str + i, chr, &bs, &chrs);                                            \
+        uint64_t m = chrs & ~_escaped(bs, &prev_escaped);                           \
+        if(first_only && m) { return i + __builtin_ctzll(m); }                      \
+        for(; m; m &= m - 1, count++) {                                             \
+            if(count < cap) { positions[count] = i + __builtin_ctzll(m); }          \
+        }                                                                           \
+    }                                                                               \
+    return _scalar_unescaped(str, len, chr, i, prev_escaped, positions, cap, count, first_only);
+
+static size_t _swar_chrcnt(const char* str, size_t len, char chr) {
+    size_t i = 0, cnt = 0;
+
+    for(; i + 8 <= len; i += 8) {
+        cnt += __builtin_popcountll(_swar_eq(_swar_load(str + i), chr));
+    }
+
+    for(; i < len; i++) {
+        cnt += str[i] == chr;
+    }
+
+    return cnt;
+}
+
+#define _swar_find_(MASK, BYTE_MATCH)                     \
+    size_t i = 0;                                         \
+    for(; i + 8 <= len; i += 8) {                         \
+        uint64_t v = _swar_load(str + i);                 \
+        uint64_t m = (MASK);                              \
+        if(m) { return i + _swar_first(m); }              \
+    }                                                     \
+    for(; i < len; i++) {                                 \
+        if(BYTE_MATCH) { return i; }                      \
+    }                                                     \
+    return len;
+
+static size_t _swar_find_ws(const char* str, size_t len) {
+    _swar_find_(_swar_ws(v), _is_ws(str[i]));
+}
+
+static size_t _swar_find_non_ws(const char* str, size_t len) {
+    _swar_find_(~_swar_ws(v) & _H, !_is_ws(str[i]));
+}
+
+static size_t _swar_find_non_digit(const char* str, size_t len) {
+    _swar_find_(~_swar_range(v, '0', '9') & _H, !_is_digit(str[i]));
+}
+
+static size_t _swar_find_chr2(const char* str, size_t len, char a, char b) {
+    _swar_find_(_swar_eq(v, a) | _swar_eq(v, b), str[i] == a || str[i] == b);
+}
+
+static size_t _swar_find_url_unsafe(const char* str, size_t len) {
+    _swar_find_(~_swar_url_safe(v) & _H, !_is_url_safe(str[i]));
+}
+
+static size_t _swar_find_utf8_invalid(const char* str, size_t len) {
+    size_t i = 0;
+
+    while(i < len) {
+        if(i + 8 <= len && !(_swar_load(str + i) & _H)) { // ASCII
+            i += 8;
+            continue;
+        }
+
+        size_t n = estr_utf8_seq((const uint8_t*) str + i, len - i);
+
+        if(!n) {
+            return i;
+        }
+
+        i += n;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Finish UTF-8 validation from index i with SWAR kernel. Everything before i must be valid,
+ *        except the last sequence which can be truncated, so validation is resumed from its lead byte
+ */
+static size_t _utf8_tail(const char* str, size_t len, size_t i) {
+    size_t p = i;
+
+    while(p > 0 && i - p < 4) {
+        if(((uint8_t) str[--p] & 0xC0) != 0x80) { break; }
+    }
+
+    return p + _swar_find_utf8_invalid(str + p, len - p);
+}
+
+static size_t _swar_utf8_count(const char* str, size_t len) {
+    size_t i = 0, cont = 0;
+
+    for(; i + 8 <= len; i += 8) {
+        uint64_t v = _swar_load(str + i);
+        cont += __builtin_popcountll(v & ~(v << 1) & _H); // 10xxxxxx
+    }
+
+    for(; i < len; i++) {
+        cont += ((uint8_t) str[i] & 0xC0) == 0x80;
+    }
+
+    return len - cont;
+}
+
+static bool _swar_ieq(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for(; i + 8 <= len; i += 8) {
+        uint64_t va = _swar_load(a + i);
+        uint64_t vb = _swar_load(b + i);
+
+        if(va != vb && _swar_lower(va) != _swar_lower(vb)) {
+            return false;
+        }
+    }
+
+    for(; i < len; i++) {
+        if(_lower(a[i]) != _lower(b[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static const char _hex_digits[] = "0123456789abcdef";
+
+/**
+ * @brief Value of hex digit + 1 (0 for characters which are not hex digits)
+ */
+static const uint8_t _hex_val[256] = {
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5, ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16
+};
+
+static const char _b64_std[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char _b64_url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/**
+ * @brief Base64 value of every character. 0xFF is not in any alphabet, 62 and 63 are marked
+ *        with 0x40 in the standard alphabet ('+', '/') and with 0x80 in the url one ('-', '_')
+ */
+static const uint8_t _b64_val[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0xFF, 0xBE, 0xFF, 0x7F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xBF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+static void _scalar_hex_encode(const uint8_t* src, size_t len, char* dst) {
+    for(size_t i = 0; i < len; i++) {
+        *dst++ = _hex_digits[src[i] >> 4];
+        *dst++ = _hex_digits[src[i] & 15];
+    }
+}
+
+static size_t _scalar_hex_decode(const char* src, size_t len, uint8_t* dst) {
+    size_t i = 0;
+
+    for(; i + 2 <= len; i += 2) {
+        uint8_t hi = _hex_val[(uint8_t) src[i]];
+        uint8_t lo = _hex_val[(uint8_t) src[i + 1]];
+
+        if(!hi || !lo) {
+            break;
+        }
+
+        *dst++ = (uint8_t) (((hi - 1) << 4) | (lo - 1));
+    }
+
+    return i;
+}
+
+static size_t _scalar_base64_encode(const uint8_t* src, size_t len, char* dst, bool url) {
+    const char* abc = url ? _b64_url : _b64_std;
+    size_t i = 0;
+
+    for(; i + 3 <= len; i += 3) {
+        uint32_t v = (uint32_t) src[i] << 16 | (uint32_t) src[i + 1] << 8 | src[i + 2];
+        *dst++ = abc[v >> 18];
+        *dst++ = abc[(v >> 12) & 63];
+        *dst++ = abc[(v >> 6) & 63];
+        *dst++ = abc[v & 63];
+    }
+
+    return i;
+}
+
+static size_t _scalar_base64_decode(const char* src, size_t len, uint8_t* dst, bool url) {
+    const uint8_t reject = url ? 0x40 : 0x80; // marks of the other alphabet (and 0xFF)
+    size_t i = 0;
+
+    for(; i + 4 <= len; i += 4) {
+        uint8_t a = _b64_val[(uint8_t) src[i]];
+        uint8_t b = _b64_val[(uint8_t) src[i + 1]];
+        uint8_t c = _b64_val[(uint8_t) src[i + 2]];
+        uint8_t d = _b64_val[(uint8_t) src[i + 3]];
+
+        if((a | b | c | d) & reject) {
+            break;
+        }
+
+        uint32_t v = (uint32_t) (a & 63) << 18 | (uint32_t) (b & 63) << 12 | (uint32_t) (c & 63) << 6 | (d & 63);
+        *dst++ = (uint8_t) (v >> 16);
+        *dst++ = (uint8_t) (v >> 8);
+        *dst++ = (uint8_t) v;
+    }
+
+    return i;
+}
+
+/**
+ * @brief Gather high bits of the bytes into 8 bit mask (bit i for byte i in memory order)
+ */
+static inline uint64_t _swar_bits(uint64_t mask) {
+    return ((mask >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+static inline void _swar_block(const char* str, char chr, uint64_t* bs, uint64_t* chrs) {
+    *bs = *chrs = 0;
+
+    for(int j = 0; j < 8; j++) {
+        uint64_t v = _swar_load(str + j * 8);
+#ifdef _SWAR_BIG_ENDIAN
+        v = __builtin_bswap64(v);
+#endif
+        *bs |= _swar_bits(_swar_eq(v, '\\')) << (j * 8);
+        *chrs |= _swar_bits(_swar_eq(v, chr)) << (j * 8);
+    }
+}
+
+static size_t _swar_unescaped(const char* str, size_t len, char chr, size_t* positions, size_t cap, bool first_only) {
+    size_t count = 0;
+    _unescaped_(_swar_block);
+}
+
+static size_t _swar_find_unescaped(const char* str, size_t len, char chr) {
+    return _swar_unescaped(str, len, chr, NULL, 0, true);
+}
+
+static size_t _swar_unescaped_all(const char* str, size_t len, char chr, size_t* positions, size_t cap) {
+    return _swar_unescaped(str, len, chr, positions, cap, false);
+}
+
+static const estr_scan_t _scan_swar = {
+    .simd = ESTR_SIMD_NONE,
+    .chrcnt = &_swar_chrcnt,
+    .find_ws = &_swar_find_ws,
+    .find_non_ws = &_swar_find_non_ws,
+    .find_non_digit = &_swar_find_non_digit,
+    .find_unescaped = &_swar_find_unescaped,
+    .unescaped_all = &_swar_unescaped_all,
+    .find_chr2 = &_swar_find_chr2,
+    .find_url_unsafe = &_swar_find_url_unsafe,
+    .find_utf8_invalid = &_swar_find_utf8_invalid,
+    .utf8_count = &_swar_utf8_count,
+    .ieq = &_swar_ieq,
+    .hex_encode = &_scalar_hex_encode,
+    .hex_decode = &_scalar_hex_decode,
+    .base64_encode = &_scalar_base64_encode,
+    .base64_decode = &_scalar_base64_decode
+};
+
+/* ------------------------------------------------------------------------- */
+/* SSE2 / AVX2                                                               */
+/* ------------------------------------------------------------------------- */
+
+#ifdef _SCAN_X86
+
+#define _SSE2 __attribute__((target("sse2")))
+#define _SSSE3 __attribute__((target("ssse3")))
+#define _AVX2 __attribute__((target("avx2")))
+
+_SSE2 static inline __m128i _sse2_ws(__m128i v) {
+    return _mm_or_si128(
+        _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+        _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('\r' + 1)))
+    );
+}
+
+_SSE2 static inline __m128i _sse2_digit(__m128i v) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+}
+
+_SSE2 static inline __m128i _sse2_range(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+}
+
+_SSE2 static inline __m128i _sse2_url_safe(__m128i v) {
+    return _mm_or_si128(
+        _mm_or_si128(_sse2_range(v, '0', '9'), _sse2_range(v, 'A', 'Z')),
+        _mm_or_si128(
+            _mm_or_si128(_sse2_range(v, 'a', 'z'), _sse2_range(v, '-', '.')),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('_')), _mm_cmpeq_epi8(v, _mm_set1_epi8('~')))
+        )
+    );
+}
+
+_SSE2 static size_t _sse2_chrcnt(const char* str, size_t len, char chr) {
+    const __m128i c = _mm_set1_epi8(chr);
+    size_t i = 0, cnt = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + i));
+        cnt += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(v, c)));
+    }
+
+    return cnt + _swar_chrcnt(str + i, len - i, chr);
+}
+
+#define _sse2_find_(MASK, TAIL)                                   \
+    size_t i = 0;                                                 \
+    for(; i + 16 <= len; i += 16) {                               \
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + i));  \
+        uint32_t m = (MASK);                                      \
+        if(m) { return i + __builtin_ctz(m); }                    \
+    }                                                             \
+    return i + TAIL(str + i, len - i);
+
+_SSE2 static size_t _sse2_find_ws(const char* str, size_t len) {
+    _sse2_find_(_mm_movemask_epi8(_sse2_ws(v)), _swar_find_ws);
+}
+
+_SSE2 static size_t _sse2_find_non_ws(const char* str, size_t len) {
+    _sse2_find_(~_mm_movemask_epi8(_sse2_ws(v)) & 0xFFFF, _swar_find_non_ws);
+}
+
+_SSE2 static size_t _sse2_find_non_digit(const char* str, size_t len) {
+    _sse2_find_(~_mm_movemask_epi8(_sse2_digit(v)) & 0xFFFF, _swar_find_non_digit);
+}
+
+_SSE2 static size_t _sse2_find_chr2(const char* str, size_t len, char a, char b) {
+    const __m128i ca = _mm_set1_epi8(a);
+    const __m128i cb = _mm_set1_epi8(b);
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + i));
+        uint32_t m = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, ca), _mm_cmpeq_epi8(v, cb)));
+        if(m) { return i + __builtin_ctz(m); }
+    }
+
+    return i + _swar_find_chr2(str + i, len - i, a, b);
+}
+
+_SSE2 static size_t _sse2_find_url_unsafe(const char* str, size_t len) {
+    _sse2_find_(~_mm_movemask_epi8(_sse2_url_safe(v)) & 0xFFFF, _swar_find_url_unsafe);
+}
+
+_SSE2 static inline void _sse2_block(const char* str, char chr, uint64_t* bs, uint64_t* chrs) {
+    const __m128i c = _mm_set1_epi8(chr);
+    const __m128i b = _mm_set1_epi8('\\');
+    *bs = *chrs = 0;
+
+    for(int j = 0; j < 4; j++) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + j * 16));
+        *bs |= (uint64_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, b)) << (j * 16);
+        *chrs |= (uint64_t) _mm_movemask_epi8(_mm_cmpeq_epi8(v, c)) << (j * 16);
+    }
+}
+
+_SSE2 static size_t _sse2_unescaped(const char* str, size_t len, char chr, size_t* positions, size_t cap, bool first_only) {
+    size_t count = 0;
+    _unescaped_(_sse2_block);
+}
+
+_SSE2 static size_t _sse2_find_unescaped(const char* str, size_t len, char chr) {
+    return _sse2_unescaped(str, len, chr, NULL, 0, true);
+}
+
+_SSE2 static size_t _sse2_unescaped_all(const char* str, size_t len, char chr, size_t* positions, size_t cap) {
+    return _sse2_unescaped(str, len, chr, positions, cap, false);
+}
+
+_SSE2 static inline __m128i _sse2_lower(__m128i v) {
+    return _mm_or_si128(v, _mm_and_si128(_sse2_range(v, 'A', 'Z'), _mm_set1_epi8(0x20)));
+}
+
+_SSE2 static bool _sse2_ieq(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*) (b + i));
+
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(_sse2_lower(va), _sse2_lower(vb))) != 0xFFFF) {
+            return false;
+        }
+    }
+
+    return _swar_ieq(a + i, b + i, len - i);
+}
+
+_SSE2 static size_t _sse2_utf8_count(const char* str, size_t len) {
+    const __m128i c = _mm_set1_epi8(-0x40); // signed bytes below it are 10xxxxxx
+    size_t i = 0, cont = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + i));
+        cont += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(c, v)));
+    }
+
+    return i - cont + _swar_utf8_count(str + i, len - i);
+}
+
+/*
+ * UTF-8 validation with lookup tables (Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte").
+ * Every pair of adjacent bytes is classified by three 16 entry tables indexed by the high and the low nibble
+ * of the first byte and the high nibble of the second byte. Every bit is one kind of error, and pair is invalid
+ * if the same bit is set in all three lookups. Only thing that is not visible from the pairs is whether
+ * the third and the fourth byte of the sequence is continuation, which is checked separately (TWO_CONTS bit)
+ */
+
+#define _U8_TOO_SHORT      (1 << 0)  /*<! Lead byte or ASCII followed by lead byte or ASCII */
+#define _U8_TOO_LONG       (1 << 1)  /*<! ASCII followed by continuation */
+#define _U8_OVERLONG_3     (1 << 2)  /*<! 11100000 100xxxxx */
+#define _U8_TOO_LARGE      (1 << 3)  /*<! 11110100 1001xxxx, 11110100 101xxxxx, 11110101+ */
+#define _U8_SURROGATE      (1 << 4)  /*<! 11101101 101xxxxx */
+#define _U8_OVERLONG_2     (1 << 5)  /*<! 1100000x */
+#define _U8_TOO_LARGE_1000 (1 << 6)  /*<! 11110101+ 1000xxxx */
+#define _U8_OVERLONG_4     (1 << 6)  /*<! 11110000 1000xxxx */
+#define _U8_TWO_CONTS      (1 << 7)  /*<! Two continuations (valid only as the third or the fourth byte) */
+#define _U8_CARRY          (_U8_TOO_SHORT | _U8_TOO_LONG | _U8_TWO_CONTS)
+
+static const uint8_t _utf8_byte1_high[16] = {
+    _U8_TOO_LONG, _U8_TOO_LONG, _U8_TOO_LONG, _U8_TOO_LONG,
+    _U8_TOO_LONG, _U8_TOO_LONG, _U8_TOO_LONG, _U8_TOO_LONG,
+    _U8_TWO_CONTS, _U8_TWO_CONTS, _U8_TWO_CONTS, _U8_TWO_CONTS,
+    _U8_TOO_SHORT | _U8_OVERLONG_2,
+    _U8_TOO_SHORT,
+    _U8_TOO_SHORT | _U8_OVERLONG_3 | _U8_SURROGATE,
+    _U8_TOO_SHORT | _U8_TOO_LARGE | _U8_TOO_LARGE_1000 | _U8_OVERLONG_4
+};
+
+static const uint8_t _utf8_byte1_low[16] = {
+    _U8_CARRY | _U8_OVERLONG_3 | _U8_OVERLONG_2 | _U8_OVERLONG_4,
+    _U8_CARRY | _U8_OVERLONG_2,
+    _U8_CARRY,
+    _U8_CARRY,
+    _U8_CARRY | _U8_TOO_LARGE,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000 | _U8_SURROGATE,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000,
+    _U8_CARRY | _U8_TOO_LARGE | _U8_TOO_LARGE_1000
+};
+
+static const uint8_t _utf8_byte2_high[16] = {
+    _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT,
+    _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT,
+    _U8_TOO_LONG | _U8_OVERLONG_2 | _U8_TWO_CONTS | _U8_OVERLONG_3 | _U8_TOO_LARGE_1000 | _U8_OVERLONG_4,
+    _U8_TOO_LONG | _U8_OVERLONG_2 | _U8_TWO_CONTS | _U8_OVERLONG_3 | _U8_TOO_LARGE,
+    _U8_TOO_LONG | _U8_OVERLONG_2 | _U8_TWO_CONTS | _U8_SURROGATE | _U8_TOO_LARGE,
+    _U8_TOO_LONG | _U8_OVERLONG_2 | _U8_TWO_CONTS | _U8_SURROGATE | _U8_TOO_LARGE,
+    _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT, _U8_TOO_SHORT
+};
+
+/**
+ * @brief Subtracting it with saturation leaves non-zero byte only if block ends with truncated sequence
+ */
+static const uint8_t _utf8_incomplete[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+};
+
+/**
+ * @brief Non-zero bytes where v (preceded by prev) is not valid UTF-8
+ */
+_SSSE3 static inline __m128i _ssse3_utf8_errors(__m128i v, __m128i prev) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i prev1 = _mm_alignr_epi8(v, prev, 15);
+    __m128i prev2 = _mm_alignr_epi8(v, prev, 14);
+    __m128i prev3 = _mm_alignr_epi8(v, prev, 13);
+
+    __m128i special = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) _utf8_byte1_high), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) _utf8_byte1_low), _mm_and_si128(prev1, nibble))
+        ),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) _utf8_byte2_high), _mm_and_si128(_mm_srli_epi16(v, 4), nibble))
+    );
+
+    // third byte of 111xxxxx and fourth byte of 1111xxxx must be continuations
+    __m128i must_be_cont = _mm_or_si128(
+        _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+        _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80))
+    );
+
+    return _mm_xor_si128(_mm_and_si128(must_be_cont, _mm_set1_epi8((char) 0x80)), special);
+}
+
+_SSSE3 static size_t _ssse3_find_utf8_invalid(const char* str, size_t len) {
+    const __m128i incomplete_max = _mm_loadu_si128((const __m128i*) (_utf8_incomplete + 16));
+    __m128i prev = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (str + i));
+        __m128i errors = incomplete; // ASCII block is valid unless previous one ends with truncated sequence
+
+        if(_mm_movemask_epi8(v)) {
+            errors = _ssse3_utf8_errors(v, prev);
+            incomplete = _mm_subs_epu8(v, incomplete_max);
+        }
+
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) != 0xFFFF) {
+            break; // exact position is found by the scalar code
+        }
+
+        prev = v;
+    }
+
+    return _utf8_tail(str, len, i);
+}
+
+_SSSE3 static void _ssse3_hex_encode(const uint8_t* src, size_t len, char* dst) {
+    const __m128i digits = _mm_loadu_si128((const __m128i*) _hex_digits);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i));
+        __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, nibble));
+        _mm_storeu_si128((__m128i*) (dst + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i*) (dst + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    _scalar_hex_encode(src + i, len - i, dst + i * 2);
+}
+
+/**
+ * @brief Values of hex digits in v, ok marks the characters which are hex digits
+ */
+_SSSE3 static inline __m128i _ssse3_hex_nibbles(__m128i v, __m128i* ok) {
+    __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i alpha = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    *ok = _mm_or_si128(is_digit, is_alpha);
+    return _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+_SSSE3 static size_t _ssse3_hex_decode(const char* src, size_t len, uint8_t* dst) {
+    const __m128i weights = _mm_set1_epi16(0x0110); // 16 for the high nibble, 1 for the low one
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m128i ok1, ok2;
+        __m128i v1 = _ssse3_hex_nibbles(_mm_loadu_si128((const __m128i*) (src + i)), &ok1);
+        __m128i v2 = _ssse3_hex_nibbles(_mm_loadu_si128((const __m128i*) (src + i + 16)), &ok2);
+
+        if(_mm_movemask_epi8(_mm_and_si128(ok1, ok2)) != 0xFFFF) {
+            break;
+        }
+
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(v1, weights), _mm_maddubs_epi16(v2, weights));
+        _mm_storeu_si128((__m128i*) (dst + i / 2), bytes);
+    }
+
+    return i + _scalar_hex_decode(src + i, len - i, dst + i / 2);
+}
+
+/*
+ * Base64 with byte shuffles (Mula and Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions").
+ * Encoding spreads every 3 bytes into 4 bytes, extracts 6 bit indices with multiplications
+ * and translates them to ASCII with offset lookup. Decoding translates characters with range compares
+ * and packs 4 sextets into 3 bytes with multiply-add instructions
+ */
+
+/**
+ * @brief 6 bit indices of 12 bytes (which are spread into 16 bytes by the shuffle)
+ */
+_SSSE3 static inline __m128i _ssse3_b64_indices(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+_SSSE3 static inline __m128i _ssse3_b64_ascii(__m128i indices, bool url) {
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, (url ? '-' : '+') - 62, (url ? '_' : '/') - 63, 'A', 0, 0);
+
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+    __m128i idx = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    idx = _mm_or_si128(idx, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(shift, idx));
+}
+
+_SSSE3 static size_t _ssse3_base64_encode(const uint8_t* src, size_t len, char* dst, bool url) {
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 12, dst += 16) { // 16 bytes are loaded, 12 are encoded
+        __m128i in = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_si128((__m128i*) dst, _ssse3_b64_ascii(_ssse3_b64_indices(in), url));
+    }
+
+    return i + _scalar_base64_encode(src + i, len - i, dst, url);
+}
+
+/**
+ * @brief Sextets of base64 characters in v, ok marks the characters which are in the alphabet
+ */
+_SSSE3 static inline __m128i _ssse3_b64_values(__m128i v, bool url, __m128i* ok) {
+    const char c62 = url ? '-' : '+';
+    const char c63 = url ? '_' : '/';
+    __m128i upper = _sse2_range(v, 'A', 'Z');
+    __m128i lower = _sse2_range(v, 'a', 'z');
+    __m128i digit = _sse2_range(v, '0', '9');
+    __m128i is62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c62));
+    __m128i is63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(c63));
+
+    *ok = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+
+    __m128i offset = _mm_or_si128(
+        _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a'))),
+        _mm_or_si128(
+            _mm_and_si128(digit, _mm_set1_epi8(52 - '0')),
+            _mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62 - c62)), _mm_and_si128(is63, _mm_set1_epi8(63 - c63)))
+        )
+    );
+
+    return _mm_add_epi8(v, offset);
+}
+
+/**
+ * @brief Pack sextets into 3 bytes of every 32 bit lane, in the first 12 bytes
+ */
+_SSSE3 static inline __m128i _ssse3_b64_pack(__m128i values) {
+    __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+_SSSE3 static size_t _ssse3_base64_decode(const char* src, size_t len, uint8_t* dst, bool url) {
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16, dst += 12) {
+        __m128i ok;
+        __m128i values = _ssse3_b64_values(_mm_loadu_si128((const __m128i*) (src + i)), url, &ok);
+
+        if(_mm_movemask_epi8(ok) != 0xFFFF) {
+            break;
+        }
+
+        __m128i bytes = _ssse3_b64_pack(values);
+        _mm_storel_epi64((__m128i*) dst, bytes); // exactly 12 bytes
+        uint32_t last = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+        memcpy(dst + 8, &last, 4);
+    }
+
+    return i + _scalar_base64_decode(src + i, len - i, dst, url);
+}
+
+static const estr_scan_t _scan_sse2 = {
+    .simd = ESTR_SIMD_SSE2,
+    .chrcnt = &_sse2_chrcnt,
+    .find_ws = &_sse2_find_ws,
+    .find_non_ws = &_sse2_find_non_ws,
+    .find_non_digit = &_sse2_find_non_digit,
+    .find_unescaped = &_sse2_find_unescaped,
+    .unescaped_all = &_sse2_unescaped_all,
+    .find_chr2 = &_sse2_find_chr2,
+    .find_url_unsafe = &_sse2_find_url_unsafe,
+    .find_utf8_invalid = &_swar_find_utf8_invalid,
+    .utf8_count = &_sse2_utf8_count,
+    .ieq = &_sse2_ieq,
+    .hex_encode = &_scalar_hex_encode,
+    .hex_decode = &_scalar_hex_decode,
+    .base64_encode = &_scalar_base64_encode,
+    .base64_decode = &_scalar_base64_decode
+};
+
+/**
+ * @brief SSE2 kernels with UTF-8 validation and hex and base64 codecs which need SSSE3 (byte shuffle and align)
+ */
+static const estr_scan_t _scan_ssse3 = {
+    .simd = ESTR_SIMD_SSSE3,
+    .chrcnt = &_sse2_chrcnt,
+    .find_ws = &_sse2_find_ws,
+    .find_non_ws = &_sse2_find_non_ws,
+    .find_non_digit = &_sse2_find_non_digit,
+    .find_unescaped = &_sse2_find_unescaped,
+    .unescaped_all = &_sse2_unescaped_all,
+    .find_chr2 = &_sse2_find_chr2,
+    .find_url_unsafe = &_sse2_find_url_unsafe,
+    .find_utf8_invalid = &_ssse3_find_utf8_invalid,
+    .utf8_count = &_sse2_utf8_count,
+    .ieq = &_sse2_ieq,
+    .hex_encode = &_ssse3_hex_encode,
+    .hex_decode = &_ssse3_hex_decode,
+    .base64_encode = &_ssse3_base64_encode,
+    .base64_decode = &_ssse3_base64_decode
+};
+
+_AVX2 static inline __m256i _avx2_ws(__m256i v) {
+    return _mm256_or_si256(
+        _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+        _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('\t' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('\r' + 1), v))
+    );
+}
+
+_AVX2 static inline __m256i _avx2_digit(__m256i v) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+}
+
+_AVX2 static inline __m256i _avx2_range(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(lo - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), v));
+}
+
+_AVX2 static inline __m256i _avx2_url_safe(__m256i v) {
+    return _mm256_or_si256(
+        _mm256_or_si256(_avx2_range(v, '0', '9'), _avx2_range(v, 'A', 'Z')),
+        _mm256_or_si256(
+            _mm256_or_si256(_avx2_range(v, 'a', 'z'), _avx2_range(v, '-', '.')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('~')))
+        )
+    );
+}
+
+_AVX2 static size_t _avx2_chrcnt(const char* str, size_t len, char chr) {
+    const __m256i c = _mm256_set1_epi8(chr);
+    size_t i = 0, cnt = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (str + i));
+        cnt += __builtin_popcount((uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c)));
+    }
+
+    return cnt + _sse2_chrcnt(str + i, len - i, chr);
+}
+
+#define _avx2_find_(MASK, TAIL)                                         \
+    size_t i = 0;                                                       \
+    for(; i + 32 <= len; i += 32) {                                     \
+        __m256i v = _mm256_loadu_si256((const __m256i*) (str + i));     \
+        uint32_t m = (MASK);                                            \
+        if(m) { return i + __builtin_ctz(m); }                          \
+    }                                                                   \
+    return i + TAIL(str + i, len - i);
+
+_AVX2 static size_t _avx2_find_ws(const char* str, size_t len) {
+    _avx2_find_((uint32_t) _mm256_movemask_epi8(_avx2_ws(v)), _sse2_find_ws);
+}
+
+_AVX2 static size_t _avx2_find_non_ws(const char* str, size_t len) {
+    _avx2_find_(~(uint32_t) _mm256_movemask_epi8(_avx2_ws(v)), _sse2_find_non_ws);
+}
+
+_AVX2 static size_t _avx2_find_non_digit(const char* str, size_t len) {
+    _avx2_find_(~(uint32_t) _mm256_movemask_epi8(_avx2_digit(v)), _sse2_find_non_digit);
+}
+
+_AVX2 static size_t _avx2_find_chr2(const char* str, size_t len, char a, char b) {
+    const __m256i ca = _mm256_set1_epi8(a);
+    const __m256i cb = _mm256_set1_epi8(b);
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (str + i));
+        uint32_t m = (uint32_t) _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, ca), _mm256_cmpeq_epi8(v, cb)));
+        if(m) { return i + __builtin_ctz(m); }
+    }
+
+    return i + _sse2_find_chr2(str + i, len - i, a, b);
+}
+
+_AVX2 static size_t _avx2_find_url_unsafe(const char* str, size_t len) {
+    _avx2_find_(~(uint32_t) _mm256_movemask_epi8(_avx2_url_safe(v)), _sse2_find_url_unsafe);
+}
+
+_AVX2 static inline void _avx2_block(const char* str, char chr, uint64_t* bs, uint64_t* chrs) {
+    const __m256i c = _mm256_set1_epi8(chr);
+    const __m256i b = _mm256_set1_epi8('\\');
+    __m256i lo = _mm256_loadu_si256((const __m256i*) str);
+    __m256i hi = _mm256_loadu_si256((const __m256i*) (str + 32));
+
+    *bs = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, b)) |
+        ((uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, b)) << 32);
+    *chrs = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, c)) |
+        ((uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, c)) << 32);
+}
+
+_AVX2 static size_t _avx2_unescaped(const char* str, size_t len, char chr, size_t* positions, size_t cap, bool first_only) {
+    size_t count = 0;
+    _unescaped_(_avx2_block);
+}
+
+_AVX2 static size_t _avx2_find_unescaped(const char* str, size_t len, char chr) {
+    return _avx2_unescaped(str, len, chr, NULL, 0, true);
+}
+
+_AVX2 static size_t _avx2_unescaped_all(const char* str, size_t len, char chr, size_t* positions, size_t cap) {
+    return _avx2_unescaped(str, len, chr, positions, cap, false);
+}
+
+_AVX2 static inline __m256i _avx2_lower(__m256i v) {
+    return _mm256_or_si256(v, _mm256_and_si256(_avx2_range(v, 'A', 'Z'), _mm256_set1_epi8(0x20)));
+}
+
+_AVX2 static bool _avx2_ieq(const char* a, const char* b, size_t len) {
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m256i va = _mm256_loadu_si256((const __m256i*) (a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*) (b + i));
+
+        if(~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_avx2_lower(va), _avx2_lower(vb)))) {
+            return false;
+        }
+    }
+
+    return _sse2_ieq(a + i, b + i, len - i);
+}
+
+_AVX2 static size_t _avx2_utf8_count(const char* str, size_t len) {
+    const __m256i c = _mm256_set1_epi8(-0x40);
+    size_t i = 0, cont = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (str + i));
+        cont += __builtin_popcount((uint32_t) _mm256_movemask_epi8(_mm256_cmpgt_epi8(c, v)));
+    }
+
+    return i - cont + _sse2_utf8_count(str + i, len - i);
+}
+
+_AVX2 static inline __m256i _avx2_table(const uint8_t* table) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) table));
+}
+
+/**
+ * @brief Non-zero bytes where v (preceded by prev) is not valid UTF-8
+ */
+_AVX2 static inline __m256i _avx2_utf8_errors(__m256i v, __m256i prev) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i cross = _mm256_permute2x128_si256(prev, v, 0x21); // high lane of prev, low lane of v
+    __m256i prev1 = _mm256_alignr_epi8(v, cross, 15);
+    __m256i prev2 = _mm256_alignr_epi8(v, cross, 14);
+    __m256i prev3 = _mm256_alignr_epi8(v, cross, 13);
+
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(_avx2_table(_utf8_byte1_high), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+            _mm256_shuffle_epi8(_avx2_table(_utf8_byte1_low), _mm256_and_si256(prev1, nibble))
+        ),
+        _mm256_shuffle_epi8(_avx2_table(_utf8_byte2_high), _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble))
+    );
+
+    __m256i must_be_cont = _mm256_or_si256(
+        _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+        _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80))
+    );
+
+    return _mm256_xor_si256(_mm256_and_si256(must_be_cont, _mm256_set1_epi8((char) 0x80)), special);
+}
+
+_AVX2 static size_t _avx2_find_utf8_invalid(const char* str, size_t len) {
+    const __m256i incomplete_max = _mm256_loadu_si256((const __m256i*) _utf8_incomplete);
+    __m256i prev = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (str + i));
+        __m256i errors = incomplete;
+
+        if(_mm256_movemask_epi8(v)) {
+            errors = _avx2_utf8_errors(v, prev);
+            incomplete = _mm256_subs_epu8(v, incomplete_max);
+        }
+
+        if(!_mm256_testz_si256(errors, errors)) {
+            break;
+        }
+
+        prev = v;
+    }
+
+    return _utf8_tail(str, len, i);
+}
+
+_AVX2 static void _avx2_hex_encode(const uint8_t* src, size_t len, char* dst) {
+    const __m256i digits = _avx2_table((const uint8_t*) _hex_digits);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        // bytes 0-7 and 16-23 in the low lane, so interleaving (which works within lanes) keeps the order
+        __m256i v = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) (src + i)), 0xD8);
+        __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, nibble));
+        _mm256_storeu_si256((__m256i*) (dst + i * 2), _mm256_unpacklo_epi8(hi, lo));
+        _mm256_storeu_si256((__m256i*) (dst + i * 2 + 32), _mm256_unpackhi_epi8(hi, lo));
+    }
+
+    _ssse3_hex_encode(src + i, len - i, dst + i * 2);
+}
+
+_AVX2 static inline __m256i _avx2_hex_nibbles(__m256i v, __m256i* ok) {
+    __m256i digit = _mm256_sub_epi8(v, _mm256_set1_epi8('0'));
+    __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(v, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    *ok = _mm256_or_si256(is_digit, is_alpha);
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+_AVX2 static size_t _avx2_hex_decode(const char* src, size_t len, uint8_t* dst) {
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+
+    for(; i + 64 <= len; i += 64) {
+        __m256i ok1, ok2;
+        __m256i v1 = _avx2_hex_nibbles(_mm256_loadu_si256((const __m256i*) (src + i)), &ok1);
+        __m256i v2 = _avx2_hex_nibbles(_mm256_loadu_si256((const __m256i*) (src + i + 32)), &ok2);
+
+        if(~(uint32_t) _mm256_movemask_epi8(_mm256_and_si256(ok1, ok2))) {
+            break;
+        }
+
+        __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(v1, weights), _mm256_maddubs_epi16(v2, weights));
+        _mm256_storeu_si256((__m256i*) (dst + i / 2), _mm256_permute4x64_epi64(bytes, 0xD8)); // packing works within lanes
+    }
+
+    return i + _ssse3_hex_decode(src + i, len - i, dst + i / 2);
+}
+
+_AVX2 static inline __m256i _avx2_b64_indices(__m256i in) {
+    in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1)));
+    __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t0, t1);
+}
+
+_AVX2 static inline __m256i _avx2_b64_ascii(__m256i indices, bool url) {
+    const __m256i shift = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, (url ? '-' : '+') - 62, (url ? '_' : '/') - 63, 'A', 0, 0));
+
+    __m256i idx = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    idx = _mm256_or_si256(idx, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift, idx));
+}
+
+_AVX2 static size_t _avx2_base64_encode(const uint8_t* src, size_t len, char* dst, bool url) {
+    size_t i = 0;
+
+    for(; i + 28 <= len; i += 24, dst += 32) { // 12 bytes into every lane
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (src + i))),
+            _mm_loadu_si128((const __m128i*) (src + i + 12)), 1
+        );
+        _mm256_storeu_si256((__m256i*) dst, _avx2_b64_ascii(_avx2_b64_indices(in), url));
+    }
+
+    return i + _ssse3_base64_encode(src + i, len - i, dst, url);
+}
+
+_AVX2 static inline __m256i _avx2_b64_values(__m256i v, bool url, __m256i* ok) {
+    const char c62 = url ? '-' : '+';
+    const char c63 = url ? '_' : '/';
+    __m256i upper = _avx2_range(v, 'A', 'Z');
+    __m256i lower = _avx2_range(v, 'a', 'z');
+    __m256i digit = _avx2_range(v, '0', '9');
+    __m256i is62 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c62));
+    __m256i is63 = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c63));
+
+    *ok = _mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(is62, is63)));
+
+    __m256i offset = _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a'))),
+        _mm256_or_si256(
+            _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')),
+            _mm256_or_si256(_mm256_and_si256(is62, _mm256_set1_epi8(62 - c62)), _mm256_and_si256(is63, _mm256_set1_epi8(63 - c63)))
+        )
+    );
+
+    return _mm256_add_epi8(v, offset);
+}
+
+_AVX2 static size_t _avx2_base64_decode(const char* src, size_t len, uint8_t* dst, bool url) {
+    size_t i = 0;
+
+    for(; i + 32 <= len; i += 32, dst += 24) {
+        __m256i ok;
+        __m256i values = _avx2_b64_values(_mm256_loadu_si256((const __m256i*) (src + i)), url, &ok);
+
+        if(~(uint32_t) _mm256_movemask_epi8(ok)) {
+            break;
+        }
+
+        __m256i merged = _mm256_madd_epi16(
+            _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000)
+        );
+        merged = _mm256_shuffle_epi8(merged, _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+        ));
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7)); // 24 bytes in a row
+
+        _mm_storeu_si128((__m128i*) dst, _mm256_castsi256_si128(merged)); // exactly 24 bytes
+        _mm_storel_epi64((__m128i*) (dst + 16), _mm256_extracti128_si256(merged, 1));
+    }
+
+    return i + _ssse3_base64_decode(src + i, len - i, dst, url);
+}
+
+static const estr_scan_t _scan_avx2 = {
+    .simd = ESTR_SIMD_AVX2,
+    .chrcnt = &_avx2_chrcnt,
+    .find_ws = &_avx2_find_ws,
+    .find_non_ws = &_avx2_find_non_ws,
+    .find_non_digit = &_avx2_find_non_digit,
+    .find_unescaped = &_avx2_find_unescaped,
+    .unescaped_all = &_avx2_unescaped_all,
+    .find_chr2 = &_avx2_find_chr2,
+    .find_url_unsafe = &_avx2_find_url_unsafe,
+    .find_utf8_invalid = &_avx2_find_utf8_invalid,
+    .utf8_count = &_avx2_utf8_count,
+    .ieq = &_avx2_ieq,
+    .hex_encode = &_avx2_hex_encode,
+    .hex_decode = &_avx2_hex_decode,
+    .base64_encode = &_avx2_base64_encode,
+    .base64_decode = &_avx2_base64_decode
+};
+
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* NEON                                                                      */
+/* ------------------------------------------------------------------------- */
+
+#ifdef _SCAN_NEON
+
+/**
+ * @brief Narrow byte mask (0x00/0xFF per byte) into 64 bit mask with 4 bits per byte
+ */
+static inline uint64_t _neon_mask(uint8x16_t m) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(m), 4)), 0);
+}
+
+static inline uint8x16_t _neon_ws(uint8x16_t v) {
+    return vorrq_u8(
+        vceqq_u8(v, vdupq_n_u8(' ')),
+        vandq_u8(vcgeq_u8(v, vdupq_n_u8('\t')), vcleq_u8(v, vdupq_n_u8('\r')))
+    );
+}
+
+static inline uint8x16_t _neon_digit(uint8x16_t v) {
+    return vandq_u8(vcgeq_u8(v, vdupq_n_u8('0')), vcleq_u8(v, vdupq_n_u8('9')));
+}
+
+static inline uint8x16_t _neon_range(uint8x16_t v, uint8_t lo, uint8_t hi) {
+    return vandq_u8(vcgeq_u8(v, vdupq_n_u8(lo)), vcleq_u8(v, vdupq_n_u8(hi)));
+}
+
+static inline uint8x16_t _neon_url_safe(uint8x16_t v) {
+    return vorrq_u8(
+        vorrq_u8(_neon_range(v, '0', '9'), _neon_range(v, 'A', 'Z')),
+        vorrq_u8(
+            vorrq_u8(_neon_range(v, 'a', 'z'), _neon_range(v, '-', '.')),
+            vorrq_u8(vceqq_u8(v, vdupq_n_u8('_')), vceqq_u8(v, vdupq_n_u8('~')))
+        )
+    );
+}
+
+static size_t _neon_chrcnt(const char* str, size_t len, char chr) {
+    const uint8x16_t c = vdupq_n_u8((uint8_t) chr);
+    size_t i = 0, cnt = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*) (str + i));
+        cnt += __builtin_popcountll(_neon_mask(vceqq_u8(v, c))) >> 2;
+    }
+
+    return cnt + _swar_chrcnt(str + i, len - i, chr);
+}
+
+#define _neon_find_(MASK, TAIL)                                 \
+    size_t i = 0;                                               \
+    for(; i + 16 <= len; i += 16) {                             \
+        uint8x16_t v = vld1q_u8((const uint8_t*) (str + i));    \
+        uint64_t m = _neon_mask(MASK);                          \
+        if(m) { return i + (__builtin_ctzll(m) >> 2); }         \
+    }                                                           \
+    return i + TAIL(str + i, len - i);
+
+static size_t _neon_find_ws(const char* str, size_t len) {
+    _neon_find_(_neon_ws(v), _swar_find_ws);
+}
+
+static size_t _neon_find_non_ws(const char* str, size_t len) {
+    _neon_find_(vmvnq_u8(_neon_ws(v)), _swar_find_non_ws);
+}
+
+static size_t _neon_find_non_digit(const char* str, size_t len) {
+    _neon_find_(vmvnq_u8(_neon_digit(v)), _swar_find_non_digit);
+}
+
+static size_t _neon_find_chr2(const char* str, size_t len, char a, char b) {
+    const uint8x16_t ca = vdupq_n_u8((uint8_t) a);
+    const uint8x16_t cb = vdupq_n_u8((uint8_t) b);
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*) (str + i));
+        uint64_t m = _neon_mask(vorrq_u8(vceqq_u8(v, ca), vceqq_u8(v, cb)));
+        if(m) { return i + (__builtin_ctzll(m) >> 2); }
+    }
+
+    return i + _swar_find_chr2(str + i, len - i, a, b);
+}
+
+static size_t _neon_find_url_unsafe(const char* str, size_t len) {
+    _neon_find_(vmvnq_u8(_neon_url_safe(v)), _swar_find_url_unsafe);
+}
+
+static bool _neon_ieq(const char* a, const char* b, size_t len) {
+    const uint8x16_t bit = vdupq_n_u8(0x20);
+    size_t i = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        uint8x16_t va = vld1q_u8((const uint8_t*) (a + i));
+        uint8x16_t vb = vld1q_u8((const uint8_t*) (b + i));
+        va = vorrq_u8(va, vandq_u8(_neon_range(va, 'A', 'Z'), bit));
+        vb = vorrq_u8(vb, vandq_u8(_neon_range(vb, 'A', 'Z'), bit));
+
+        if(~_neon_mask(vceqq_u8(va, vb))) {
+            return false;
+        }
+    }
+
+    return _swar_ieq(a + i, b + i, len - i);
+}
+
+static size_t _neon_utf8_count(const char* str, size_t len) {
+    const int8x16_t c = vdupq_n_s8(-0x40); // signed bytes below it are 10xxxxxx
+    size_t i = 0, cont = 0;
+
+    for(; i + 16 <= len; i += 16) {
+        int8x16_t v = vld1q_s8((const int8_t*) (str + i));
+        cont += __builtin_popcountll(_neon_mask(vcltq_s8(v, c))) >> 2;
+    }
+
+    return i - cont + _swar_utf8_count(str + i, len - i);
+}
+
+#ifdef __aarch64__
+
+/**
+ * @brief Gather byte masks (0x00/0xFF per byte) of 64 bytes into 64 bit mask
+ */
+static inline uint64_t _neon_bits(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d) {
+    const uint8x16_t bit = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t ab = vpaddq_u8(vandq_u8(a, bit), vandq_u8(b, bit));
+    uint8x16_t cd = vpaddq_u8(vandq_u8(c, bit), vandq_u8(d, bit));
+    ab = vpaddq_u8(ab, cd);
+    ab = vpaddq_u8(ab, ab);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(ab), 0);
+}
+
+static inline void _neon_block(const char* str, char chr, uint64_t* bs, uint64_t* chrs) {
+    const uint8x16_t c = vdupq_n_u8((uint8_t) chr);
+    const uint8x16_t b = vdupq_n_u8('\\');
+    uint8x16_t v0 = vld1q_u8((const uint8_t*) str);
+    uint8x16_t v1 = vld1q_u8((const uint8_t*) (str + 16));
+    uint8x16_t v2 = vld1q_u8((const uint8_t*) (str + 32));
+    uint8x16_t v3 = vld1q_u8((const uint8_t*) (str + 48));
+
+    *bs = _neon_bits(vceqq_u8(v0, b), vceqq_u8(v1, b), vceqq_u8(v2, b), vceqq_u8(v3, b));
+    *chrs = _neon_bits(vceqq_u8(v0, c), vceqq_u8(v1, c), vceqq_u8(v2, c), vceqq_u8(v3, c));
+}
+
+static size_t _neon_unescaped(const char* str, size_t len, char chr, size_t* positions, size_t cap, bool first_only) {
+    size_t count = 0;
+    _unescaped_(_neon_block);
+}
+
+static size_t _neon_find_unescaped(const char* str, size_t len, char chr) {
+    return _neon_unescaped(str, len, chr, NULL, 0, true);
+}
+
+static size_t _neon_unescaped_all(const char* str, size_t len, char chr, size_t* positions, size_t cap) {
+    return _neon_unescaped(str, len, chr, positions, cap, false);
+}
+
+#else // 32 bit ARM has no pairwise add on q registers
+
+#define _neon_find_unescaped _swar_find_unescaped
+#define _neon_unescaped_all _swar_unescaped_all
+
+#endif
+
+static const estr_scan_t _scan_neon = {
+    .simd = ESTR_SIMD_NEON,
+    .chrcnt = &_neon_chrcnt,
+    .find_ws = &_neon_find_ws,
+    .find_non_ws = &_neon_find_non_ws,
+    .find_non_digit = &_neon_find_non_digit,
+    .find_unescaped = &_neon_find_unescaped,
+    .unescaped_all = &_neon_unescaped_all,
+    .find_chr2 = &_neon_find_chr2,
+    .find_url_unsafe = &_neon_find_url_unsafe,
+    .find_utf8_invalid = &_swar_find_utf8_invalid,
+    .utf8_count = &_neon_utf8_count,
+    .ieq = &_neon_ieq,
+    .hex_encode = &_scalar_hex_encode,
+    .hex_decode = &_scalar_hex_decode,
+    .base64_encode = &_scalar_base64_encode,
+    .base64_decode = &_scalar_base64_decode
+};
+
+#endif
+
+/* ------------------------------------------------------------------------- */
+/* Dispatch                                                                  */
+/* ------------------------------------------------------------------------- */
+
+static const estr_scan_t* _scan_selected = NULL;
+
+/**
+ * @brief Kernels for simd if the running CPU supports it, otherwise NULL
+ */
+static const estr_scan_t* _scan_of(estr_simd_t simd) {
+#ifdef _SCAN_X86
+    __builtin_cpu_init();
+#endif
+
+    switch(simd) {
+        case ESTR_SIMD_AUTO:
+#ifdef _SCAN_X86
+            if(__builtin_cpu_supports("avx2")) { return &_scan_avx2; }
+            if(__builtin_cpu_supports("ssse3")) { return &_scan_ssse3; }
+            if(__builtin_cpu_supports("sse2")) { return &_scan_sse2; }
+#endif
+#ifdef _SCAN_NEON
+            return &_scan_neon;
+#endif
+            return &_scan_swar;
+
+        case ESTR_SIMD_NONE:
+            return &_scan_swar;
+
+#ifdef _SCAN_X86
+        case ESTR_SIMD_SSE2:
+            return __builtin_cpu_supports("sse2") ? &_scan_sse2 : NULL;
+
+        case ESTR_SIMD_SSSE3:
+            return __builtin_cpu_supports("ssse3") ? &_scan_ssse3 : NULL;
+
+        case ESTR_SIMD_AVX2:
+            return __builtin_cpu_supports("avx2") ? &_scan_avx2 : NULL;
+#endif
+
+#ifdef _SCAN_NEON
+        case ESTR_SIMD_NEON:
+            return &_scan_neon;
+#endif
+
+        default:
+            return NULL;
+    }
+}
+
+const estr_scan_t* estr_scan(void) {
+    const estr_scan_t* scan = _scan_selected;
+
+    if(! scan) {
+        _scan_selected = scan = _scan_of(ESTR_SIMD_AUTO);
+    }
+
+    return scan;
+}
+
+#ifdef __GNUC__
+__attribute__((constructor)) static void _scan_init(void) {
+    estr_scan();
+}
+#endif
+
+cu_err_t estr_simd_set(estr_simd_t simd) {
+    const estr_scan_t* scan = _scan_of(simd);
+
+    if(! scan) {
+        return CU_ERR_NOT_FOUND;
+    }
+
+    _scan_selected = scan;
+    return CU_OK;
+}
+
+estr_simd_t estr_simd_get(void) {
+    return estr_scan()->simd;
+}
\ No newline at end of file
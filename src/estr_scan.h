@@ -0,0 +1,71 @@
+#ifndef _CUTILS_ESTR_SCAN_H_
+#define _CUTILS_ESTR_SCAN_H_
+
+#include "estr.h"
+#include <stdint.h>
+
+/**
+ * @brief Character scanning kernels (internal to estr).
+ *        Every kernel works on exactly len bytes, null characters are not special.
+ *        Best implementation for the running CPU (AVX2, SSE2, NEON, SWAR) is selected once.
+ */
+typedef struct {
+    estr_simd_t simd;                                                  /*<! Implementation */
+    size_t (*chrcnt)(const char* str, size_t len, char chr);          /*<! Number of chr occurrences */
+    size_t (*find_ws)(const char* str, size_t len);                   /*<! Index of first whitespace, or len */
+    size_t (*find_non_ws)(const char* str, size_t len);               /*<! Index of first non-whitespace, or len */
+    size_t (*find_non_digit)(const char* str, size_t len);            /*<! Index of first non-digit, or len */
+    size_t (*find_unescaped)(const char* str, size_t len, char chr);  /*<! Index of first chr not escaped by odd run of backslashes, or len */
+    size_t (*unescaped_all)(const char* str, size_t len, char chr,
+        size_t* positions, size_t cap);                               /*<! Number of unescaped chr, first cap positions are stored */
+    size_t (*find_chr2)(const char* str, size_t len, char a, char b); /*<! Index of first a or b, or len */
+    size_t (*find_url_unsafe)(const char* str, size_t len);           /*<! Index of first character which is not [A-Za-z0-9.-_~], or len */
+    size_t (*find_utf8_invalid)(const char* str, size_t len);         /*<! Index of first byte which isn't part of valid UTF-8 sequence, or len */
+    size_t (*utf8_count)(const char* str, size_t len);                /*<! Number of bytes which are not UTF-8 continuation bytes */
+    bool (*ieq)(const char* a, const char* b, size_t len);            /*<! Check if a and b are equal ignoring ASCII case */
+    void (*hex_encode)(const uint8_t* src, size_t len, char* dst);    /*<! Encode len bytes into 2 * len lowercase hex digits */
+    size_t (*hex_decode)(const char* src, size_t len, uint8_t* dst);  /*<! Decode pairs of hex digits up to the first invalid pair,
+                                                                           number of decoded characters */
+    size_t (*base64_encode)(const uint8_t* src, size_t len,
+        char* dst, bool url);                                         /*<! Encode whole 3 byte groups (no padding), number of encoded bytes */
+    size_t (*base64_decode)(const char* src, size_t len,
+        uint8_t* dst, bool url);                                      /*<! Decode 4 character groups up to the first one with character
+                                                                           out of the alphabet (or padding), number of decoded characters */
+} estr_scan_t;
+
+/**
+ * @brief Length of valid UTF-8 sequence at the beginning of str (0 if invalid or truncated)
+ */
+static inline size_t estr_utf8_seq(const uint8_t* str, size_t len) {
+    uint8_t c = str[0];
+
+    if(c < 0x80) { return 1; }
+    if(c < 0xC2 || c > 0xF4) { return 0; }
+
+    size_t n = c < 0xE0 ? 2 : c < 0xF0 ? 3 : 4;
+    uint8_t lo = 0x80, hi = 0xBF; // range of the second byte
+
+    if(c == 0xE0) { lo = 0xA0; }
+    else if(c == 0xED) { hi = 0x9F; }
+    else if(c == 0xF0) { lo = 0x90; }
+    else if(c == 0xF4) { hi = 0x8F; }
+
+    if(len < n || str[1] < lo || str[1] > hi) {
+        return 0;
+    }
+
+    for(size_t i = 2; i < n; i++) {
+        if((str[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * @brief Kernels selected for the running CPU (or forced with estr_simd_set)
+ */
+const estr_scan_t* estr_scan(void);
+
+#endif
\ No newline at end of file
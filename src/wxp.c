@@ -1,50 +1,106 @@
 #include "estr.h"
 #include "wxp.h"
 
-#define __ESC_QT  "\\\""
-#define __NESC_QT "\""
-#define __ESC_BS  "\\\\"
-#define __NESC_BS "\\"
-
-static cu_err_t _capture(int* argc, char*** argv, char** rec, char* ptr) {
+/**
+ * @brief Append word to builder with escaped quotes and backslashes unescaped (one pass, left to right)
+ */
+static cu_err_t _unescape(estr_builder_t* builder, estr_view_t word) {
     cu_err_t err = CU_OK;
-    char** _argv = NULL;
-    int _argc = *argc;
-    char* wrd = NULL;
-    char* _wrd = NULL;
-    cu_mem_check(_argv = realloc(*argv, ++_argc * sizeof(char*)));
-    cu_mem_check(wrd = strndup(*rec, ptr - *rec));
-    *rec = NULL;
+    const char* ptr = word.ptr;
+    const char* end = word.ptr + word.len;
+    const char* bs = NULL;
+
+    while((bs = memchr(ptr, '\\', end - ptr))) {
+        cu_err_checkr(estr_b_view(builder, (estr_view_t) { .ptr = ptr, .len = bs - ptr }));
+
+        if(bs + 1 < end && (bs[1] == '"' || bs[1] == '\\')) { // escape character is dropped
+            bs++;
+        }
 
-    if(strstr(wrd, __ESC_QT)) {
-        cu_mem_check(_wrd = estr_rep(wrd, __ESC_QT, __NESC_QT));
-        free(wrd);
-        wrd = _wrd;
-        _wrd = NULL;
+        cu_err_checkr(estr_b_chr(builder, *bs));
+        ptr = bs + 1;
     }
 
-    if(strstr(wrd, __ESC_BS)) {
-        cu_mem_check(_wrd = estr_rep(wrd, __ESC_BS, __NESC_BS));
-        free(wrd);
-        wrd = _wrd;
-        _wrd = NULL;
+    return estr_b_view(builder, (estr_view_t) { .ptr = ptr, .len = end - ptr });
+}
+
+/**
+ * @brief Type of the words array
+ */
+typedef struct {
+    size_t item_size;                                           /*<! Size of one word in the array */
+    cu_err_t (*store)(void* argv, int index, estr_view_t word,
+        const cu_allocator_t* allocator);                       /*<! Unescape word into the array */
+    void (*free)(void* argv, int argc,
+        const cu_allocator_t* allocator);                       /*<! Free the array and the words */
+} _wxp_list_t;
+
+static cu_err_t _store_str(void* argv, int index, estr_view_t word, const cu_allocator_t* allocator) {
+    cu_err_t err = CU_OK;
+    char** str = &((char**) argv)[index];
+
+    if(!memchr(word.ptr, '\\', word.len)) { // nothing to unescape
+        cu_mem_checkr(*str = cu_strndup(allocator, word.ptr, word.len));
+        return CU_OK;
     }
 
-    _argv[_argc - 1] = wrd;
-    goto _return;
+    char buf[ESTR_SSO_CAPACITY + 1];
+    estr_builder_t builder;
+    cu_err_checkr(estr_b_init(&builder, buf, sizeof(buf), allocator));
+    cu_err_check(_unescape(&builder, word));
+    cu_mem_check(*str = estr_b_finish(&builder));
 _error:
-    free(wrd);
-    if(_argc > *argc && _argv) {
-        _argv = realloc(*argv, (_argc = *argc) * sizeof(char*)); // rollback
-        _argv = *argv;
+    estr_b_free(&builder);
+    return err;
+}
+
+static void _free_str(void* argv, int argc, const cu_allocator_t* allocator) {
+    char** _argv = argv;
+    cu_list_freea(_argv, argc, allocator);
+}
+
+static cu_err_t _store_s(void* argv, int index, estr_view_t word, const cu_allocator_t* allocator) {
+    cu_err_t err = CU_OK;
+    estr_t* s = &((estr_t*) argv)[index];
+
+    if(!memchr(word.ptr, '\\', word.len)) { // nothing to unescape
+        return estra_s_init_view(s, word, allocator);
     }
-_return:
-    *argc = _argc;
-    *argv = _argv;
+
+    char buf[ESTR_SSO_CAPACITY + 1];
+    estr_builder_t builder;
+    cu_err_checkr(estr_b_init(&builder, buf, sizeof(buf), allocator));
+    cu_err_check(_unescape(&builder, word));
+    err = estra_s_init_view(s, (estr_view_t) { .ptr = builder.buf, .len = builder.len }, allocator);
+_error:
+    estr_b_free(&builder);
+    return err;
+}
+
+static void _free_s(void* argv, int argc, const cu_allocator_t* allocator) {
+    estra_s_list_free(argv, argc, allocator);
+}
+
+static const _wxp_list_t _list_str = { .item_size = sizeof(char*), .store = &_store_str, .free = &_free_str };
+static const _wxp_list_t _list_s = { .item_size = sizeof(estr_t), .store = &_store_s, .free = &_free_s };
+
+static cu_err_t _capture(int* argc, void** argv, char** rec, char* ptr, const _wxp_list_t* list, const cu_allocator_t* allocator) {
+    cu_err_t err = CU_OK;
+    void* _argv = NULL;
+    cu_mem_checkr(_argv = cu_realloc(allocator, *argv, *argc * list->item_size, (*argc + 1) * list->item_size));
+    *argv = _argv; // the list may already be moved by realloc, even if storing fails
+    cu_err_checkr(list->store(_argv, *argc, (estr_view_t) { .ptr = *rec, .len = ptr - *rec }, allocator));
+    *rec = NULL;
+    (*argc)++;
+
     return err;
 }
 
 cu_err_t wxp(const char* words, int* argc, char*** argv) {
+    return wxpa(words, argc, argv, NULL);
+}
+
+static cu_err_t _wxp(const char* words, int* argc, void** argv, const _wxp_list_t* list, const cu_allocator_t* allocator) {
     if(! words || ! argc || ! argv) {
         return CU_ERR_INVALID_ARG;
     }
@@ -57,7 +113,7 @@ cu_err_t wxp(const char* words, int* argc, char*** argv) {
     }
 
     int _argc = 0;
-    char** _argv = NULL;
+    void* _argv = NULL;
 
     char* ptr = (char*) words, * prev = NULL, * next = NULL, * rec = NULL;
     bool qt = false, qt_esc = false, bs_esc = false;
@@ -80,19 +136,19 @@ cu_err_t wxp(const char* words, int* argc, char*** argv) {
 
                 if(qt) {
                     if(rec && ptr != rec) {
-                        cu_err_check(_capture(&_argc, &_argv, &rec, ptr));
+                        cu_err_check(_capture(&_argc, &_argv, &rec, ptr, list, allocator));
                     }
 
                     rec = next;
                 }
                 else {
-                    cu_err_check(_capture(&_argc, &_argv, &rec, ptr));
+                    cu_err_check(_capture(&_argc, &_argv, &rec, ptr, list, allocator));
                 }
                 break;
 
             case ' ':
                 if(! rec || qt) { break; }
-                cu_err_check(_capture(&_argc, &_argv, &rec, ptr));
+                cu_err_check(_capture(&_argc, &_argv, &rec, ptr, list, allocator));
                 break;
             
             default:
@@ -104,7 +160,7 @@ cu_err_t wxp(const char* words, int* argc, char*** argv) {
     }
 
     if(rec) {
-        cu_err_check(_capture(&_argc, &_argv, &rec, ptr));
+        cu_err_check(_capture(&_argc, &_argv, &rec, ptr, list, allocator));
     }
 
     if(qt) { // last quote not closed
@@ -114,9 +170,23 @@ cu_err_t wxp(const char* words, int* argc, char*** argv) {
 
     goto _return;
 _error:
-    cu_list_free(_argv, _argc);
+    if(_argv) { list->free(_argv, _argc, allocator); }
+    _argv = NULL;
+    _argc = 0;
 _return:
     *argc = _argc;
     *argv = _argv;
     return err;
+}
+
+cu_err_t wxpa(const char* words, int* argc, char*** argv, const cu_allocator_t* allocator) {
+    return _wxp(words, argc, (void**) argv, &_list_str, allocator);
+}
+
+cu_err_t wxp_s(const char* words, int* argc, estr_t** argv) {
+    return wxpa_s(words, argc, argv, NULL);
+}
+
+cu_err_t wxpa_s(const char* words, int* argc, estr_t** argv, const cu_allocator_t* allocator) {
+    return _wxp(words, argc, (void**) argv, &_list_s, allocator);
 }
\ No newline at end of file
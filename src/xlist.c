@@ -1,21 +1,110 @@
 #include "xlist.h"
+#include <stdint.h>
+
+struct xslab {
+    xslab_t next;             /*<! Next slab */
+    struct xnode nodes[];     /*<! Nodes */
+};
+
+/**
+ * @brief Allocate slab of n nodes and push all of them to the free list
+ */
+static cu_err_t _xlist_slab_add(xlist_t list, unsigned int n) {
+    size_t max_nodes = (SIZE_MAX - sizeof(struct xslab)) / sizeof(struct xnode);
+
+    if((size_t) n > max_nodes) {
+        return CU_ERR_NO_MEM;
+    }
+
+    xslab_t slab = NULL;
+    cu_mem_checkr(slab = cu_alloc(&list->allocator, sizeof(struct xslab) + n * sizeof(struct xnode)));
+
+    slab->next = list->slabs;
+    list->slabs = slab;
+
+    for(unsigned int i = 0; i < n; i++) {
+        slab->nodes[i].next = list->free_nodes;
+        list->free_nodes = &slab->nodes[i];
+    }
+
+    list->pool_free += n;
+    return CU_OK;
+}
+
+static xnode_t _xlist_node_alloc(xlist_t list, void* data) {
+    if(list->pool == XLIST_POOL_NONE) {
+        return cu_tctora(&list->allocator, xnode_t, struct xnode, .data = data);
+    }
+
+    if(! list->free_nodes && (list->pool == XLIST_POOL_FIXED || _xlist_slab_add(list, list->pool_size) != CU_OK)) {
+        return NULL;
+    }
+
+    xnode_t node = list->free_nodes;
+    list->free_nodes = node->next;
+    list->pool_free--;
+    *node = (struct xnode){ .data = data };
+    return node;
+}
+
+static void _xlist_node_free(xlist_t list, xnode_t node) {
+    if(list->pool == XLIST_POOL_NONE) {
+        cu_free(&list->allocator, node);
+        return;
+    }
+
+    node->next = list->free_nodes;
+    list->free_nodes = node;
+    list->pool_free++;
+}
 
 cu_err_t xlist_create(xlist_config_t* config, xlist_t* list) {
     if(! list) {
         return CU_ERR_INVALID_ARG;
     }
 
+    const cu_allocator_t* allocator = config ? config->allocator : NULL;
     xlist_t _list = NULL;
-    cu_mem_checkr(_list = cu_tctor(xlist_t, struct xlist));
+    cu_mem_checkr(_list = cu_tctora(allocator, xlist_t, struct xlist));
 
     if(config) {
         _list->data_free_handler = config->data_free_handler;
     }
 
+    if(allocator) {
+        _list->allocator = *allocator;
+    }
+
+    if(config && config->pool != XLIST_POOL_NONE) {
+        _list->pool = config->pool;
+        _list->pool_size = config->pool_size > 0 ? config->pool_size : XLIST_POOL_DEFAULT_SIZE;
+
+        if(_list->pool == XLIST_POOL_FIXED && _xlist_slab_add(_list, _list->pool_size) != CU_OK) {
+            xlist_destroy(_list);
+            return CU_ERR_NO_MEM;
+        }
+    }
+
     *list = _list;
     return CU_OK;
 }
 
+cu_err_t xlist_reserve(xlist_t list, unsigned int n) {
+    if(! list || list->pool == XLIST_POOL_NONE) {
+        return CU_ERR_INVALID_ARG;
+    }
+
+    if(list->pool_free >= n) {
+        return CU_OK;
+    }
+
+    if(list->pool == XLIST_POOL_FIXED) {
+        return CU_ERR_NO_MEM;
+    }
+
+    return _xlist_slab_add(list, n - list->pool_free);
+}
+
 int xlist_size(xlist_t list) {
     return ! list ? CU_ERR_INVALID_ARG : (int) list->len;
 }
@@ -25,11 +114,8 @@ int xlist_size(xlist_t list) {
         return CU_ERR_INVALID_ARG;        \
     }                                     \
     xnode_t _node = NULL;                 \
-    cu_mem_checkr(_node = cu_tctor(       \
-        xnode_t,                          \
-        struct xnode,                     \
-        .data = data                      \
-    ));                                   \
+    cu_mem_checkr(_node =                 \
+        _xlist_node_alloc(list, data));   \
     list->len++;                          \
     if(! list->head) {                    \
         list->head = list->tail = _node;  \
@@ -103,7 +189,7 @@ static void _xlist_popfree(xlist_t list, xnode_t node) {
     node->next = node->prev = NULL;
     if(list->data_free_handler) { list->data_free_handler(node->data); }
     node->data = NULL;
-    free(node);
+    _xlist_node_free(list, node);
     list->len--;
 }
 
@@ -172,6 +258,15 @@ cu_err_t xlist_destroy(xlist_t list) {
         return err;
     }
 
-    free(list);
+    cu_allocator_t allocator = list->allocator;
+    xslab_t slab = list->slabs;
+
+    while(slab) {
+        xslab_t next = slab->next;
+        cu_free(&allocator, slab);
+        slab = next;
+    }
+
+    cu_free(&allocator, list);
     return CU_OK;
 }
\ No newline at end of file
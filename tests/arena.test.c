@@ -0,0 +1,113 @@
+#include "arena.h"
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+static int allocations = 0;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    (*(int*) ctx)++;
+    return malloc(size);
+}
+
+static void counting_free(void* ctx, void* ptr) {
+    (*(int*) ctx)--;
+    free(ptr);
+}
+
+static void test_alloc() {
+    cu_arena_t arena = NULL;
+    assert(cu_arena_create(NULL, NULL) == CU_ERR_INVALID_ARG);
+    assert(cu_arena_create(&(cu_arena_config_t) {
+        .block_size = 64,
+        .allocator = &(cu_allocator_t) {
+            .alloc = &counting_alloc,
+            .free = &counting_free,
+            .ctx = &allocations
+        }
+    }, &arena) == CU_OK);
+    assert(allocations == 1); // just the arena
+    assert(cu_arena_used(arena) == 0);
+    assert(cu_arena_capacity(arena) == 0);
+
+    char* a = cu_arena_alloc(arena, 3);
+    assert(a && ((uintptr_t) a % sizeof(void*)) == 0);
+    memcpy(a, "ab", 3);
+    assert(allocations == 2);
+
+    char* b = cu_arena_alloc(arena, 10);
+    assert(b && b != a);
+    assert(((uintptr_t) b % sizeof(void*)) == 0);
+    assert(allocations == 2); // same block
+    assert(strcmp(a, "ab") == 0);
+
+    char* big = cu_arena_alloc(arena, 200);
+    assert(big);
+    assert(allocations == 3); // new block bigger than block_size
+    assert(cu_arena_capacity(arena) >= 64 + 200);
+
+    size_t capacity = cu_arena_capacity(arena);
+    assert(cu_arena_reset(arena) == CU_OK);
+    assert(cu_arena_used(arena) == 0);
+    assert(cu_arena_capacity(arena) == capacity);
+
+    // after reset blocks are reused, no new allocations
+    assert(cu_arena_alloc(arena, 10));
+    assert(cu_arena_alloc(arena, 150));
+    assert(allocations == 3);
+
+    assert(cu_arena_destroy(arena) == CU_OK);
+    assert(allocations == 0);
+}
+
+static void test_realloc() {
+    cu_arena_t arena = NULL;
+    assert(cu_arena_create(&(cu_arena_config_t) { .block_size = 128 }, &arena) == CU_OK);
+
+    char* a = cu_arena_realloc(arena, NULL, 4);
+    assert(a);
+    memcpy(a, "abc", 4);
+    char* _a = cu_arena_realloc(arena, a, 32);
+    assert(_a == a); // last allocation grows in place
+    assert(strcmp(_a, "abc") == 0);
+
+    char* b = cu_arena_alloc(arena, 8);
+    assert(b);
+    _a = cu_arena_realloc(arena, a, 64);
+    assert(_a && _a != a); // moved
+    assert(strcmp(_a, "abc") == 0);
+
+    size_t used = cu_arena_used(arena);
+    char* c = cu_arena_alloc(arena, 16);
+    cu_arena_free(arena, c); // last allocation is given back
+    assert(cu_arena_used(arena) == used);
+
+    assert(cu_arena_destroy(arena) == CU_OK);
+}
+
+static void test_allocator() {
+    cu_arena_t arena = NULL;
+    cu_allocator_t allocator;
+    assert(cu_arena_create(NULL, &arena) == CU_OK);
+    assert(cu_arena_allocator(NULL, &allocator) == CU_ERR_INVALID_ARG);
+    assert(cu_arena_allocator(arena, &allocator) == CU_OK);
+
+    char* str = cu_strdup(&allocator, "hello");
+    assert(str && strcmp(str, "hello") == 0);
+    int* nums = cu_calloc(&allocator, 4, sizeof(int));
+    assert(nums && nums[0] == 0 && nums[3] == 0);
+    cu_free(&allocator, nums);
+    cu_free(&allocator, str); // noop, not the last one
+    assert(strcmp(str, "hello") == 0);
+
+    assert(cu_arena_destroy(arena) == CU_OK);
+    assert(cu_arena_destroy(NULL) == CU_ERR_INVALID_ARG);
+}
+
+int main() {
+    test_alloc();
+    test_realloc();
+    test_allocator();
+
+    return 0;
+}
\ No newline at end of file
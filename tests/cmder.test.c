@@ -78,8 +78,16 @@ static void test_run_raw_args();
 static void test_signatures();
 static void test_with_no_prefix();
 static void test_man();
+static void test_allocator();
+static void test_arena();
+static void test_intern();
+static void test_case_insensitive();
 
 int main() {
+    test_allocator();
+    test_arena();
+    test_intern();
+    test_case_insensitive();
     test_man();
     test_with_no_prefix();
     test_signatures();
@@ -300,7 +308,7 @@ static void test_man() {
     assert(manual);
     assert(manual_len == strlen(manual));
     //printf("%s\n", manual);
-    free(manual);
+    assert(cmder_free(cmder, manual) == CU_OK);
 }
 
 static void test_with_no_prefix() {
@@ -328,41 +336,41 @@ static void test_signatures() {
     unsigned int sig_len;
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch") && estr_eq(sig, "touch"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'a' }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION]") && estr_eq(sig, "touch [OPTION]"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'f' }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION] ...") && estr_eq(sig, "touch [OPTION] ..."));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'b', .is_arg = true, .is_optional = true }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION] ... [-b bval]") 
         && estr_eq(sig, "touch [OPTION] ... [-b bval]"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'c', .is_arg = true, .is_optional = true }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION] ... [-b bval] [-c cval]") 
         && estr_eq(sig, "touch [OPTION] ... [-b bval] [-c cval]"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'd', .is_arg = true, .is_optional = false }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION] ... [-b bval] [-c cval] -d dval") 
         && estr_eq(sig, "touch [OPTION] ... [-b bval] [-c cval] -d dval"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 
     assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'e', .is_arg = true, .is_optional = false }) == CU_OK);
     assert(cmder_cmd_signature(cmd, &sig, &sig_len) == CU_OK);
     assert(sig && sig_len == strlen("touch [OPTION] ... [-b bval] [-c cval] -d dval -e eval") 
         && estr_eq(sig, "touch [OPTION] ... [-b bval] [-c cval] -d dval -e eval"));
-    free(sig);
+    assert(cmder_free(cmder, sig) == CU_OK);
 }
 
 static void test_run_raw_args() {
@@ -409,7 +417,7 @@ static void test_getoopts(cmder_handle_t cmder) {
     assert(cmder_add_vopt(cmplx, &(cmder_opt_t){ .name = 'h' }) == CU_OK);
     assert(cmder_getoopts(cmplx, &tmp) == CU_OK);
     assert(estr_eq(tmp, ":ab:c:de:f:gh"));
-    free(tmp);
+    assert(cmder_free(cmder, tmp) == CU_OK);
 }
 
 static int _argc_;
@@ -505,7 +513,7 @@ static void error_cb(cmder_cmdval_t* cmdval) {
         assert(errstr_len > 0);
         assert(strlen(errstr) == errstr_len);
         //printf("%s\n", errstr);
-        free(errstr);
+        assert(cmder_free(cmdval->cmder, errstr) == CU_OK);
 
         return;
     }
@@ -549,6 +557,7 @@ static void test_error_callback() {
     assert(error);
     cmdval_err = CMDER_CMDVAL_NO_ERROR;
     error_triggered = error_cb_error = false;
+    assert(cmder_vrun(cmder, "pc") == CU_ERR_EMPTY_STRING); // only name, nothing to run
     assert(cmder_vrun(cmder, "pc error") == CU_OK); // it's ok to run without options
     assert(error_triggered && !error_cb_error && cmdval_err == CMDER_CMDVAL_NO_ERROR);
     cmdval_err = CMDER_CMDVAL_NO_ERROR;
@@ -731,4 +740,151 @@ static void test_error_callback() {
     error_triggered = error_cb_error = false;
     assert(cmder_vrun(cmder, "pc error -u xx") == CU_OK);
     assert(error_triggered && !error_cb_error && cmdval_err == CMDER_CMDVAL_NO_ERROR);
+}
+
+static int allocations = 0;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    (*(int*) ctx)++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* ptr, size_t size) {
+    if(!ptr) { (*(int*) ctx)++; }
+    return realloc(ptr, size);
+}
+
+static void counting_free(void* ctx, void* ptr) {
+    (*(int*) ctx)--;
+    free(ptr);
+}
+
+static void test_allocator() {
+    cmder_handle_t cmder = NULL;
+    assert(cmder_create(&(cmder_t){
+        .name = "esp",
+        .allocator = &(cu_allocator_t) {
+            .alloc = &counting_alloc,
+            .realloc = &counting_realloc,
+            .free = &counting_free,
+            .ctx = &allocations
+        }
+    }, &cmder) == CU_OK && cmder);
+    assert(allocations > 0);
+
+    cmder_cmd_handle_t cmd = NULL;
+    assert(cmder_add_cmd(cmder, &(cmder_cmd_t){ .name = "touch", .callback = &null_cb }, &cmd) == CU_OK);
+    assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'f', .is_arg = true, .description = "Path" }) == CU_OK);
+    assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'x' }) == CU_OK);
+
+    int before_run = allocations;
+    assert(cmder_vrun(cmder, "touch -f \"a b\" -x extra") == CU_OK);
+    assert(cmder_vrun(cmder, "touch -x") == CU_ERR_CMDER_OPT_VAL_MISSING);
+    assert(allocations == before_run);
+
+    char* manual = NULL;
+    assert(cmder_cmd_manual(cmd, &manual, NULL) == CU_OK && manual);
+    assert(allocations == before_run + 1);
+    assert(cmder_free(cmder, manual) == CU_OK);
+    assert(allocations == before_run);
+
+    assert(cmder_destroy(cmder) == CU_OK);
+    assert(allocations == 0);
+}
+
+static void test_arena() {
+    cmder_handle_t cmder = NULL;
+    cu_arena_t arena = NULL;
+    allocations = 0;
+
+    assert(cmder_create(&(cmder_t){ .name = "esp" }, &cmder) == CU_OK && cmder);
+    cmder_cmd_handle_t cmd = NULL;
+    assert(cmder_add_cmd(cmder, &(cmder_cmd_t){ .name = "touch", .callback = &null_cb }, &cmd) == CU_OK);
+    assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'f', .is_arg = true }) == CU_OK);
+    assert(cmder_add_vopt(cmd, &(cmder_opt_t){ .name = 'x' }) == CU_OK);
+
+    assert(cu_arena_create(&(cu_arena_config_t){
+        .allocator = &(cu_allocator_t) {
+            .alloc = &counting_alloc,
+            .free = &counting_free,
+            .ctx = &allocations
+        }
+    }, &arena) == CU_OK);
+
+    assert(cmder_run_arena(NULL, arena, "touch", NULL) == CU_ERR_INVALID_ARG);
+    assert(cmder_run_arena(cmder, NULL, "touch", NULL) == CU_ERR_INVALID_ARG);
+    assert(cmder_vrun_arena(cmder, arena, "touch -f \"a b\" -x extra") == CU_OK);
+    assert(cu_arena_used(arena) == 0); // reset after the run
+
+    int warmed_up = allocations;
+    assert(cmder_vrun_arena(cmder, arena, "touch -f c -x extra") == CU_OK);
+    assert(cmder_vrun_arena(cmder, arena, "touch -x") == CU_ERR_CMDER_OPT_VAL_MISSING);
+    assert(allocations == warmed_up); // no new blocks
+
+    assert(cu_arena_destroy(arena) == CU_OK);
+    assert(allocations == 0);
+    assert(cmder_destroy(cmder) == CU_OK);
+}
+
+static void test_intern() {
+    estr_intern_t intern = NULL;
+    cmder_handle_t cmder1 = NULL;
+    cmder_handle_t cmder2 = NULL;
+    cmder_cmd_handle_t cmd1 = NULL;
+    cmder_cmd_handle_t cmd2 = NULL;
+    cmder_opt_handle_t opt1 = NULL;
+    cmder_opt_handle_t opt2 = NULL;
+
+    assert(estr_intern_create(NULL, &intern) == CU_OK);
+    assert(cmder_create(&(cmder_t){ .name = "esp", .intern = intern }, &cmder1) == CU_OK);
+    assert(cmder_create(&(cmder_t){ .name = "esp", .intern = intern }, &cmder2) == CU_OK);
+    assert(cmder_add_cmd(cmder1, &(cmder_cmd_t){ .name = "touch", .callback = &null_cb }, &cmd1) == CU_OK);
+    assert(cmder_add_cmd(cmder2, &(cmder_cmd_t){ .name = "touch", .callback = &null_cb }, &cmd2) == CU_OK);
+    assert(cmder_add_opt(cmd1, &(cmder_opt_t){ .name = 'f', .is_arg = true, .description = "Path" }, &opt1) == CU_OK);
+    assert(cmder_add_opt(cmd2, &(cmder_opt_t){ .name = 'f', .is_arg = true, .description = "Path" }, &opt2) == CU_OK);
+    assert(opt1->description == opt2->description); // one copy shared by both commanders
+
+    estr_intern_stats_t stats;
+    assert(estr_intern_stats(intern, &stats) == CU_OK && stats.count == 3); // esp, touch, Path
+
+    assert(cmder_add_vcmd(cmder1, &(cmder_cmd_t){ .name = "touch", .callback = &null_cb }) == CU_ERR_CMDER_CMD_EXIST);
+    assert(cmder_get_cmd_by_name(cmder1, "touch", NULL) == CU_OK);
+    assert(cmder_get_cmd_by_name(cmder1, "rm", NULL) == CU_ERR_NOT_FOUND);
+    assert(cmder_vrun(cmder1, "touch -f a") == CU_OK);
+    assert(cmder_vrun(cmder1, "rm") == CU_ERR_CMDER_CMD_NOEXIST);
+
+    char* manual = NULL;
+    assert(cmder_cmd_manual(cmd2, &manual, NULL) == CU_OK && manual);
+    assert(cmder_free(cmder2, manual) == CU_OK);
+
+    assert(cmder_destroy(cmder1) == CU_OK);
+    assert(cmder_destroy(cmder2) == CU_OK);
+    assert(estr_intern_destroy(intern) == CU_OK);
+}
+
+static void test_case_insensitive() {
+    estr_intern_t intern = NULL;
+    cmder_handle_t cmder = NULL;
+    cmder_cmd_handle_t cmd = NULL;
+    cmder_cmd_handle_t found = NULL;
+
+    assert(estr_intern_create(NULL, &intern) == CU_OK);
+    assert(cmder_create(&(cmder_t){ .name = "esp", .name_as_cmdline_prefix = true, .intern = intern, .case_insensitive = true }, &cmder) == CU_OK);
+    assert(cmder_add_cmd(cmder, &(cmder_cmd_t){ .name = "Reboot", .callback = &null_cb }, &cmd) == CU_OK);
+    assert(cmder_add_vcmd(cmder, &(cmder_cmd_t){ .name = "REBOOT", .callback = &null_cb }) == CU_ERR_CMDER_CMD_EXIST);
+
+    assert(cmder_get_cmd_by_name(cmder, "reboot", &found) == CU_OK && found == cmd);
+    assert(cmder_get_cmd_by_name(cmder, "rEbOoT", &found) == CU_OK && found == cmd);
+    assert(cmder_get_cmd_by_name(cmder, "reboo", NULL) == CU_ERR_NOT_FOUND);
+    assert(cmder_vrun(cmder, "ESP reboot") == CU_OK);
+    assert(cmder_vrun(cmder, "Esp REBOOT") == CU_OK);
+    assert(cmder_vrun(cmder, "esp halt") == CU_ERR_CMDER_CMD_NOEXIST);
+    assert(cmder_destroy(cmder) == CU_OK);
+
+    // case-sensitive by default
+    assert(cmder_create(&(cmder_t){ .name = "esp" }, &cmder) == CU_OK);
+    assert(cmder_add_vcmd(cmder, &(cmder_cmd_t){ .name = "reboot", .callback = &null_cb }) == CU_OK);
+    assert(cmder_get_cmd_by_name(cmder, "Reboot", NULL) == CU_ERR_NOT_FOUND);
+    assert(cmder_destroy(cmder) == CU_OK);
+    assert(estr_intern_destroy(intern) == CU_OK);
 }
\ No newline at end of file
@@ -13,6 +13,75 @@ typedef test_struct_t* test_struct_handle_t;
 
 static char** create_list(int* len);
 
+static int allocations = 0;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    (*(int*) ctx)++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ctx, void* ptr, size_t size) {
+    if(!ptr) { (*(int*) ctx)++; }
+    return realloc(ptr, size);
+}
+
+static void counting_free(void* ctx, void* ptr) {
+    (*(int*) ctx)--;
+    free(ptr);
+}
+
+static void test_allocator() {
+    cu_allocator_t allocator = {
+        .alloc = &counting_alloc,
+        .realloc = &counting_realloc,
+        .free = &counting_free,
+        .ctx = &allocations
+    };
+
+    test_struct_t* sptr = cu_ctora(&allocator, test_struct_t, .num = 3);
+    assert(sptr && sptr->num == 3 && sptr->chr == 0 && !sptr->str);
+    assert(allocations == 1);
+    assert((sptr->str = cu_strdup(&allocator, "hello")));
+    assert(estr_eq(sptr->str, "hello"));
+    assert(allocations == 2);
+    cu_free(&allocator, sptr->str);
+    cu_free(&allocator, sptr);
+    assert(allocations == 0);
+
+    int len = 2;
+    char** list = cu_calloc(&allocator, len, sizeof(char*));
+    assert(list && !list[0] && !list[1]);
+    assert((list[0] = cu_strndup(&allocator, "abc", 2)) && estr_eq(list[0], "ab"));
+    assert((list[1] = cu_strndup(&allocator, "x", 5)) && estr_eq(list[1], "x"));
+    assert(allocations == 3);
+    cu_list_freea(list, len, &allocator);
+    assert(!list && len == 0);
+    assert(allocations == 0);
+
+    // without realloc memory is resized with alloc, copy and free
+    allocator.realloc = NULL;
+    char* str = NULL;
+    assert((str = cu_realloc(&allocator, NULL, 0, 4)) && allocations == 1);
+    memcpy(str, "abc", 4);
+    assert((str = cu_realloc(&allocator, str, 4, 64)) && estr_eq(str, "abc"));
+    assert(allocations == 1);
+    cu_free(&allocator, str);
+    assert(allocations == 0);
+
+    // without alloc the standard library is used for everything
+    allocator.alloc = NULL;
+    allocator.realloc = &counting_realloc;
+    assert((str = cu_strdup(&allocator, "std")) && (str = cu_realloc(&allocator, str, 4, 10)));
+    cu_free(&allocator, str);
+    assert(allocations == 0);
+
+    // NULL allocator falls back to the standard library
+    str = cu_strdup(NULL, "std");
+    assert(estr_eq(str, "std"));
+    assert((str = cu_realloc(NULL, str, 4, 10)));
+    cu_free(NULL, str);
+}
+
 int main() {
     // testing constants
 
@@ -90,6 +159,8 @@ int main() {
     assert(!list);
     assert(len == 0);
 
+    test_allocator();
+
     return 0;
 }
 
@@ -1,6 +1,9 @@
 #include "estr.h"
 #include "cutils.h"
 #include <assert.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdio.h>
 
 static void test_estr_eq() {
     assert( estr_eq("a", "a"));
@@ -60,6 +63,7 @@ static void test_estr_ew() {
     assert(!estr_ew_chr(NULL, 'a'));
     assert( estr_ew_chr("ab", 'b'));
     assert(!estr_ew_chr("ab", 'a'));
+    assert(!estr_ew_chr("", '\0'));
 }
 
 static void test_estrn_is_digit_only() {
@@ -136,6 +140,92 @@ static void test_estr_split() {
         estr_eq(_pcs[0], "a") && estr_eq(_pcs[1], "bc") && estr_eq(_pcs[2], "d")
     );
     cu_list_tfree(_pcs, size_t, _len);
+
+    _pcs = estr_split("", ',', &_len);
+    assert(_len == 0 && !_pcs);
+}
+
+static void test_estr_split_spans() {
+    const char* str = "..jan..feb.mar..";
+    estr_span_t* spans;
+    size_t len;
+
+    spans = estr_split_spans(str, '.', &len);
+    assert(len == 3 && spans);
+    assert(spans[0].offset == 2 && spans[0].len == 3);
+    assert(spans[1].offset == 7 && spans[1].len == 3);
+    assert(spans[2].offset == 11 && spans[2].len == 3);
+    assert(estrn_eq(str + spans[2].offset, "mar", spans[2].len));
+    free(spans);
+
+    spans = estr_split_spans("......", '.', &len);
+    assert(len == 0 && !spans);
+
+    spans = estr_split_spans("da", ',', &len);
+    assert(len == 1 && spans[0].offset == 0 && spans[0].len == 2);
+    free(spans);
+
+    // caller's buffer, pieces after the capacity are only counted
+    estr_span_t buf[2];
+    assert(estr_v_split_spans(estr_view_lit("a,bb,ccc,d"), ',', buf, 2) == 4);
+    assert(buf[0].offset == 0 && buf[0].len == 1 && buf[1].offset == 2 && buf[1].len == 2);
+    assert(estr_v_split_spans(estr_view_lit("a,bb,ccc,d"), ',', NULL, 0) == 4);
+    assert(estr_v_split_spans((estr_view_t) { "x,y", 2 }, ',', buf, 2) == 1); // not null-terminated
+    assert(estr_v_split_spans(estr_view(NULL), ',', buf, 2) == 0);
+
+    char** pcs = estr_split_packed("a,,bc,d,,", ',', &len);
+    assert(len == 3 && pcs);
+    assert(estr_eq(pcs[0], "a") && estr_eq(pcs[1], "bc") && estr_eq(pcs[2], "d"));
+    free(pcs); // single allocation
+
+    pcs = estr_split_packed(",,,", ',', &len);
+    assert(len == 0 && !pcs);
+
+    pcs = estr_split_packed("solo", ',', &len);
+    assert(len == 1 && estr_eq(pcs[0], "solo"));
+    free(pcs);
+}
+
+static void test_estr_split_iter() {
+    estr_split_iter_t it = estr_split_iter("..jan..feb.mar..", '.');
+    estr_view_t piece;
+
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("jan")));
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("feb")));
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("mar")));
+    assert(!estr_split_next(&it, &piece));
+    assert(!estr_split_next(&it, &piece)); // stays exhausted
+
+    it = estr_split_iter("......", '.');
+    assert(!estr_split_next(&it, &piece));
+    it = estr_split_iter("", '.');
+    assert(!estr_split_next(&it, &piece));
+    it = estr_split_iter(NULL, '.');
+    assert(!estr_split_next(&it, &piece));
+
+    it = estr_split_iter("da", ',');
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("da")));
+    assert(!estr_split_next(&it, &piece));
+
+    // view doesn't need to be null-terminated
+    it = estr_v_split_iter((estr_view_t) { "a,,bc,d,,e", 8 }, ',');
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("a")));
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("bc")));
+    assert(estr_split_next(&it, &piece) && estr_v_eq(piece, estr_view_lit("d")));
+    assert(!estr_split_next(&it, &piece));
+
+    // same pieces as estr_split
+    const char* line = "  ts  42 temp 21.5   hum  ";
+    size_t len;
+    char** pcs = estr_split(line, ' ', &len);
+    size_t i = 0;
+    it = estr_split_iter(line, ' ');
+    while(estr_split_next(&it, &piece)) {
+        assert(i < len && estr_v_eq(piece, estr_view(pcs[i])));
+        i++;
+    }
+    assert(i == len);
+    cu_list_tfree(pcs, size_t, len);
 }
 
 static void test_estr_cat() {
@@ -154,12 +244,174 @@ static void test_estr_cat() {
     free(res);
 }
 
+static void test_estr_builder() {
+    estr_builder_t b;
+    char stack[16];
+    char* str;
+
+    assert(estr_b_init(NULL, NULL, 0, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_b_init(&b, stack, 0, NULL) == CU_ERR_INVALID_ARG);
+
+    // fits in the initial buffer
+    assert(estr_b_init(&b, stack, sizeof(stack), NULL) == CU_OK);
+    assert(b.len == 0 && estr_eq(b.buf, ""));
+    assert(estr_b_str(&b, "id=") == CU_OK);
+    assert(estr_b_i64(&b, -42) == CU_OK);
+    assert(estr_b_chr(&b, ';') == CU_OK);
+    assert(b.buf == stack && estr_eq(stack, "id=-42;") && b.len == 7);
+    str = estr_b_finish(&b); // copied out of the initial buffer
+    assert(str && str != stack && estr_eq(str, "id=-42;"));
+    free(str);
+    assert(b.len == 0 && b.buf == stack); // ready for reuse
+
+    // grows out of the initial buffer
+    assert(estr_b_cat(&b, "0123456789", "abcdef", "ghij") == CU_OK);
+    assert(b.owned && b.buf != stack && b.len == 20);
+    assert(estr_b_repeat(&b, '-', 100) == CU_OK);
+    assert(estr_b_view(&b, estr_v_sub(estr_view_lit("xyz"), 1, 1)) == CU_OK);
+    assert(estr_b_u64(&b, UINT64_MAX) == CU_OK);
+    assert(estr_b_i64(&b, INT64_MIN) == CU_OK);
+    assert(b.len == 20 + 100 + 1 + 20 + 20);
+    assert(estrn_eq(b.buf, "0123456789abcdefghij---", 23));
+    assert(estr_ew(b.buf, "-y18446744073709551615-9223372036854775808"));
+    char* buf = b.buf;
+    str = estr_b_finish(&b); // ownership handed over, no copy
+    assert(str == buf);
+    free(str);
+
+    // reserve
+    assert(estr_b_init(&b, NULL, 0, NULL) == CU_OK);
+    assert(estr_b_reserve(&b, 1000) == CU_OK && b.cap >= 1000);
+    buf = b.buf;
+    assert(estr_b_repeat(&b, 'x', 1000) == CU_OK && b.buf == buf);
+    estr_b_free(&b);
+    assert(b.len == 0 && !b.owned);
+
+    // empty result is still a string
+    assert(estr_b_init(&b, NULL, 0, NULL) == CU_OK);
+    str = estr_b_finish(&b);
+    assert(str && estr_eq(str, ""));
+    free(str);
+
+    // copy of the initial buffer keeps null characters, same as the owned buffer
+    assert(estr_b_init(&b, stack, sizeof(stack), NULL) == CU_OK);
+    assert(estr_b_view(&b, (estr_view_t) { .ptr = "a\0b", .len = 3 }) == CU_OK && b.buf == stack);
+    str = estr_b_finish(&b);
+    assert(str && memcmp(str, "a\0b", 4) == 0);
+    free(str);
+
+    // empty appends don't touch the shared empty buffer
+    assert(estr_b_init(&b, NULL, 0, NULL) == CU_OK);
+    assert(estr_b_view(&b, estr_view_lit("")) == CU_OK && estr_b_repeat(&b, 'x', 0) == CU_OK);
+    assert(estr_b_str(&b, "") == CU_OK && estr_b_cat(&b, "", "") == CU_OK && estr_b_url_encode(&b, "") == CU_OK);
+    assert(!b.owned && b.len == 0 && estr_eq(b.buf, ""));
+    estr_b_free(&b);
+
+    assert(estr_b_init(&b, stack, sizeof(stack), NULL) == CU_OK);
+    assert(estr_b_url_encode(&b, "a b&c") == CU_OK);
+    assert(estr_b_str(&b, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_eq(b.buf, "a+b%26c"));
+    estr_b_free(&b);
+}
+
 static void test_estr_url_encode() {
     char* res;
 
     res = estr_url_encode("👍");
     assert(estr_eq(res, "%f0%9f%91%8d"));
     free(res);
+
+    res = estr_url_encode("Hello World-._~ a&b=c/\xff");
+    assert(estr_eq(res, "Hello+World-._~+a%26b%3dc%2f%ff"));
+    free(res);
+
+    res = estr_url_encode("");
+    assert(estr_eq(res, ""));
+    free(res);
+
+    assert(!estr_url_encode(NULL));
+
+    // caller's buffer
+    char buf[16];
+    size_t len = 0;
+    assert(estr_v_url_encode_to(estr_view_lit("a b/c"), buf, sizeof(buf), &len) == CU_OK);
+    assert(len == 7 && estr_eq(buf, "a+b%2fc"));
+    assert(estr_v_url_encode_to(estr_view_lit("a b/c"), buf, 7, &len) == CU_ERR_OUT_OF_BOUNDS && len == 7);
+    assert(estr_v_url_encode_to(estr_view_lit("a b/c"), NULL, 0, &len) == CU_ERR_OUT_OF_BOUNDS && len == 7);
+    assert(estr_v_url_encode_to(estr_view(NULL), buf, sizeof(buf), &len) == CU_ERR_INVALID_ARG);
+
+    // every byte value, long enough for the vectorized paths
+    char all[256 * 2];
+    for(size_t i = 0; i < sizeof(all); i++) { all[i] = (char) (i < 256 ? i : 'x'); }
+    estr_builder_t b;
+    estr_b_init(&b, NULL, 0, NULL);
+    assert(estr_b_v_url_encode(&b, (estr_view_t) { all, 128 }) == CU_OK); // streaming, chunk by chunk
+    assert(estr_b_v_url_encode(&b, (estr_view_t) { all + 128, sizeof(all) - 128 }) == CU_OK);
+    for(size_t i = 0, j = 0; i < sizeof(all); i++) {
+        char chr = all[i];
+        if(isalnum((unsigned char) chr) || (chr && strchr("-._~", chr))) {
+            assert(b.buf[j++] == chr);
+        } else if(chr == ' ') {
+            assert(b.buf[j++] == '+');
+        } else {
+            assert(b.buf[j++] == '%' && b.buf[j++] == "0123456789abcdef"[(uint8_t) chr >> 4] && b.buf[j++] == "0123456789abcdef"[chr & 15]);
+        }
+        assert(i + 1 < sizeof(all) || j == b.len);
+    }
+
+    // and back
+    char* decoded = estr_url_decode(b.buf);
+    assert(decoded && estr_eq(decoded, "")); // decoded %00 terminates the string
+    free(decoded);
+    size_t decoded_len = 0;
+    char* decoded_buf = malloc(b.len + 1);
+    assert(estr_v_url_decode_to((estr_view_t) { b.buf, b.len }, decoded_buf, b.len + 1, &decoded_len) == CU_OK);
+    assert(decoded_len == sizeof(all) && memcmp(decoded_buf, all, sizeof(all)) == 0);
+    free(decoded_buf);
+    estr_b_free(&b);
+}
+
+static void test_estr_url_decode() {
+    char* res;
+
+    res = estr_url_decode("Hello+World%21%2F%2f-._~");
+    assert(estr_eq(res, "Hello World!//-._~"));
+    free(res);
+
+    res = estr_url_decode("");
+    assert(estr_eq(res, ""));
+    free(res);
+
+    assert(!estr_url_decode(NULL));
+    assert(!estr_url_decode("%"));
+    assert(!estr_url_decode("ab%4"));
+    assert(!estr_url_decode("%zz"));
+    assert(!estr_url_decode("%%%"));
+
+    char buf[8];
+    size_t len = 0;
+    assert(estr_v_url_decode_to(estr_view_lit("a%20b"), buf, sizeof(buf), &len) == CU_OK);
+    assert(len == 3 && estr_eq(buf, "a b"));
+    assert(estr_v_url_decode_to(estr_view_lit("a%20b"), buf, 3, &len) == CU_ERR_OUT_OF_BOUNDS && len == 3);
+    assert(estr_v_url_decode_to(estr_view_lit("a%2"), buf, sizeof(buf), &len) == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_url_decode_to(estr_view_lit("a%2x"), buf, sizeof(buf), &len) == CU_ERR_SYNTAX_ERROR);
+
+    // escape sequences split between chunks
+    const char* stream = "a%20b%2Fc+d%7e";
+    estr_url_decoder_t decoder = { 0 };
+    estr_builder_t b;
+    estr_b_init(&b, buf, sizeof(buf), NULL);
+    for(size_t i = 0; stream[i]; i++) {
+        assert(estr_url_decode_chunk(&decoder, (estr_view_t) { stream + i, 1 }, &b) == CU_OK);
+    }
+    assert(estr_url_decode_end(&decoder) == CU_OK);
+    assert(estr_eq(b.buf, "a b/c d~"));
+    estr_b_free(&b);
+
+    assert(estr_url_decode_chunk(&decoder, estr_view_lit("ab%2"), &b) == CU_OK);
+    assert(estr_url_decode_end(&decoder) == CU_ERR_SYNTAX_ERROR); // incomplete
+    assert(estr_url_decode_chunk(&decoder, estr_view_lit("%g0"), &b) == CU_ERR_SYNTAX_ERROR);
+    estr_b_free(&b);
 }
 
 static void test_estr_rep() {
@@ -181,6 +433,127 @@ static void test_estr_rep() {
     assert(!tmp);
 }
 
+static void test_estr_pattern() {
+    estr_pattern_t pattern;
+    const char* str = "the quick brown fox jumps over the lazy dog, the end";
+
+    assert(estr_pattern_compile(NULL, "x") == CU_ERR_INVALID_ARG);
+    assert(estr_pattern_compile(&pattern, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_pattern_compile(&pattern, "") == CU_ERR_INVALID_ARG);
+
+    assert(estr_pattern_compile(&pattern, "the") == CU_OK); // short (memchr)
+    assert(estr_find(&pattern, str) == str);
+    assert(estr_count(&pattern, str) == 3);
+    assert(estr_v_find(&pattern, estr_v_sub(estr_view(str), 1, 40)) == str + 31);
+    assert(!estr_v_find(&pattern, estr_view_lit("th")));
+
+    assert(estr_pattern_compile(&pattern, "lazy dog") == CU_OK); // long (Horspool)
+    assert(estr_find(&pattern, str) == strstr(str, "lazy dog"));
+    assert(estr_count(&pattern, str) == 1);
+    assert(!estr_find(&pattern, "lazy do"));
+    assert(!estr_find(&pattern, NULL));
+
+    assert(estr_pattern_compile(&pattern, "aa") == CU_OK);
+    assert(estr_count(&pattern, "aaaaa") == 2); // non-overlapping
+
+    // same results as strstr for every position
+    char buf[300];
+    char needle[] = "abcabcabd";
+    assert(estr_pattern_compile(&pattern, needle) == CU_OK);
+    for(size_t i = 0; i + sizeof(needle) < sizeof(buf); i += 7) {
+        memset(buf, 'a', sizeof(buf));
+        for(size_t j = 0; j < sizeof(buf) - 1; j += 3) { buf[j + 1] = 'b'; buf[j + 2] = 'c'; }
+        buf[sizeof(buf) - 1] = '\0';
+        memcpy(buf + i, needle, sizeof(needle) - 1);
+        assert(estr_find(&pattern, buf) == strstr(buf, needle));
+    }
+
+    char* tmp;
+    assert(estr_pattern_compile(&pattern, "{name}") == CU_OK);
+    tmp = estr_rep_p("Hi {name}, {name}{name}!", &pattern, "Bob");
+    assert(estr_eq(tmp, "Hi Bob, BobBob!"));
+    free(tmp);
+
+    tmp = estr_rep_p("nothing here", &pattern, "Bob");
+    assert(estr_eq(tmp, "nothing here"));
+    free(tmp);
+
+    tmp = estr_rep_p("{name}", &pattern, "");
+    assert(estr_eq(tmp, ""));
+    free(tmp);
+
+    // more matches than fit on the stack
+    char* many = estr_repeat_chr('x', 100);
+    assert(estr_pattern_compile(&pattern, "x") == CU_OK);
+    tmp = estr_rep_p(many, &pattern, "yz");
+    assert(tmp && strlen(tmp) == 200 && estr_v_chrcnt(estr_view(tmp), 'y') == 100);
+    free(tmp);
+    free(many);
+
+    assert(!estr_rep_p(NULL, &pattern, "y"));
+    assert(!estr_rep_p("x", NULL, "y"));
+    assert(!estr_rep_p("x", &pattern, NULL));
+}
+
+static void test_estr_rep_multi() {
+    estr_rep_multi_t multi = NULL;
+    char* tmp;
+
+    assert(estr_rep_multi_compile(NULL, 1, &multi) == CU_ERR_INVALID_ARG);
+    assert(estr_rep_multi_compile((estr_rep_pair_t[]) { { "a", "b" } }, 0, &multi) == CU_ERR_INVALID_ARG);
+    assert(estr_rep_multi_compile((estr_rep_pair_t[]) { { "", "b" } }, 1, &multi) == CU_ERR_INVALID_ARG);
+    assert(estr_rep_multi_compile((estr_rep_pair_t[]) { { "a", NULL } }, 1, &multi) == CU_ERR_INVALID_ARG);
+    assert(estr_rep_multi_compile((estr_rep_pair_t[]) { { "a", "b" } }, 1, NULL) == CU_ERR_INVALID_ARG);
+    assert(!multi);
+
+    assert(estr_rep_multi_compile((estr_rep_pair_t[]) {
+        { "{name}", "Bob" },
+        { "{n}", "42" },
+        { "{name}s", "Bobs" }, // longest wins
+        { "{n}", "duplicate" }, // first wins
+        { "ab", "x" },
+        { "b", "y" }
+    }, 6, &multi) == CU_OK && multi);
+
+    tmp = estr_rep_m("Hi {name}, {n} {name}s {nam", multi);
+    assert(estr_eq(tmp, "Hi Bob, 42 Bobs {nam"));
+    free(tmp);
+
+    tmp = estr_rep_m("abb", multi); // leftmost match wins, no rescan of the output
+    assert(estr_eq(tmp, "xy"));
+    free(tmp);
+
+    tmp = estr_rep_m("", multi);
+    assert(estr_eq(tmp, ""));
+    free(tmp);
+
+    tmp = estra_v_rep_m((estr_view_t) { "{n}{n}{n}", 6 }, multi, NULL);
+    assert(estr_eq(tmp, "4242"));
+    free(tmp);
+
+    // more matches than fit on the stack
+    char* many = estr_repeat_chr('b', 100);
+    tmp = estr_rep_m(many, multi);
+    assert(tmp && strlen(tmp) == 100 && estr_v_chrcnt(estr_view(tmp), 'y') == 100);
+    free(tmp);
+    free(many);
+
+    assert(!estr_rep_m(NULL, multi));
+    assert(!estr_rep_m("x", NULL));
+    assert(estr_rep_multi_destroy(multi) == CU_OK);
+    assert(estr_rep_multi_destroy(NULL) == CU_ERR_INVALID_ARG);
+
+    // same as chained estr_rep when patterns don't interfere
+    tmp = estr_rep_multi("<a href=\"x\">&</a>", (estr_rep_pair_t[]) {
+        { "&", "&amp;" },
+        { "<", "&lt;" },
+        { ">", "&gt;" },
+        { "\"", "&quot;" }
+    }, 4);
+    assert(estr_eq(tmp, "&lt;a href=&quot;x&quot;&gt;&amp;&lt;/a&gt;"));
+    free(tmp);
+}
+
 static void test_estr_trim() {
     assert(estr_is_trimmed("ddd"));
     assert(estr_is_trimmed(""));
@@ -197,6 +570,16 @@ static void test_escaping() {
     assert(!estr_contains_unescaped_chr("abc", '\"'));
     assert(!estr_contains_unescaped_chr("\\\"", '\"'));
     assert(estr_contains_unescaped_chr("asfd\"test\"", '\"'));
+    assert(estr_contains_unescaped_chr("\\\\\"", '\"')); // escaped backslash
+    assert(!estr_contains_unescaped_chr("\\\\\\\"", '\"'));
+    assert(estr_contains_unescaped_chr("\\\\\\\\\"", '\"'));
+
+    size_t positions[4];
+    assert(estr_find_unescaped("\"a\\\"b\\\\\"c\"", '"', positions, 4) == 3);
+    assert(positions[0] == 0 && positions[1] == 7 && positions[2] == 9);
+    assert(estr_find_unescaped("\"\"\"", '"', positions, 2) == 3); // counted, not stored
+    assert(estr_find_unescaped("\"\"\"", '"', NULL, 0) == 3);
+    assert(estr_find_unescaped(NULL, '"', positions, 4) == 0);
 }
 
 static void test_empty() {
@@ -291,6 +674,1108 @@ static void test_validation() {
     assert(estr_validate("  ", &(estr_validation_t){
         .no_whitespace = true
     }) == CU_ERR_ESTR_INVALID_WHITESPACE);
+
+    // whitespace is reported before length
+    assert(estr_validate("too long name", &(estr_validation_t){
+        .length = true, .minlen = 1, .maxlen = 4, .no_whitespace = true
+    }) == CU_ERR_ESTR_INVALID_WHITESPACE);
+    assert(estr_validate("toolongname", &(estr_validation_t){
+        .length = true, .minlen = 1, .maxlen = 4, .no_whitespace = true
+    }) == CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS);
+
+    estr_validation_t validation = { .length = true, .minlen = 2 };
+    assert(estr_validate("ab", &validation) == CU_OK);
+    assert(validation.maxlen == 0); // schema is not modified
+
+    estr_schema_t schema;
+    assert(estr_schema_compile(NULL, &schema) == CU_ERR_INVALID_ARG);
+    assert(estr_schema_compile(&(estr_validation_t){ .charset = "z-a" }, &schema) == CU_ERR_INVALID_ARG);
+
+    assert(estr_schema_compile(&(estr_validation_t){
+        .length = true,
+        .minlen = 3,
+        .maxlen = 16,
+        .charset = "a-z0-9_-",
+        .prefix = "id_",
+        .suffix = "-x"
+    }, &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("id_ab-x"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("id_a-b-x"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("id"), &schema) == CU_ERR_ESTR_INVALID_OUT_OF_BOUNDS);
+    assert(estr_v_validate(estr_view("ab_cd-x"), &schema) == CU_ERR_ESTR_INVALID_PREFIX);
+    assert(estr_v_validate(estr_view("id_cd-y"), &schema) == CU_ERR_ESTR_INVALID_SUFFIX);
+    assert(estr_v_validate(estr_view("id_Cd-x"), &schema) == CU_ERR_ESTR_INVALID_CHAR);
+    assert(estr_v_validate(estr_view("id_c d-x"), &schema) == CU_ERR_ESTR_INVALID_CHAR);
+
+    assert(estr_schema_compile(&(estr_validation_t){ .digits_only = true, .no_whitespace = true }, &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("0123456789012345678901234567890123456789"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("01234567890123456789012345678901234567x9"), &schema) == CU_ERR_ESTR_INVALID_CHAR);
+    assert(estr_v_validate(estr_view("0123456789012345678901234567890123456 89"), &schema) == CU_ERR_ESTR_INVALID_WHITESPACE);
+
+    assert(estr_schema_compile(&(estr_validation_t){ .utf8 = true }, &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("ascii only, long enough for the fast path"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("\xC5\xA1ljivovica \xE2\x82\xAC \xF0\x9F\x98\x80"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("overlong \xC0\xAF"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_v_validate(estr_view("surrogate \xED\xA0\x80"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_v_validate(estr_view("too big \xF4\x90\x80\x80"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_v_validate(estr_view("truncated \xE2\x82"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_v_validate(estr_view("\x80"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+
+    // UTF-8 checked in the same pass as the charset
+    assert(estr_schema_compile(&(estr_validation_t){ .utf8 = true, .charset = "a-z\x80-\xFF" }, &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("ab\xC5\xA1" "c"), &schema) == CU_OK);
+    assert(estr_v_validate(estr_view("ab\xC5" "c"), &schema) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_v_validate(estr_view("aB\xC5\xA1" "c"), &schema) == CU_ERR_ESTR_INVALID_CHAR);
+
+    // whitespace and UTF-8 checked block by block, sequences across block ends
+    static char text[3 * 4096 + 8];
+    estr_view_t text_view = { .ptr = text, .len = sizeof(text) };
+    assert(estr_schema_compile(&(estr_validation_t){ .utf8 = true, .no_whitespace = true }, &schema) == CU_OK);
+
+    for(size_t shift = 0; shift < 4; shift++) {
+        memset(text, 'a', sizeof(text));
+        for(size_t i = shift; i + 4 <= sizeof(text); i += 4) { memcpy(text + i, "\xF0\x9F\x98\x80", 4); }
+        assert(estr_v_validate(text_view, &schema) == CU_OK);
+        text[4096 + 1] = 'a'; // breaks the sequence around the end of the first block
+        assert(estr_v_validate(text_view, &schema) == CU_ERR_ESTR_INVALID_UTF8);
+        text[sizeof(text) - 1] = ' ';
+        assert(estr_v_validate(text_view, &schema) == CU_ERR_ESTR_INVALID_WHITESPACE);
+    }
+
+    char* argv[] = { "touch", "-f", "file name", "x" };
+    size_t index = 0;
+    assert(estr_schema_compile(&(estr_validation_t){ .no_whitespace = true }, &schema) == CU_OK);
+    assert(estr_validate_many(argv, 2, &schema, &index) == CU_OK);
+    assert(estr_validate_many(argv, 4, &schema, &index) == CU_ERR_ESTR_INVALID_WHITESPACE && index == 2);
+    assert(estr_validate_many(NULL, 0, &schema, NULL) == CU_OK);
+    assert(estr_validate_many(argv, 4, NULL, NULL) == CU_ERR_INVALID_ARG);
+}
+
+static void test_view() {
+    estr_view_t view = estr_view("hello world");
+    assert(view.len == 11);
+    assert(estr_view(NULL).ptr == NULL && estr_view(NULL).len == 0);
+    assert(estrn_view("hello", 3).len == 3);
+    assert(estrn_view("hi", 10).len == 2);
+    assert(estr_view_lit("hello").len == 5);
+
+    assert( estr_v_eq(estr_view_lit("hello"), estr_v_sub(view, 0, 5)));
+    assert( estr_v_eq(estr_view_lit("world"), estr_v_sub(view, 6, 100)));
+    assert( estr_v_eq(estr_view_lit(""), estr_v_sub(view, 100, 1)));
+    assert(!estr_v_eq(estr_view_lit("hello"), view));
+    assert(!estr_v_eq(estr_view(NULL), estr_view(NULL)));
+
+    assert( estr_v_sw(view, estr_view_lit("hell")));
+    assert(!estr_v_sw(view, estr_view_lit("")));
+    assert(!estr_v_sw(estr_view_lit("he"), estr_view_lit("hell")));
+    assert( estr_v_sw_chr(view, 'h'));
+    assert(!estr_v_sw_chr(estr_view_lit(""), '\0'));
+    assert( estr_v_ew(view, estr_view_lit("world")));
+    assert( estr_v_ew(view, view));
+    assert(!estr_v_ew(view, estr_view_lit("")));
+    assert(!estr_v_ew(estr_view_lit("ld"), estr_view_lit("world")));
+    assert( estr_v_ew_chr(view, 'd'));
+    assert(!estr_v_ew_chr(estr_view_lit(""), '\0'));
+
+    // views don't need to be null-terminated
+    const char digits[] = { '1', '2', '3', 'x' };
+    assert( estr_v_is_digit_only((estr_view_t) { digits, 3 }));
+    assert(!estr_v_is_digit_only((estr_view_t) { digits, 4 }));
+    assert(!estr_v_is_digit_only(estr_view(NULL)));
+    assert(estr_v_chrcnt(view, 'o') == 2);
+    assert(estr_v_chrcnt(estr_v_sub(view, 0, 5), 'o') == 1);
+    assert(estr_v_chrcnt(estr_view(NULL), 'o') == 0);
+
+    assert( estr_v_is_trimmed(view));
+    assert( estr_v_is_trimmed(estr_view_lit("")));
+    assert(!estr_v_is_trimmed(estr_v_sub(view, 0, 6)));
+    assert(!estr_v_is_trimmed(estr_view(NULL)));
+    assert( estr_v_contains_ws(view));
+    assert(!estr_v_contains_ws(estr_v_sub(view, 0, 5)));
+    assert( estr_v_is_empty_ws(estr_v_sub(view, 5, 1)));
+    assert(!estr_v_is_empty_ws(view));
+    assert( estr_v_contains_unescaped_chr(estr_view_lit("a\\\"b\""), '"'));
+    assert(!estr_v_contains_unescaped_chr(estr_v_sub(estr_view_lit("a\\\"b\""), 0, 4), '"'));
+
+    char* dup = estr_v_dup(estr_v_sub(view, 6, 5));
+    assert(estr_eq(dup, "world"));
+    free(dup);
+    assert(!estr_v_dup(estr_view(NULL)));
+}
+
+static size_t ref_chrcnt(const char* str, char chr, size_t n) {
+    size_t cnt = 0;
+    for(size_t i = 0; i < n && str[i]; i++) { cnt += str[i] == chr; }
+    return cnt;
+}
+
+static bool ref_digit_only(const char* str, size_t n) {
+    for(size_t i = 0; i < n && str[i]; i++) { if(str[i] < '0' || str[i] > '9') { return false; } }
+    return true;
+}
+
+static bool ref_contains_ws(const char* str) {
+    for(; *str; str++) { if(estr_chr_is_ws(*str)) { return true; } }
+    return false;
+}
+
+static bool ref_empty_ws(const char* str) {
+    for(; *str; str++) { if(!estr_chr_is_ws(*str)) { return false; } }
+    return true;
+}
+
+static size_t ref_unescaped_all(const char* str, char chr, size_t* positions) {
+    size_t count = 0;
+    for(size_t i = 0; str[i]; i++) {
+        size_t run = 0;
+        while(run < i && str[i - run - 1] == '\\') { run++; }
+        if(str[i] == chr && run % 2 == 0) { positions[count++] = i; }
+    }
+    return count;
+}
+
+static bool ref_unescaped(const char* str, char chr) {
+    size_t positions[256];
+    return ref_unescaped_all(str, chr, positions) > 0;
+}
+
+/**
+ * @brief Run the check with every instruction set supported here (each one is selected exactly),
+ *        then go back to the automatically selected one
+ */
+static void for_each_simd(void (*check)()) {
+    static const estr_simd_t levels[] = { ESTR_SIMD_NONE, ESTR_SIMD_SSE2, ESTR_SIMD_SSSE3, ESTR_SIMD_AVX2, ESTR_SIMD_NEON };
+    for(size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        if(estr_simd_set(levels[l]) != CU_OK) {
+            continue; // not supported here
+        }
+
+        assert(estr_simd_get() == levels[l]);
+        check();
+    }
+
+    assert(estr_simd_set(ESTR_SIMD_AUTO) == CU_OK);
+}
+
+static void check_simd_scan() {
+    static const char alphabet[] = "0123456789     \t\r\n\\\\\"\"\"aZ.\x80\xff\x0b\x2f\x3a";
+    char buf[200];
+    srand(42);
+
+    for(int round = 0; round < 3000; round++) {
+        size_t len = rand() % (sizeof(buf) - 1);
+        int mode = rand() % 4;
+        for(size_t i = 0; i < len; i++) {
+            switch(mode) {
+                case 0: buf[i] = alphabet[rand() % (sizeof(alphabet) - 1)]; break;
+                case 1: buf[i] = '0' + rand() % 10; break;
+                case 2: buf[i] = " \t\n"[rand() % 3]; break;
+                default: buf[i] = rand() % 50 == 0 ? '"' : (rand() % 2 ? '\\' : 'a'); break;
+            }
+        }
+        buf[len] = '\0';
+
+        // occasionally put the interesting byte at the very end
+        if(len > 0 && rand() % 4 == 0) { buf[len - 1] = " 9\"x"[rand() % 4]; }
+
+        size_t n = rand() % (len + 2);
+        assert(estrn_chrcnt(buf, '"', n) == ref_chrcnt(buf, '"', n));
+        assert(estrn_chrcnt(buf, ' ', len) == ref_chrcnt(buf, ' ', len));
+        assert(estrn_chrcnt(buf, '\x80', len) == ref_chrcnt(buf, '\x80', len));
+        assert(estrn_is_digit_only(buf, n) == ref_digit_only(buf, n));
+        assert(estrn_is_digit_only(buf, len) == ref_digit_only(buf, len));
+        assert(estr_contains_ws(buf) == ref_contains_ws(buf));
+        assert(estr_is_empty_ws(buf) == ref_empty_ws(buf));
+        assert(estr_contains_unescaped_chr(buf, '"') == ref_unescaped(buf, '"'));
+        assert(estr_contains_unescaped_chr(buf, '\\') == ref_unescaped(buf, '\\'));
+
+        size_t positions[256], ref_positions[256], count;
+        count = ref_unescaped_all(buf, '"', ref_positions);
+        assert(estr_find_unescaped(buf, '"', positions, 256) == count);
+        assert(memcmp(positions, ref_positions, count * sizeof(size_t)) == 0);
+        count = ref_unescaped_all(buf, '\\', ref_positions);
+        assert(estr_find_unescaped(buf, '\\', positions, 256) == count);
+        assert(memcmp(positions, ref_positions, count * sizeof(size_t)) == 0);
+
+        char* encoded = estr_url_encode(buf);
+        size_t encoded_len = len;
+        for(size_t i = 0; i < len; i++) {
+            encoded_len += (isalnum((unsigned char) buf[i]) || strchr(" -._~", buf[i])) ? 0 : 2;
+        }
+        assert(encoded && strlen(encoded) == encoded_len);
+        char* decoded = estr_url_decode(encoded);
+        assert(decoded && estr_eq(decoded, buf));
+        free(decoded);
+        free(encoded);
+    }
+}
+
+static void test_simd() {
+    estr_simd_t initial = estr_simd_get();
+
+    assert(initial != ESTR_SIMD_AUTO);
+    assert(estr_simd_set(ESTR_SIMD_NONE) == CU_OK);
+    assert(estr_simd_get() == ESTR_SIMD_NONE);
+
+    for_each_simd(&check_simd_scan);
+    assert(estr_simd_get() == initial); // automatic selection is the same as on startup
+}
+
+static size_t ref_utf8_invalid(const uint8_t* str, size_t len) {
+    static const uint32_t min[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    size_t i = 0;
+
+    while(i < len) {
+        uint32_t cp = str[i];
+        size_t n;
+
+        if(cp < 0x80) { i++; continue; }
+        else if((cp & 0xE0) == 0xC0) { n = 2; cp &= 0x1F; }
+        else if((cp & 0xF0) == 0xE0) { n = 3; cp &= 0x0F; }
+        else if((cp & 0xF8) == 0xF0) { n = 4; cp &= 0x07; }
+        else { return i; }
+
+        if(i + n > len) { return i; }
+        for(size_t j = 1; j < n; j++) {
+            if((str[i + j] & 0xC0) != 0x80) { return i; }
+            cp = cp << 6 | (str[i + j] & 0x3F);
+        }
+        if(cp < min[n] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) { return i; }
+        i += n;
+    }
+
+    return len;
+}
+
+static size_t ref_utf8_put(uint8_t* buf, uint32_t cp) {
+    if(cp < 0x80) { buf[0] = cp; return 1; }
+    if(cp < 0x800) { buf[0] = 0xC0 | cp >> 6; buf[1] = 0x80 | (cp & 0x3F); return 2; }
+    if(cp < 0x10000) { buf[0] = 0xE0 | cp >> 12; buf[1] = 0x80 | (cp >> 6 & 0x3F); buf[2] = 0x80 | (cp & 0x3F); return 3; }
+    buf[0] = 0xF0 | cp >> 18; buf[1] = 0x80 | (cp >> 12 & 0x3F); buf[2] = 0x80 | (cp >> 6 & 0x3F); buf[3] = 0x80 | (cp & 0x3F);
+    return 4;
+}
+
+static void check_simd_utf8() {
+    size_t index;
+    uint8_t buf[300];
+    srand(7);
+
+    for(int round = 0; round < 5000; round++) {
+        size_t len = 0, cps = 0, target = rand() % 260;
+        int mode = rand() % 3;
+
+        while(len < target) {
+            uint32_t cp = rand() % 4 == 0 ? (uint32_t) rand() % 0x110000 : (uint32_t) rand() % (rand() % 2 ? 0x80 : 0x800);
+            if(cp >= 0xD800 && cp <= 0xDFFF) { cp = 'x'; }
+            len += ref_utf8_put(buf + len, cp);
+            cps++;
+        }
+
+        estr_view_t view = { .ptr = (const char*) buf, .len = len };
+        assert(estr_utf8_count(view) == cps);
+
+        if(mode > 0 && len > 0) { // corrupt (or truncate) somewhere
+            size_t at = rand() % len;
+            if(mode == 1) { buf[at] = rand() % 256; }
+            else { view.len = at; }
+        }
+
+        size_t ref = ref_utf8_invalid(buf, view.len);
+        assert(estr_utf8_validate(view, &index) == (ref < view.len ? CU_ERR_ESTR_INVALID_UTF8 : CU_OK));
+        assert(index == ref);
+    }
+}
+
+static void test_utf8() {
+    size_t index;
+
+    assert(estr_utf8_validate((estr_view_t) { 0 }, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_utf8_count((estr_view_t) { 0 }) == 0);
+    assert(estr_utf8_validate(estr_view(""), &index) == CU_OK && index == 0);
+    assert(estr_utf8_validate(estr_view("plain ascii"), &index) == CU_OK && index == 11);
+    assert(estr_utf8_validate(estr_view("\xC5\xBE" "aba \xE2\x82\xAC \xF0\x9F\x98\x80"), NULL) == CU_OK);
+    assert(estr_utf8_count(estr_view("\xC5\xBE" "aba \xE2\x82\xAC \xF0\x9F\x98\x80")) == 8);
+    assert(estr_utf8_validate(estr_view("ok \xC0\xAF"), &index) == CU_ERR_ESTR_INVALID_UTF8 && index == 3);
+    assert(estr_utf8_validate(estr_view("\xED\xA0\x80"), &index) == CU_ERR_ESTR_INVALID_UTF8 && index == 0);
+    assert(estr_utf8_validate(estr_view("\xF4\x90\x80\x80"), NULL) == CU_ERR_ESTR_INVALID_UTF8);
+    assert(estr_utf8_validate(estr_view("\xF4\x8F\xBF\xBF"), NULL) == CU_OK);
+    assert(estr_utf8_validate(estr_view("ab\xE2\x82"), &index) == CU_ERR_ESTR_INVALID_UTF8 && index == 2);
+
+    for_each_simd(&check_simd_utf8);
+}
+
+static void test_estr_to_num() {
+    uint64_t u;
+    int64_t i;
+    double d;
+
+    assert(estr_to_u64(estr_view("0"), &u) == CU_OK && u == 0);
+    assert(estr_to_u64(estr_view("12345678"), &u) == CU_OK && u == 12345678);
+    assert(estr_to_u64(estr_view("1234567890123"), &u) == CU_OK && u == 1234567890123ULL);
+    assert(estr_to_u64(estr_view("18446744073709551615"), &u) == CU_OK && u == UINT64_MAX);
+    assert(estr_to_u64(estr_view("000000000000000000000000018446744073709551615"), &u) == CU_OK && u == UINT64_MAX);
+    assert(estr_to_u64(estr_view("18446744073709551616"), &u) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_to_u64(estr_view("99999999999999999999999"), &u) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_to_u64(estr_view(""), &u) == CU_ERR_EMPTY_STRING);
+    assert(estr_to_u64(estr_view("1234567/"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_u64(estr_view("12345678:"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_u64(estr_view("+1"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_u64(estr_view(" 1"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_u64(estrn_view("1234", 2), &u) == CU_OK && u == 12);
+    assert(estr_to_u64(estr_view("1"), NULL) == CU_ERR_INVALID_ARG);
+
+    assert(estr_to_i64(estr_view("-42"), &i) == CU_OK && i == -42);
+    assert(estr_to_i64(estr_view("+42"), &i) == CU_OK && i == 42);
+    assert(estr_to_i64(estr_view("9223372036854775807"), &i) == CU_OK && i == INT64_MAX);
+    assert(estr_to_i64(estr_view("-9223372036854775808"), &i) == CU_OK && i == INT64_MIN);
+    assert(estr_to_i64(estr_view("9223372036854775808"), &i) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_to_i64(estr_view("-9223372036854775809"), &i) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_to_i64(estr_view("-"), &i) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_i64(estr_view("--1"), &i) == CU_ERR_INVALID_CHAR);
+
+    assert(estr_hex_to_u64(estr_view("0xFf"), &u) == CU_OK && u == 255);
+    assert(estr_hex_to_u64(estr_view("deadBEEF"), &u) == CU_OK && u == 0xdeadbeef);
+    assert(estr_hex_to_u64(estr_view("ffffffffffffffff"), &u) == CU_OK && u == UINT64_MAX);
+    assert(estr_hex_to_u64(estr_view("0x0000ffffffffffffffff"), &u) == CU_OK && u == UINT64_MAX);
+    assert(estr_hex_to_u64(estr_view("10000000000000000"), &u) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_hex_to_u64(estr_view("0x"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_hex_to_u64(estr_view("0xg"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_bin_to_u64(estr_view("0b1011"), &u) == CU_OK && u == 11);
+    assert(estr_bin_to_u64(estr_view("1011"), &u) == CU_OK && u == 11);
+    assert(estr_bin_to_u64(estr_view("12"), &u) == CU_ERR_INVALID_CHAR);
+    assert(estr_bin_to_u64(estr_view("1" "0000000000000000000000000000000000000000000000000000000000000000"), &u) == CU_ERR_OUT_OF_BOUNDS);
+
+    assert(estr_to_f64(estr_view("0"), &d) == CU_OK && d == 0);
+    assert(estr_to_f64(estr_view("-1.5"), &d) == CU_OK && d == -1.5);
+    assert(estr_to_f64(estr_view(".25"), &d) == CU_OK && d == 0.25);
+    assert(estr_to_f64(estr_view("3."), &d) == CU_OK && d == 3);
+    assert(estr_to_f64(estr_view("1e3"), &d) == CU_OK && d == 1000);
+    assert(estr_to_f64(estr_view("1.5E-2"), &d) == CU_OK && d == 0.015);
+    assert(estr_to_f64(estr_view("0.1"), &d) == CU_OK && d == 0.1);
+    assert(estr_to_f64(estr_view("1.7976931348623157e308"), &d) == CU_OK && d == 1.7976931348623157e308);
+    assert(estr_to_f64(estr_view("4.9e-324"), &d) == CU_OK && d == 4.9e-324);
+    assert(estr_to_f64(estr_view("1e-99999999999"), &d) == CU_OK && d == 0);
+    assert(estr_to_f64(estr_view("123456789012345678901234567890"), &d) == CU_OK && d == 123456789012345678901234567890.0);
+    assert(estr_to_f64(estr_view("1e309"), &d) == CU_ERR_OUT_OF_BOUNDS);
+    assert(estr_to_f64(estr_view(""), &d) == CU_ERR_EMPTY_STRING);
+    assert(estr_to_f64(estr_view("."), &d) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_f64(estr_view("1e"), &d) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_f64(estr_view("1,5"), &d) == CU_ERR_INVALID_CHAR);
+    assert(estr_to_f64(estr_view("nan"), &d) == CU_ERR_INVALID_CHAR);
+
+    // halfway between 1 and next double, decided only by the digit far beyond the limit
+    char buf[1024] = "1.00000000000000011102230246251565404236316680908203125";
+    assert(estr_to_f64(estr_view(buf), &d) == CU_OK && d == 1.0);
+    size_t len = strlen(buf);
+    memset(buf + len, '0', 900);
+    strcpy(buf + len + 900, "1");
+    assert(estr_to_f64(estr_view(buf), &d) == CU_OK && d == 1.0000000000000002);
+
+    // random round trip
+    srand(7);
+    for(int j = 0; j < 10000; j++) {
+        uint64_t num = ((uint64_t) rand() << 40) ^ ((uint64_t) rand() << 20) ^ (uint64_t) rand();
+        char tmp[64];
+        sprintf(tmp, "%" PRIu64, num);
+        assert(estr_to_u64(estr_view(tmp), &u) == CU_OK && u == num);
+        sprintf(tmp, "-%" PRIu64, num >> 1);
+        assert(estr_to_i64(estr_view(tmp), &i) == CU_OK && i == -(int64_t) (num >> 1));
+        sprintf(tmp, "%" PRIx64, num);
+        assert(estr_hex_to_u64(estr_view(tmp), &u) == CU_OK && u == num);
+        double dbl = (double) num / (rand() + 1) * (j % 2 ? 1e-100 : 1e100);
+        sprintf(tmp, "%.17g", dbl);
+        assert(estr_to_f64(estr_view(tmp), &d) == CU_OK && d == dbl);
+    }
+}
+
+static void test_estr_fmt() {
+    char buf[ESTR_FMT_F64_SIZE];
+
+    assert(estr_fmt_u64(0, buf, sizeof(buf)) == 1 && estr_eq(buf, "0"));
+    assert(estr_fmt_u64(1234567, buf, sizeof(buf)) == 7 && estr_eq(buf, "1234567"));
+    assert(estr_fmt_u64(UINT64_MAX, buf, ESTR_FMT_U64_SIZE) == 20 && estr_eq(buf, "18446744073709551615"));
+    assert(estr_fmt_u64(100, buf, 3) == 0);
+    assert(estr_fmt_u64(100, NULL, 10) == 0);
+    assert(estr_fmt_i64(-7, buf, sizeof(buf)) == 2 && estr_eq(buf, "-7"));
+    assert(estr_fmt_i64(INT64_MIN, buf, ESTR_FMT_I64_SIZE) == 20 && estr_eq(buf, "-9223372036854775808"));
+    assert(estr_fmt_hex(0, buf, sizeof(buf)) == 1 && estr_eq(buf, "0"));
+    assert(estr_fmt_hex(0xdeadBEEF, buf, sizeof(buf)) == 8 && estr_eq(buf, "deadbeef"));
+    assert(estr_fmt_hex(UINT64_MAX, buf, ESTR_FMT_HEX_SIZE) == 16 && estr_eq(buf, "ffffffffffffffff"));
+
+    assert(estr_fmt_f64(0, buf, sizeof(buf)) == 1 && estr_eq(buf, "0"));
+    assert(estr_fmt_f64(-0.0, buf, sizeof(buf)) == 2 && estr_eq(buf, "-0"));
+    assert(estr_fmt_f64(1.5, buf, sizeof(buf)) && estr_eq(buf, "1.5"));
+    assert(estr_fmt_f64(-123.25, buf, sizeof(buf)) && estr_eq(buf, "-123.25"));
+    assert(estr_fmt_f64(0.1, buf, sizeof(buf)) && estr_eq(buf, "0.1"));
+    assert(estr_fmt_f64(0.000001, buf, sizeof(buf)) && estr_eq(buf, "0.000001"));
+    assert(estr_fmt_f64(1e-7, buf, sizeof(buf)) && estr_eq(buf, "1e-7"));
+    assert(estr_fmt_f64(1e20, buf, sizeof(buf)) && estr_eq(buf, "100000000000000000000"));
+    assert(estr_fmt_f64(1e21, buf, sizeof(buf)) && estr_eq(buf, "1e+21"));
+    assert(estr_fmt_f64(1.7976931348623157e308, buf, sizeof(buf)) && estr_eq(buf, "1.7976931348623157e+308"));
+    assert(estr_fmt_f64(-2.2250738585072014e-308, buf, sizeof(buf)) && estr_eq(buf, "-2.2250738585072014e-308"));
+    assert(estr_fmt_f64(5e-324, buf, sizeof(buf)) && estr_eq(buf, "5e-324"));
+    assert(estr_fmt_f64(__builtin_inf(), buf, sizeof(buf)) && estr_eq(buf, "inf"));
+    assert(estr_fmt_f64(-__builtin_inf(), buf, sizeof(buf)) && estr_eq(buf, "-inf"));
+    assert(estr_fmt_f64(__builtin_nan(""), buf, sizeof(buf)) && estr_eq(buf, "nan"));
+    assert(estr_fmt_f64(1.5, buf, 3) == 0);
+
+    // values on which Grisu2 is one digit longer
+    assert(estr_fmt_f64(3.5121198866935746e-52, buf, sizeof(buf)) && estr_eq(buf, "3.512119886693575e-52"));
+    assert(estr_fmt_f64(-4.9031007816504164e-167, buf, sizeof(buf)) && estr_eq(buf, "-4.903100781650416e-167"));
+    assert(estr_fmt_f64(-6.9379263508884765e-103, buf, sizeof(buf)) && estr_eq(buf, "-6.937926350888477e-103"));
+    assert(estr_fmt_f64(9007199254740993.0, buf, sizeof(buf)) && estr_eq(buf, "9007199254740992"));
+    assert(estr_fmt_f64(2.2250738585072014e-308 * 2, buf, sizeof(buf)) && estr_eq(buf, "4.450147717014403e-308"));
+
+    // no precision of the standard library is shorter, equally short digits are the same
+    srand(7);
+    for(int i = 0; i < 20000; i++) {
+        uint64_t bits = ((uint64_t) rand() << 42) ^ ((uint64_t) rand() << 21) ^ (uint64_t) rand();
+        double num;
+        memcpy(&num, &bits, sizeof(num));
+
+        if(num != num || num == __builtin_inf() || num == -__builtin_inf() || num == 0) {
+            continue;
+        }
+
+        char exp[32];
+        int precision = 1;
+
+        for(; precision < 17; precision++) {
+            snprintf(exp, sizeof(exp), "%.*e", precision - 1, num);
+            if(strtod(exp, NULL) == num) { break; }
+        }
+
+        snprintf(exp, sizeof(exp), "%.*e", precision - 1, num);
+        estr_fmt_f64(num, buf, sizeof(buf));
+
+        char digits[32];
+        size_t len = 0;
+        for(const char* c = buf; *c && *c != 'e'; c++) {
+            if(*c >= '0' && *c <= '9') { digits[len++] = *c; }
+        }
+
+        digits[len] = '\0';
+        char* start = digits;
+        while(len > 1 && *start == '0') { start++; len--; }
+        while(len > 1 && start[len - 1] == '0') { start[--len] = '\0'; }
+
+        char* mantissa = exp + (num < 0);
+        size_t mlen = 0;
+        char expected[32];
+        for(const char* c = mantissa; *c != 'e'; c++) {
+            if(*c >= '0' && *c <= '9') { expected[mlen++] = *c; }
+        }
+
+        expected[mlen] = '\0';
+        while(mlen > 1 && expected[mlen - 1] == '0') { expected[--mlen] = '\0'; }
+
+        assert(len <= mlen);
+        assert(len < mlen || estr_eq(start, expected));
+    }
+
+    // round trip through the parser
+    srand(11);
+    for(int i = 0; i < 100000; i++) {
+        uint64_t bits = ((uint64_t) rand() << 42) ^ ((uint64_t) rand() << 21) ^ (uint64_t) rand();
+        double num;
+        memcpy(&num, &bits, sizeof(num));
+
+        if(num != num || num == __builtin_inf() || num == -__builtin_inf()) {
+            continue;
+        }
+
+        double parsed;
+        size_t len = estr_fmt_f64(num, buf, sizeof(buf));
+        assert(len && len == strlen(buf));
+        assert(estr_to_f64(estrn_view(buf, len), &parsed) == CU_OK && parsed == num);
+    }
+
+    estr_builder_t b;
+    assert(estr_b_init(&b, NULL, 0, NULL) == CU_OK);
+    assert(estr_b_i64(&b, -12) == CU_OK);
+    assert(estr_b_chr(&b, ' ') == CU_OK);
+    assert(estr_b_hex(&b, 255) == CU_OK);
+    assert(estr_b_chr(&b, ' ') == CU_OK);
+    assert(estr_b_f64(&b, 0.5) == CU_OK);
+    char* str = estr_b_finish(&b);
+    assert(estr_eq(str, "-12 ff 0.5"));
+    free(str);
+}
+
+static void test_estr_hash() {
+    assert(estr_hash64(NULL, 0, 0) == 0xEF46DB3751D8E999ULL);
+    assert(estr_hash64("abc", 3, 0) == 0x44BC2CF5AD770999ULL);
+    assert(estr_hash64("abc", 3, 1) != estr_hash64("abc", 3, 0));
+
+    uint8_t data[1000];
+    for(size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 7 + 3);
+    }
+
+    assert(estr_hash64(data, 3, 0x1234) == 0x6EFF9567ADEA527EULL);
+    assert(estr_hash64(data, 31, 0x1234) == 0x8BE368B26863E7FCULL);
+    assert(estr_hash64(data, 32, 0x1234) == 0xDA916A2278BF4CD2ULL);
+    assert(estr_hash64(data, 100, 0x1234) == 0x9C7C53D78F060EFDULL);
+    assert(estr_hash64(data, 1000, 0x1234) == 0x606A85EAE0CDBB41ULL);
+
+    estr_hasher_t hasher;
+    assert(estr_hasher_init(NULL, 0) == CU_ERR_INVALID_ARG);
+    assert(estr_hasher_init(&hasher, 0x1234) == CU_OK);
+    assert(estr_hasher_digest(&hasher) == estr_hash64(NULL, 0, 0x1234));
+    assert(estr_hasher_update(&hasher, NULL, 1) == CU_ERR_INVALID_ARG);
+
+    // any split of the input gives the same hash
+    srand(5);
+    for(int i = 0; i < 1000; i++) {
+        size_t len = rand() % sizeof(data);
+        assert(estr_hasher_init(&hasher, 0x1234) == CU_OK);
+
+        for(size_t pos = 0; pos < len;) {
+            size_t chunk = rand() % 70;
+            chunk = chunk < len - pos ? chunk : len - pos;
+            assert(estr_hasher_update(&hasher, data + pos, chunk) == CU_OK);
+            pos += chunk;
+        }
+
+        assert(estr_hasher_digest(&hasher) == estr_hash64(data, len, 0x1234));
+    }
+}
+
+static void test_estr_intern() {
+    estr_intern_t table = NULL;
+    const char* a = NULL;
+    const char* b = NULL;
+    char tmp[16];
+
+    assert(estr_intern_create(NULL, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_intern_create(&(estr_intern_config_t) { .capacity = 2 }, &table) == CU_OK && table);
+    assert(estr_intern(table, NULL, &a) == CU_ERR_INVALID_ARG);
+    assert(estr_intern(table, "help", &a) == CU_OK && estr_eq(a, "help"));
+    strcpy(tmp, "help");
+    assert(estr_intern(table, tmp, &b) == CU_OK && a == b); // same canonical copy
+    assert(estr_v_intern(table, estrn_view("helper", 4), &b) == CU_OK && a == b);
+    assert(estr_intern(table, "", &b) == CU_OK && estr_eq(b, "") && a != b);
+    assert(estr_v_intern(table, (estr_view_t) { .ptr = "a\0b", .len = 3 }, &b) == CU_OK && memcmp(b, "a\0b", 4) == 0);
+    assert(estr_intern_find(table, estr_view("help")) == a);
+    assert(estr_intern_find(table, estr_view("nope")) == NULL);
+
+    // grow well beyond the initial capacity
+    const char* interned[500];
+    for(int i = 0; i < 500; i++) {
+        estr_fmt_u64(i, tmp, sizeof(tmp));
+        assert(estr_intern(table, tmp, &interned[i]) == CU_OK && estr_eq(interned[i], tmp));
+    }
+
+    for(int i = 0; i < 500; i++) {
+        estr_fmt_u64(i, tmp, sizeof(tmp));
+        assert(estr_intern_find(table, estr_view(tmp)) == interned[i]);
+    }
+
+    estr_intern_stats_t stats;
+    assert(estr_intern_stats(table, &stats) == CU_OK);
+    assert(stats.count == 503 && stats.slots >= 2 * stats.count);
+    assert(stats.string_bytes == 5 + 1 + 4 + (10 * 2 + 90 * 3 + 400 * 4));
+    assert(stats.total_bytes > stats.string_bytes);
+    assert(estr_intern_destroy(table) == CU_OK);
+
+    // strings in the arena
+    assert(estr_intern_create(&(estr_intern_config_t) { .arena = true, .arena_block_size = 64 }, &table) == CU_OK);
+    assert(estr_intern(table, "echo", &a) == CU_OK && estr_intern(table, "echo", &b) == CU_OK && a == b);
+    assert(estr_intern(table, "message", &b) == CU_OK && a != b);
+    assert(estr_intern_stats(table, &stats) == CU_OK && stats.count == 2 && stats.string_bytes == 13);
+    assert(estr_intern_destroy(table) == CU_OK);
+    assert(estr_intern_destroy(NULL) == CU_ERR_INVALID_ARG);
+}
+
+static void test_estr_owned() {
+    estr_t s = { 0 };
+    assert(estr_s_is_inline(&s) && estr_s_len(&s) == 0 && estr_eq(estr_s_str(&s), ""));
+    assert(sizeof(estr_t) == 3 * sizeof(char*));
+
+    assert(estr_s_init(&s, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_s_init(&s, "help") == CU_OK);
+    assert(estr_s_is_inline(&s) && estr_s_len(&s) == 4 && estr_eq(estr_s_str(&s), "help"));
+    assert(estr_v_eq(estr_s_view(&s), estr_view("help")));
+    estr_s_free(&s);
+    assert(estr_s_len(&s) == 0);
+
+    char buf[64];
+    memset(buf, 'x', sizeof(buf));
+    assert(estr_s_init_view(&s, estrn_view(buf, ESTR_SSO_CAPACITY)) == CU_OK);
+    assert(estr_s_is_inline(&s) && estr_s_len(&s) == ESTR_SSO_CAPACITY && strlen(estr_s_str(&s)) == ESTR_SSO_CAPACITY);
+
+    estr_t t;
+    assert(estr_s_init_view(&t, estrn_view(buf, ESTR_SSO_CAPACITY + 1)) == CU_OK);
+    assert(!estr_s_is_inline(&t) && estr_s_len(&t) == ESTR_SSO_CAPACITY + 1);
+    assert(strlen(estr_s_str(&t)) == ESTR_SSO_CAPACITY + 1);
+    assert(!estr_s_eq(&s, &t));
+    estr_s_free(&t);
+    assert(estr_s_is_inline(&t));
+    assert(estr_s_init_view(&t, estrn_view(buf, ESTR_SSO_CAPACITY)) == CU_OK && estr_s_eq(&s, &t));
+    estr_s_free(&t);
+    estr_s_free(&s);
+
+    size_t len = 0;
+    estr_t* list = estr_split_s("a,,long piece which does not fit inline,b", ',', &len);
+    assert(list && len == 3); // same rules as estr_split, empty pieces are skipped
+    assert(estr_eq(estr_s_str(&list[0]), "a") && estr_s_is_inline(&list[0]));
+    assert(estr_eq(estr_s_str(&list[1]), "long piece which does not fit inline") && !estr_s_is_inline(&list[1]));
+    assert(estr_eq(estr_s_str(&list[2]), "b"));
+    estr_s_list_free(list, len);
+    assert(!estr_split_s(NULL, ',', &len));
+}
+
+static void test_estr_lit() {
+    static const char* strs[] = { "", "G", "GE", "GET", "GET ", "GET /", "GET /index", "GET /index.html", "GET /index.htm", "GET /index.html?", "xGET " };
+
+    assert(!estr_sw_lit(NULL, "GET "));
+    assert(!estr_eq_lit(NULL, ""));
+    assert(!estr_ew_lit(NULL, ".cfg"));
+    assert(!estr_v_sw_lit((estr_view_t) { 0 }, "a"));
+    assert(estr_eq_lit("", ""));
+    assert(!estr_sw_lit("abc", ""));
+    assert(!estr_ew_lit("abc", ""));
+    assert(estr_ew_lit("app.cfg", ".cfg") && !estr_ew_lit("cfg", ".cfg"));
+    assert(estr_eq_lit("a\0b", "a")); // compared as C string
+
+    // literal variants agree with the runtime ones for every length of fixed-width compare
+    for(size_t i = 0; i < sizeof(strs) / sizeof(strs[0]); i++) {
+        const char* str = strs[i];
+        estr_view_t view = estr_view(str);
+
+        assert(estr_sw_lit(str, "G") == estr_sw(str, "G"));
+        assert(estr_sw_lit(str, "GET ") == estr_sw(str, "GET "));
+        assert(estr_sw_lit(str, "GET /index.html") == estr_sw(str, "GET /index.html"));
+        assert(estr_ew_lit(str, "T") == estr_ew(str, "T"));
+        assert(estr_ew_lit(str, ".htm") == estr_ew(str, ".htm"));
+        assert(estr_ew_lit(str, "index.html") == estr_ew(str, "index.html"));
+        assert(estr_eq_lit(str, "GE") == estr_eq(str, "GE"));
+        assert(estr_eq_lit(str, "GET /") == estr_eq(str, "GET /"));
+        assert(estr_eq_lit(str, "GET /index.html?") == estr_eq(str, "GET /index.html?"));
+
+        assert(estr_v_sw_lit(view, "GE") == estr_v_sw(view, estr_view("GE")));
+        assert(estr_v_sw_lit(view, "GET /index") == estr_v_sw(view, estr_view("GET /index")));
+        assert(estr_v_sw_lit(view, "GET /index.html?") == estr_v_sw(view, estr_view("GET /index.html?")));
+        assert(estr_v_ew_lit(view, "ET") == estr_v_ew(view, estr_view("ET")));
+        assert(estr_v_ew_lit(view, "/index.html") == estr_v_ew(view, estr_view("/index.html")));
+        assert(estr_v_eq_lit(view, "") == estr_v_eq(view, estr_view("")));
+        assert(estr_v_eq_lit(view, "GET") == estr_v_eq(view, estr_view("GET")));
+        assert(estr_v_eq_lit(view, "GET /index.htm") == estr_v_eq(view, estr_view("GET /index.htm")));
+        assert(estr_v_eq_lit(view, "GET /index.html?") == estr_v_eq(view, estr_view("GET /index.html?")));
+    }
+
+    const char* line = "GET /index.html?x=1 HTTP/1.1";
+    assert(estr_v_sw_lit(estr_view(line), "GET /index.html?x=1 HTTP/"));
+    assert(!estr_v_sw_lit(estr_view(line), "GET /index.html?x=1 HTTP/2"));
+}
+
+static bool ref_ieq(const char* a, const char* b, size_t len) {
+    for(size_t i = 0; i < len; i++) {
+        if(tolower((unsigned char) a[i]) != tolower((unsigned char) b[i])) { return false; }
+    }
+    return true;
+}
+
+static void check_simd_icase() {
+    static const char alphabet[] = "aAzZ@[`{09 \x80\xC1\xE1";
+    char a[100], b[100];
+    srand(11);
+
+    for(int round = 0; round < 3000; round++) {
+        size_t len = rand() % sizeof(a);
+
+        for(size_t i = 0; i < len; i++) {
+            a[i] = alphabet[rand() % (sizeof(alphabet) - 1)];
+            b[i] = rand() % 4 ? (char) (a[i] ^ (rand() % 2 ? 0x20 : 0)) : alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+
+        estr_view_t va = { .ptr = a, .len = len };
+        estr_view_t vb = { .ptr = b, .len = len };
+        assert(estr_v_ieq(va, vb) == ref_ieq(a, b, len));
+
+        if(len > 0) {
+            size_t n = 1 + rand() % (len < 5 ? len : 5);
+            const char* found = estr_v_ifind(va, (estr_view_t) { .ptr = b + len - n, .len = n });
+            const char* ref = NULL;
+            for(size_t i = 0; i + n <= len && !ref; i++) {
+                if(ref_ieq(a + i, b + len - n, n)) { ref = a + i; }
+            }
+            assert(found == ref);
+        }
+    }
+}
+
+static void test_estr_icase() {
+
+    assert(estr_ieq("Help", "hELP"));
+    assert(!estr_ieq("help", "helps"));
+    assert(!estr_ieq(NULL, "help"));
+    assert(estr_ieq("", ""));
+    assert(!estr_ieq("@", "`") && !estr_ieq("[", "{")); // differ only in the case bit, but aren't letters
+    assert(estrn_ieq("HELPme", "helpYOU", 4) && !estrn_ieq("HELPme", "helpYOU", 5));
+    assert(estrn_ieq("ab", "AB", 10));
+    assert(estr_isw("GET /index", "get ") && !estr_isw("GE", "get") && !estr_isw("abc", ""));
+    assert(estr_iew("config.CFG", ".cfg") && !estr_iew("cfg", ".cfg"));
+    assert(estr_v_ieq(estr_view_lit("MiXeD"), estr_view_lit("mixed")));
+    assert(estr_v_isw(estr_view_lit("Content-Length: 3"), estr_view_lit("content-length:")));
+    assert(estr_v_iew(estr_view_lit("archive.TAR.GZ"), estr_view_lit(".tar.gz")));
+
+    const char* text = "The Quick Brown Fox Jumps Over The Lazy Dog";
+    assert(estr_ifind(text, "quick") == text + 4);
+    assert(estr_ifind(text, "THE") == text);
+    assert(estr_ifind(text, "lazy dog") == text + 35);
+    assert(estr_ifind(text, "DOG!") == NULL);
+    assert(estr_ifind(text, "") == NULL);
+    assert(estr_ifind("ab", "abc") == NULL);
+    assert(estr_ifind("x@y", "`") == NULL);
+    assert(estr_v_ifind(estr_view_lit("1234567890abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ!"), estr_view_lit("zabcdefghijklmnopqrstuvwxyz!")) != NULL);
+
+    for_each_simd(&check_simd_icase);
+}
+
+static void test_estr_lines() {
+    const char* path = "estr_lines.test.tmp";
+    const char* content = "help\r\n\nreboot now\n\r\nlast";
+    estr_lines_t lines;
+    estr_view_t line;
+
+    FILE* file = fopen(path, "wb");
+    assert(file && fwrite(content, 1, strlen(content), file) == strlen(content));
+    fclose(file);
+
+    assert(estr_lines_open(NULL, &lines) == CU_ERR_INVALID_ARG);
+    assert(estr_lines_open("estr_lines.test.missing", &lines) == CU_ERR_NOT_FOUND);
+    assert(estr_lines_open(path, &lines) == CU_OK);
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, "help"));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, ""));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, "reboot now"));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, ""));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, "last")); // no final newline
+    assert(!estr_lines_next(&lines, &line));
+    assert(estr_lines_close(&lines) == CU_OK);
+    assert(estr_lines_close(&lines) == CU_OK);
+
+    file = fopen(path, "wb"); // empty file
+    fclose(file);
+    assert(estr_lines_open(path, &lines) == CU_OK);
+    assert(!estr_lines_next(&lines, &line));
+    assert(estr_lines_close(&lines) == CU_OK);
+    remove(path);
+
+    lines = estr_v_lines(estr_view_lit("a\nb\n"));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, "a"));
+    assert(estr_lines_next(&lines, &line) && estr_v_eq_lit(line, "b"));
+    assert(!estr_lines_next(&lines, &line));
+
+    lines = estr_v_lines((estr_view_t) { 0 });
+    assert(!estr_lines_next(&lines, &line));
+    lines = estr_v_lines(estr_view_lit("\r"));
+    assert(estr_lines_next(&lines, &line) && line.len == 0);
+    assert(!estr_lines_next(&lines, &line));
+}
+
+/**
+ * @brief Every implementation gives the same result as the portable one
+ */
+static void check_simd_codec() {
+    estr_simd_t simd = estr_simd_get();
+    uint8_t data[300];
+    size_t len = 0;
+    srand(23);
+
+    for(size_t round = 0; round < 400; round++) {
+        size_t n = (size_t) rand() % (sizeof(data) + 1);
+        estr_base64_t alphabet = round % 2 ? ESTR_BASE64_URL : ESTR_BASE64_STD;
+
+        for(size_t i = 0; i < n; i++) {
+            data[i] = (uint8_t) rand();
+        }
+
+        assert(estr_simd_set(ESTR_SIMD_NONE) == CU_OK);
+        char* ref_h = estr_hex_encode(data, n);
+        char* ref_b = estr_base64_encode(data, n, alphabet);
+        assert(estr_simd_set(simd) == CU_OK);
+        char* h = estr_hex_encode(data, n);
+        char* b = estr_base64_encode(data, n, alphabet);
+        assert(h && b && estr_eq(h, ref_h) && estr_eq(b, ref_b));
+        free(ref_h);
+        free(ref_b);
+
+        uint8_t* dh = estr_v_hex_decode(estr_view(h), ESTR_DECODE_STRICT, &len);
+        assert(dh && len == n && memcmp(dh, data, n) == 0);
+        free(dh);
+        uint8_t* db = estr_v_base64_decode(estr_view(b), alphabet, ESTR_DECODE_STRICT, &len);
+        assert(db && len == n && memcmp(db, data, n) == 0);
+        free(db);
+
+        if(n > 0) { // invalid character anywhere is found
+            size_t pos = (size_t) rand() % strlen(b);
+            char orig = b[pos];
+            b[pos] = '*';
+            assert(!estr_v_base64_decode(estr_view(b), alphabet, ESTR_DECODE_LENIENT, NULL));
+            b[pos] = orig;
+            h[pos % strlen(h)] = 'g';
+            assert(!estr_v_hex_decode(estr_view(h), ESTR_DECODE_LENIENT, NULL));
+        }
+
+        free(h);
+        free(b);
+    }
+}
+
+static void test_estr_codec() {
+    const char* plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+    const char* std[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" }; // RFC 4648
+    const char* url[] = { "", "Zg", "Zm8", "Zm9v", "Zm9vYg", "Zm9vYmE", "Zm9vYmFy" };
+    char buf[64];
+    uint8_t bytes[64];
+    size_t len = 0;
+
+    for(size_t i = 0; i < sizeof(plain) / sizeof(plain[0]); i++) {
+        char* enc = estr_base64_encode(plain[i], strlen(plain[i]), ESTR_BASE64_STD);
+        assert(estr_eq(enc, std[i]) && strlen(enc) == estr_base64_encoded_len(strlen(plain[i]), ESTR_BASE64_STD));
+        free(enc);
+        enc = estr_base64_encode(plain[i], strlen(plain[i]), ESTR_BASE64_URL);
+        assert(estr_eq(enc, url[i]) && strlen(enc) == estr_base64_encoded_len(strlen(plain[i]), ESTR_BASE64_URL));
+        free(enc);
+
+        uint8_t* dec = estr_v_base64_decode(estr_view(std[i]), ESTR_BASE64_STD, ESTR_DECODE_STRICT, &len);
+        assert(dec && len == strlen(plain[i]) && estr_eq((char*) dec, plain[i]));
+        assert(len == estr_base64_decoded_len(estr_view(std[i])));
+        free(dec);
+        dec = estr_v_base64_decode(estr_view(url[i]), ESTR_BASE64_URL, ESTR_DECODE_STRICT, &len);
+        assert(dec && len == strlen(plain[i]) && estr_eq((char*) dec, plain[i]));
+        free(dec);
+    }
+
+    assert(estr_base64_encode_to("\xfb\xff", 2, ESTR_BASE64_STD, buf, sizeof(buf), &len) == CU_OK);
+    assert(estr_eq(buf, "+/8=") && len == 4);
+    assert(estr_base64_encode_to("\xfb\xff", 2, ESTR_BASE64_URL, buf, sizeof(buf), &len) == CU_OK);
+    assert(estr_eq(buf, "-_8") && len == 3);
+    assert(estr_base64_encode_to("foo", 3, ESTR_BASE64_STD, buf, 4, &len) == CU_ERR_OUT_OF_BOUNDS && len == 4);
+    assert(estr_base64_encode_to(NULL, 1, ESTR_BASE64_STD, buf, sizeof(buf), NULL) == CU_ERR_INVALID_ARG);
+
+    // strict decoding accepts only canonical encoding
+    const char* invalid[] = { "Zg=", "Zg", "Zg===", "Zh==", "Zm9=", "Z===", "Zm9v\n", "Zm 9v", "-_8=", "Zm9v=", "=", "Zg==Zg==" };
+
+    for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        assert(estr_v_base64_decode_to(estr_view(invalid[i]), ESTR_BASE64_STD, ESTR_DECODE_STRICT, bytes, sizeof(bytes), NULL)
+            == CU_ERR_SYNTAX_ERROR);
+    }
+
+    assert(estr_v_base64_decode_to(estr_view_lit("Zg=="), ESTR_BASE64_URL, ESTR_DECODE_STRICT, bytes, sizeof(bytes), NULL)
+        == CU_ERR_SYNTAX_ERROR); // url alphabet is unpadded
+
+    // lenient decoding skips whitespace, doesn't need padding and accepts both alphabets
+    assert(estr_v_base64_decode_to(estr_view_lit(" Zm9v\r\nYmE \n"), ESTR_BASE64_STD, ESTR_DECODE_LENIENT,
+        bytes, sizeof(bytes), &len) == CU_OK);
+    assert(len == 5 && memcmp(bytes, "fooba", 5) == 0);
+    assert(estr_v_base64_decode_to(estr_view_lit("-_8 ="), ESTR_BASE64_STD, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), &len) == CU_OK);
+    assert(len == 2 && memcmp(bytes, "\xfb\xff", 2) == 0);
+    assert(estr_v_base64_decode_to(estr_view_lit("+/9"), ESTR_BASE64_URL, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), &len) == CU_OK);
+    assert(len == 2 && memcmp(bytes, "\xfb\xff", 2) == 0);
+    assert(estr_v_base64_decode_to(estr_view_lit("Zg="), ESTR_BASE64_STD, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL) == CU_OK);
+    assert(estr_v_base64_decode_to(estr_view_lit("Zg==="), ESTR_BASE64_STD, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL)
+        == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_base64_decode_to(estr_view_lit("Z"), ESTR_BASE64_STD, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL)
+        == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_base64_decode_to(estr_view_lit("Zm9v*"), ESTR_BASE64_STD, ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL)
+        == CU_ERR_SYNTAX_ERROR);
+
+    assert(estr_v_base64_decode_to(estr_view_lit("Zm9vYmFy"), ESTR_BASE64_STD, ESTR_DECODE_STRICT, bytes, 5, &len)
+        == CU_ERR_OUT_OF_BOUNDS && len == 6);
+    assert(estr_v_base64_decode_to(estr_view_lit("Zm9vYmFy"), ESTR_BASE64_STD, ESTR_DECODE_STRICT, bytes, 6, &len) == CU_OK);
+    assert(estr_v_base64_decode_to(estr_view_lit("Zm9v"), ESTR_BASE64_STD, ESTR_DECODE_STRICT, NULL, 0, &len)
+        == CU_ERR_OUT_OF_BOUNDS && len == 3);
+    assert(estr_v_base64_decode_to((estr_view_t) { 0 }, ESTR_BASE64_STD, ESTR_DECODE_STRICT, bytes, sizeof(bytes), NULL)
+        == CU_ERR_INVALID_ARG);
+
+    // hex
+    char* hex = estr_hex_encode("\x01\xab\xff", 3);
+    assert(estr_eq(hex, "01abff"));
+    free(hex);
+    assert(estr_hex_encode_to("\x01", 1, buf, 2, &len) == CU_ERR_OUT_OF_BOUNDS && len == 2);
+    assert(estr_v_hex_decode_to(estr_view_lit("01ABff"), ESTR_DECODE_STRICT, bytes, sizeof(bytes), &len) == CU_OK);
+    assert(len == 3 && memcmp(bytes, "\x01\xab\xff", 3) == 0);
+    assert(estr_v_hex_decode_to(estr_view_lit("01 ab\nf f"), ESTR_DECODE_LENIENT, bytes, sizeof(bytes), &len) == CU_OK);
+    assert(len == 3 && memcmp(bytes, "\x01\xab\xff", 3) == 0);
+    assert(estr_v_hex_decode_to(estr_view_lit("01 ab"), ESTR_DECODE_STRICT, bytes, sizeof(bytes), NULL) == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_hex_decode_to(estr_view_lit("01a"), ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL) == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_hex_decode_to(estr_view_lit("0g"), ESTR_DECODE_LENIENT, bytes, sizeof(bytes), NULL) == CU_ERR_SYNTAX_ERROR);
+    assert(estr_v_hex_decode_to(estr_view_lit("0102"), ESTR_DECODE_STRICT, bytes, 1, &len) == CU_ERR_OUT_OF_BOUNDS && len == 2);
+    assert(!estr_v_hex_decode(estr_view_lit("xy"), ESTR_DECODE_LENIENT, NULL));
+
+    for_each_simd(&check_simd_codec);
+}
+
+/**
+ * @brief Backtracking reference for '*', '?' and literals
+ */
+static bool ref_glob(const char* pattern, const char* str) {
+    if(*pattern == '*') {
+        return ref_glob(pattern + 1, str) || (*str && ref_glob(pattern, str + 1));
+    }
+
+    if(!*pattern) {
+        return !*str;
+    }
+
+    return *str && (*pattern == '?' || *pattern == *str) && ref_glob(pattern + 1, str + 1);
+}
+
+static void test_estr_glob() {
+    struct { const char* pattern; const char* str; bool match; } cases[] = {
+        { "", "", true },
+        { "", "a", false },
+        { "*", "", true },
+        { "*", "anything", true },
+        { "net.*", "net.ping", true },
+        { "net.*", "net.", true },
+        { "net.*", "netping", false },
+        { "*.log", "boot.log", true },
+        { "*.log", "boot.log.1", false },
+        { "a*b*c", "abc", true },
+        { "a*b*c", "axxbyyc", true },
+        { "a*b*c", "axxcyyb", false },
+        { "a*aa*a", "aaa", false },
+        { "a*aa*a", "aaaa", true },
+        { "??", "ab", true },
+        { "??", "a", false },
+        { "*x?z*", "wxyzw", true },
+        { "*x?z*", "xyyz", false },
+        { "[a-c]at", "bat", true },
+        { "[a-c]at", "dat", false },
+        { "[!a-c]at", "dat", true },
+        { "[^a-c]at", "cat", false },
+        { "[]]", "]", true },
+        { "[a-]", "-", true },
+        { "*[0-9][0-9]", "port80", true },
+        { "*[0-9][0-9]", "port8", false },
+        { "\\*", "*", true },
+        { "\\*", "a", false },
+        { "[\\]]x", "]x", true },
+        { "led.*.on", "led.red.on", true },
+        { "led.*.on", "led.on", false },
+    };
+
+    for(size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        estr_glob_t glob = NULL;
+        assert(estr_glob_compile(cases[i].pattern, &glob) == CU_OK);
+        assert(estr_glob_match(glob, cases[i].str) == cases[i].match);
+        assert(estr_glob_destroy(glob) == CU_OK);
+    }
+
+    const char* invalid[] = { "[abc", "[]", "[z-a]", "abc\\", "[a\\" };
+    estr_glob_t glob = NULL;
+
+    for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        assert(estr_glob_compile(invalid[i], &glob) == CU_ERR_SYNTAX_ERROR);
+    }
+
+    assert(estr_glob_compile(NULL, &glob) == CU_ERR_INVALID_ARG);
+    assert(!estr_glob_match(NULL, "a"));
+
+    assert(estr_glob_compile("reboot*", &glob) == CU_OK);
+    assert(estr_v_glob_match(glob, estr_view_lit("reboot now")));
+    assert(!estr_v_glob_match(glob, (estr_view_t) { .ptr = "reboot", .len = 5 }));
+    assert(estr_glob_destroy(glob) == CU_OK);
+
+    // leftmost segment matching agrees with backtracking
+    char pattern[9], str[13];
+    srand(5);
+
+    for(size_t round = 0; round < 3000; round++) {
+        size_t plen = (size_t) rand() % (sizeof(pattern) - 1);
+        size_t slen = (size_t) rand() % (sizeof(str) - 1);
+
+        for(size_t i = 0; i < plen; i++) {
+            pattern[i] = "ab*?"[rand() % 4];
+        }
+
+        for(size_t i = 0; i < slen; i++) {
+            str[i] = "ab"[rand() % 2];
+        }
+
+        pattern[plen] = str[slen] = '\0';
+        assert(estr_glob_compile(pattern, &glob) == CU_OK);
+        assert(estr_glob_match(glob, str) == ref_glob(pattern, str));
+        assert(estr_glob_destroy(glob) == CU_OK);
+    }
+
+    // set
+    const char* acl[] = { "net.*", "sys.reboot", "*.status", "led.[rgb]*", "sys.*" };
+    estr_glob_set_t set = NULL;
+    size_t index = 0;
+
+    assert(estr_glob_set_compile(acl, sizeof(acl) / sizeof(acl[0]), &set) == CU_OK);
+    assert(estr_glob_set_match(set, "net.ping", &index) && index == 0);
+    assert(estr_glob_set_match(set, "sys.reboot", &index) && index == 1);
+    assert(estr_glob_set_match(set, "sys.status", &index) && index == 2);
+    assert(estr_glob_set_match(set, "sys.halt", &index) && index == 4);
+    assert(estr_glob_set_match(set, "led.red", &index) && index == 3);
+    assert(!estr_glob_set_match(set, "led.white", &index));
+    assert(!estr_glob_set_match(set, "", NULL));
+    assert(!estr_glob_set_match(set, "wifi.scan", NULL));
+    assert(estr_glob_set_destroy(set) == CU_OK);
+
+    const char* bad[] = { "net.*", "[x" };
+    assert(estr_glob_set_compile(bad, 2, &set) == CU_ERR_SYNTAX_ERROR);
+    assert(estr_glob_set_compile(acl, 0, &set) == CU_ERR_INVALID_ARG);
+}
+
+static void test_estr_batch() {
+    char* argv[] = { "--port", "8080", NULL, "--port", "", "80x", "--port=1", "--portal" };
+    size_t n = sizeof(argv) / sizeof(argv[0]);
+    uint64_t bits[ESTR_BATCH_WORDS(sizeof(argv) / sizeof(argv[0]))];
+    size_t count = 0;
+
+    assert(estr_batch_eq(argv, n, estr_view_lit("--port"), bits, &count) == CU_OK);
+    assert(count == 2 && bits[0] == 0x09);
+    assert(estr_batch_bit(bits, 0) && !estr_batch_bit(bits, 2) && estr_batch_bit(bits, 3));
+    assert(estr_batch_eq(argv, n, estr_view_lit(""), bits, &count) == CU_OK && count == 1 && bits[0] == 0x10);
+    assert(estr_batch_eq(argv, n, (estr_view_t) { .ptr = "--port\0", .len = 7 }, bits, &count) == CU_OK && count == 0);
+    assert(estr_batch_eq(NULL, 0, estr_view_lit("a"), NULL, &count) == CU_OK && count == 0);
+    assert(estr_batch_eq(NULL, 1, estr_view_lit("a"), bits, NULL) == CU_ERR_INVALID_ARG);
+    assert(estr_batch_eq(argv, n, (estr_view_t) { 0 }, bits, NULL) == CU_ERR_INVALID_ARG);
+
+    estr_schema_t schema;
+    assert(estr_schema_compile(&(estr_validation_t){ .digits_only = true, .length = true, .minlen = 1, .maxlen = 5 }, &schema) == CU_OK);
+    assert(estr_batch_validate(argv, n, &schema, bits, &count) == CU_OK && count == 1 && bits[0] == 0x02);
+
+    estr_pattern_t pattern;
+    assert(estr_pattern_compile(&pattern, "port") == CU_OK);
+    assert(estr_batch_find(argv, n, &pattern, bits, &count) == CU_OK && count == 4 && bits[0] == 0xC9);
+
+    // more than one word, results agree with the one by one functions
+    estr_view_t views[150];
+    uint64_t vbits[ESTR_BATCH_WORDS(150)];
+
+    for(size_t i = 0; i < 150; i++) {
+        views[i] = i % 7 == 3 ? (estr_view_t) { 0 } : estr_view(argv[i % 8] ? argv[i % 8] : "port");
+    }
+
+    size_t expected = 0;
+    assert(estr_v_batch_eq(views, 150, estr_view_lit("8080"), vbits, &count) == CU_OK);
+
+    for(size_t i = 0; i < 150; i++) {
+        bool eq = views[i].ptr && estr_v_eq_lit(views[i], "8080");
+        assert(estr_batch_bit(vbits, i) == eq);
+        expected += eq;
+    }
+
+    assert(count == expected && (vbits[2] >> 22) == 0); // bits after the last view are zero
+
+    assert(estr_v_batch_validate(views, 150, &schema, vbits, &count) == CU_OK);
+
+    for(size_t i = 0; i < 150; i++) {
+        assert(estr_batch_bit(vbits, i) == (views[i].ptr && estr_v_validate(views[i], &schema) == CU_OK));
+    }
+
+    assert(estr_v_batch_find(views, 150, &pattern, vbits, &count) == CU_OK);
+
+    for(size_t i = 0; i < 150; i++) {
+        assert(estr_batch_bit(vbits, i) == (views[i].ptr && estr_v_find(&pattern, views[i]) != NULL));
+    }
 }
 
 int main() {
@@ -301,15 +1786,35 @@ int main() {
     test_estrn_is_digit_only();
     test_estrn_chrcnt();
     test_estr_split();
+    test_estr_split_spans();
+    test_estr_split_iter();
     test_estr_cat();
     test_estr_url_encode();
+    test_estr_url_decode();
+    test_estr_builder();
     test_estr_rep();
+    test_estr_pattern();
+    test_estr_rep_multi();
     test_estr_trim();
     test_escaping();
     test_empty();
     test_repeat();
     test_ws_contains();
     test_validation();
+    test_simd();
+    test_utf8();
+    test_view();
+    test_estr_to_num();
+    test_estr_fmt();
+    test_estr_hash();
+    test_estr_intern();
+    test_estr_owned();
+    test_estr_lit();
+    test_estr_icase();
+    test_estr_lines();
+    test_estr_codec();
+    test_estr_glob();
+    test_estr_batch();
 
     return 0;
 }
\ No newline at end of file
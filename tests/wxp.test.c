@@ -4,6 +4,28 @@
 #include "estr.h"
 #include "wxp.h"
 
+static void test_owned_words(const char* words) {
+    char** argv = NULL;
+    estr_t* sargv = NULL;
+    int argc, sargc;
+    cu_err_t err = wxp(words, &argc, &argv);
+
+    assert(wxp_s(words, &sargc, &sargv) == err);
+
+    if(err == CU_OK) {
+        assert(argc == sargc);
+
+        for(int i = 0; i < argc; i++) {
+            assert(estr_eq(argv[i], estr_s_str(&sargv[i])));
+            assert(estr_s_len(&sargv[i]) == strlen(argv[i]));
+            assert(estr_s_is_inline(&sargv[i]) == (strlen(argv[i]) <= ESTR_SSO_CAPACITY));
+        }
+
+        cu_list_free(argv, argc);
+        estr_s_list_free(sargv, sargc);
+    }
+}
+
 int main() {
     char** argv = NULL;
     int argc;
@@ -102,5 +124,14 @@ int main() {
     assert(argv && estr_eq(argv[0], "a") && estr_eq(argv[1], "\"b\""));
     cu_list_free(argv, argc);
 
+    test_owned_words("test a b c");
+    test_owned_words("\"ab\\\"c\" \"\\\\\" d");
+    test_owned_words("a\\\\\\\\b d\"e f\"g h");
+    test_owned_words("a\"b\"\" c d");
+    test_owned_words("\"\"   test a \"b c\"    \"\"   \"d\"  ");
+    test_owned_words("short \"this word is longer than the inline capacity\" x");
+    test_owned_words("\"escaped \\\"quotes\\\" in a word longer than the inline capacity\"");
+    test_owned_words("a\\\"bcdefghijklmnopqrstuvwxyz");
+
     return 0;
 }
\ No newline at end of file
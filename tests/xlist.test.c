@@ -83,8 +83,103 @@ static void test_get() {
     assert(*data == 5);
 }
 
+static int allocations = 0;
+
+static void* counting_alloc(void* ctx, size_t size) {
+    (*(int*) ctx)++;
+    return malloc(size);
+}
+
+static void counting_free(void* ctx, void* ptr) {
+    (*(int*) ctx)--;
+    free(ptr);
+}
+
+static void test_allocator() {
+    xlist_t list = NULL;
+    int num = 5;
+    assert(xlist_create(&(xlist_config_t) {
+        .allocator = &(cu_allocator_t) {
+            .alloc = &counting_alloc,
+            .free = &counting_free,
+            .ctx = &allocations
+        }
+    }, &list) == CU_OK);
+    assert(allocations == 1);
+    assert(xlist_vadd(list, &num) == 1);
+    assert(xlist_vadd(list, &num) == 2);
+    assert(allocations == 3);
+    assert(xlist_flush(list) == 2);
+    assert(allocations == 1);
+    assert(xlist_vadd(list, &num) == 1);
+    assert(xlist_destroy(list) == CU_OK);
+    assert(allocations == 0);
+}
+
+static void test_pool() {
+    xlist_t list = NULL;
+    int num = 5;
+
+    // growable
+    assert(xlist_create(&(xlist_config_t) {
+        .pool = XLIST_POOL_GROWABLE,
+        .pool_size = 2,
+        .allocator = &(cu_allocator_t) {
+            .alloc = &counting_alloc,
+            .free = &counting_free,
+            .ctx = &allocations
+        }
+    }, &list) == CU_OK);
+    assert(allocations == 1); // no slabs yet
+    assert(xlist_vadd(list, &num) == 1);
+    assert(allocations == 2); // first slab
+    assert(xlist_vadd(list, &num) == 2);
+    assert(allocations == 2);
+    assert(xlist_vadd(list, &num) == 3);
+    assert(allocations == 3); // second slab
+    assert(xlist_flush(list) == 3);
+    for(int i = 0; i < 4; i++) {
+        assert(xlist_vadd_to_front(list, &num) == i + 1); // reused nodes
+    }
+    assert(allocations == 3);
+    assert(xlist_reserve(list, 10) == CU_OK);
+    assert(allocations == 4);
+    assert(xlist_reserve(list, 10) == CU_OK); // already reserved
+    assert(allocations == 4);
+    for(int i = 0; i < 10; i++) {
+        assert(xlist_vadd(list, &num) == i + 5);
+    }
+    assert(allocations == 4);
+    assert(xlist_remove_data(list, &num) == 14);
+    assert(xlist_destroy(list) == CU_OK);
+    assert(allocations == 0);
+
+    // fixed
+    xnode_t node = NULL;
+    assert(xlist_create(&(xlist_config_t) {
+        .pool = XLIST_POOL_FIXED,
+        .pool_size = 2
+    }, &list) == CU_OK);
+    assert(xlist_vadd(list, &num) == 1);
+    assert(xlist_add(list, &num, &node) == 2);
+    assert(xlist_vadd(list, &num) == CU_ERR_NO_MEM); // exhausted
+    assert(xlist_reserve(list, 1) == CU_ERR_NO_MEM);
+    assert(xlist_remove(list, node) == CU_OK);
+    assert(xlist_reserve(list, 1) == CU_OK);
+    assert(xlist_vadd(list, &num) == 2);
+    assert(xlist_size(list) == 2);
+    assert(xlist_destroy(list) == CU_OK);
+
+    // not pooled
+    assert(xlist_create(NULL, &list) == CU_OK);
+    assert(xlist_reserve(list, 1) == CU_ERR_INVALID_ARG);
+    assert(xlist_destroy(list) == CU_OK);
+}
+
 int main() {
     test_get();
+    test_allocator();
+    test_pool();
     test_dynmem();
 
     xlist_t list = NULL;